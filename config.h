@@ -10,6 +10,7 @@
 #define CONFIG_H
 
 #include <cmath>
+#include <cstddef>
 
 /**
  * @namespace config
@@ -41,6 +42,39 @@ constexpr double SAFETY_MARGIN = 0.0;    ///< Дополнительный за
 constexpr bool ALLOW_DIAGONAL_MOVEMENT = true;  ///< Разрешить диагональное перемещение
 constexpr double DIAGONAL_COST = M_SQRT2;       ///< Стоимость диагонального перемещения
 constexpr double HEURISTIC_WEIGHT = 1.0;        ///< Вес эвристики в A*
+constexpr double FOCAL_EPSILON = 0.05;          ///< Допустимое удлинение пути в фокальном поиске
+constexpr int HPA_CLUSTER_SIZE = 10;            ///< Сторона кластера HPA* первого уровня
+constexpr int HPA_LEVELS = 2;                   ///< Количество уровней иерархии HPA*
+constexpr int HPA_LEVEL_FACTOR = 4;             ///< Во сколько раз кластер уровня больше предыдущего
+constexpr int HPA_ENTRANCE_SPLIT = 6;           ///< Длина входа, с которой ставятся два перехода
+constexpr std::size_t SEARCH_MEMORY_BUDGET = 16 * 1024 * 1024; ///< Бюджет памяти SMA* в байтах (вмещает поиск на картах 400x400)
+constexpr int BLOCK_ASTAR_SIZE = 4;             ///< Сторона блока Block A* (4 или 8)
+constexpr const char* LDDB_CACHE_PREFIX = "lddb_"; ///< Префикс файлов кэша LDDB
+constexpr unsigned VISIBILITY_BUILD_THREADS = 0; ///< Потоки построения графа видимости (0 - по числу ядер)
+constexpr int VISIBILITY_MAX_VERTICES = 12000;  ///< Предел вершин графа видимости (рост O(V^2))
+constexpr unsigned CPD_BUILD_THREADS = 0;       ///< Потоки построения базы путей (0 - по числу ядер)
+constexpr int CPD_MAX_CELLS = 12000;            ///< Предел свободных клеток базы путей (рост O(N^2))
+constexpr int ALT_LANDMARKS = 8;                ///< Количество ориентиров эвристики ALT
+constexpr unsigned ALT_BUILD_THREADS = 0;       ///< Потоки построения таблиц ALT (0 - по числу ядер)
+constexpr unsigned GOAL_BOUNDING_BUILD_THREADS = 0; ///< Потоки построения goal bounding (0 - по числу ядер)
+constexpr int GOAL_BOUNDING_MAX_CELLS = 12000;  ///< Предел свободных клеток goal bounding (рост O(N^2))
+constexpr int SWAMP_MAX_SIZE = 8;               ///< Наибольший размер болота в клетках
+constexpr int QUADTREE_MAX_LEAF_SIZE = 16;       ///< Наибольшая сторона свободного листа квадродерева
+constexpr int RSR_MIN_RECTANGLE_SIDE = 4;       ///< Наименьшая сторона прямоугольника RSR, внутренность которого пропускается
+constexpr unsigned OBSTACLE_SUMS_THREADS = 0;   ///< Потоки пересчета таблицы сумм препятствий (0 - по числу ядер)
+constexpr int OBSTACLE_SUMS_PARALLEL_CELLS = 1 << 17; ///< Размер устаревшей части таблицы, с которого пересчет параллельный
+constexpr int LOS_AVX2_MIN_WORDS = 8;          ///< Слов занятости в строке отрезка, с которых проверка идет через AVX2
+constexpr std::size_t LOS_CACHE_SLOTS = 1 << 16; ///< Ячеек в кэше прямой видимости (степень двойки)
+constexpr bool PATH_SMOOTHER_STRING_PULLING = true; ///< Натягивание сглаженного пути по коридору исходного
+constexpr int PATH_SMOOTHER_LINEAR_PROBES = 6; ///< Узлов после опорного, проверяемых подряд до экспоненциальных шагов
+constexpr int PATH_SMOOTHER_PULL_PASSES = 2;   ///< Наибольшее число проходов натягивания
+constexpr int PATH_SMOOTHER_MIN_CLEARANCE = 0; ///< Зазор до препятствий для срезаемых отрезков (0 - без требования)
+constexpr std::size_t GOAL_FIELD_CACHE_SIZE = 16; ///< Полей расстояний до целей в LRU-кэше
+constexpr unsigned GOAL_FIELD_BUILD_THREADS = 0; ///< Потоки построения поля расстояний (0 - по числу ядер)
+constexpr int GOAL_FIELD_PARALLEL_BUCKET = 2048; ///< Размер корзины, с которого она раскрывается параллельно
+constexpr int MULTI_GOAL_FIELD_THRESHOLD = 16;  ///< Число целей, с которого эвристика берется из слоя шагов
+constexpr double PIPE_ROUTER_CLEARANCE = 1.0;   ///< Радиус запретной зоны вокруг проложенной трубы в клетках
+constexpr int PIPE_ROUTER_MAX_REROUTES = 8;     ///< Наибольшее число перекладок одной трубы
 /** @} */
 
 /**
@@ -49,6 +83,12 @@ constexpr double HEURISTIC_WEIGHT = 1.0;        ///< Вес эвристики 
  */
 constexpr int NUM_TEST_RUNS = 10;        ///< Количество запусков для каждого теста
 constexpr int MAX_PATHFINDING_ITERATIONS = 100000; ///< Максимальное число итераций поиска
+constexpr int LOS_BENCHMARK_QUERIES = 200000; ///< Случайных отрезков в микробенчмарке прямой видимости
+constexpr int GOAL_FIELD_BENCHMARK_STARTS = 32; ///< Стартов к общей цели в сравнении полей с A*
+constexpr int MULTI_GOAL_BENCHMARK_GOALS = 8;  ///< Целей в сравнении поиска к любой цели с K поисками
+constexpr int STEINER_BENCHMARK_TERMINALS = 12; ///< Приборов в сравнении дерева Штейнера с отдельными путями
+constexpr int PIPE_ROUTER_BENCHMARK_PIPES = 12; ///< Труб в сравнении слоя зон с копированием сетки
+constexpr int RSR_UPDATE_BENCHMARK_QUERIES = 100; ///< Запросов в сверке RSR, обновленного зонами труб, с построенным заново
 /** @} */
 
 /**
@@ -65,6 +105,9 @@ constexpr double MIN_OBSTACLE_DISTANCE = 0.1; ///< Минимальное рас
  */
 constexpr int NARROW_CORRIDOR_WIDTH = 3; ///< Ширина узкого коридора в клетках
 constexpr int OBSTACLE_DENSITY = 30;     ///< Плотность препятствий в процентах
+constexpr int LARGE_GRID_SIZE = 400;     ///< Сторона сгенерированных больших карт
+constexpr int CAVE_FILL_PERCENT = 45;    ///< Начальное заполнение стенами для пещер в процентах
+constexpr int ROOM_SIZE = 10;            ///< Сторона комнаты вместе со стеной
 /** @} */
 
 } // namespace config
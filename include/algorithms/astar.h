@@ -11,8 +11,10 @@
 
 #include "../../config.h"
 #include "grid/grid.h"
+#include "utils/goal_set.h"
 
 #include <vector>
+#include <utility>
 #include <memory>
 #include <queue>
 #include <functional>
@@ -40,6 +42,26 @@ public:
      * @throw std::runtime_error если путь не найден
      */
     std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Найти путь до ближайшей из нескольких целей одним поиском
+     *
+     * Эвристика - оценка GoalSet до ближайшей цели, поиск останавливается
+     * на первой извлеченной цели. Подключенные эвристика, фильтр соседей и
+     * генератор преемников рассчитаны на одну цель и здесь не используются.
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param goals Цели (занятые и недостижимые пропускаются)
+     * @return Вектор узлов пути до достигнутой цели (только старт, если он сам - цель)
+     * @throw std::runtime_error если ни одна цель не достижима
+     */
+    std::vector<Node*> findPathToAny(int start_x, int start_y, const std::vector<std::pair<int, int>>& goals);
+
+    /**
+     * @brief Получить цель, достигнутую последним findPathToAny
+     * @return Индекс цели во входном списке (-1 если поиска к нескольким целям не было)
+     */
+    int getReachedGoal() const { return reached_goal_; }
     
     /**
      * @brief Получить количество раскрытых узлов в последнем поиске
@@ -58,10 +80,49 @@ public:
      */
     void resetStatistics();
 
+    /**
+     * @brief Заменить эвристику поиска
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { heuristic_ = std::move(heuristic); }
+
+    /**
+     * @brief Подключить фильтр отсечения соседей (например, goal bounding)
+     * @param filter Фильтр, сохраняющий хотя бы один оптимальный ход (пустой - без отсечения)
+     */
+    void setNeighborFilter(NeighborFilter filter) { neighbor_filter_ = std::move(filter); }
+
+    /**
+     * @brief Подключить генератор преемников (например, макроребра RSR)
+     * @param successors Генератор преемников (пустой - соседи по сетке)
+     */
+    void setSuccessorFunction(SuccessorFunction successors) { successor_function_ = std::move(successors); }
+
 private:
     Grid& grid_;                                    ///< Ссылка на рабочую сетку
     int nodes_expanded_;                            ///< Счетчик раскрытых узлов
     double path_length_;                            ///< Длина последнего найденного пути
+    int reached_goal_;                              ///< Цель последнего findPathToAny (-1 - нет)
+    HeuristicFunction heuristic_;                   ///< Подключенная эвристика (пустая - стандартная)
+    NeighborFilter neighbor_filter_;                ///< Фильтр отсечения соседей (пустой - без отсечения)
+    SuccessorFunction successor_function_;          ///< Генератор преемников (пустой - соседи по сетке)
+
+    /// Эвристическая оценка от узла до цели
+    double heuristic(const Node& from, const Node& target) const {
+        return heuristic_ ? heuristic_(from, target) : from.calculateHeuristic(target);
+    }
+    
+    /**
+     * @brief Основной цикл A* от подготовленного начального узла
+     * @param start_node Начальный узел (свободный, данные поиска сброшены)
+     * @param is_goal Проверка, является ли узел целью
+     * @param estimate Эвристика до цели
+     * @param target Единственная цель для фильтра и генератора преемников (nullptr - без них)
+     * @return Путь до первой извлеченной цели
+     * @throw std::runtime_error если путь не найден
+     */
+    template<typename GoalTest, typename Estimate>
+    std::vector<Node*> search(Node& start_node, const GoalTest& is_goal, const Estimate& estimate, Node* target);
     
     /**
      * @brief Восстановить путь от конечного узла до начального
@@ -69,6 +130,13 @@ private:
      * @return Вектор узлов пути (от начала до конца)
      */
     std::vector<Node*> reconstructPath(Node* end_node);
+
+    /**
+     * @brief Развернуть макроребра пути в последовательность соседних клеток
+     * @param path Путь, в котором соседние узлы могут быть несмежными клетками
+     * @return Путь из смежных клеток
+     */
+    std::vector<Node*> expandMacroEdges(const std::vector<Node*>& path);
     
     /**
      * @brief Вычислить длину пути
@@ -78,11 +146,24 @@ private:
     double calculatePathLength(const std::vector<Node*>& path) const;
     
     /**
-     * @brief Структура для сравнения узлов в приоритетной очереди
+     * @brief Элемент открытого списка: копия ключей узла на момент добавления
+     *
+     * Узел, до которого найден более короткий путь, добавляется заново, а
+     * прежний элемент остается в очереди устаревшим (g не совпадает с
+     * g_cost узла) и пропускается при извлечении.
      */
-    struct NodeCompare {
-        bool operator()(const Node* a, const Node* b) const {
-            return a->f_cost > b->f_cost;
+    struct OpenEntry {
+        double f;                       ///< f_cost на момент добавления
+        double g;                       ///< g_cost на момент добавления
+        Node* node;                     ///< Узел сетки
+    };
+
+    /**
+     * @brief Сравнение элементов очереди: меньшая f, при равенстве большая g
+     */
+    struct EntryCompare {
+        bool operator()(const OpenEntry& a, const OpenEntry& b) const {
+            return a.f > b.f || (a.f == b.f && a.g < b.g);
         }
     };
     
@@ -105,7 +186,7 @@ private:
     };
     
     using NodeSet = std::unordered_set<Node*, NodeHash, NodeEqual>;
-    using PriorityQueue = std::priority_queue<Node*, std::vector<Node*>, NodeCompare>;
+    using PriorityQueue = std::priority_queue<OpenEntry, std::vector<OpenEntry>, EntryCompare>;
 };
 
 #endif // ASTAR_H
\ No newline at end of file
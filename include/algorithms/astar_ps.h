@@ -11,8 +11,11 @@
 
 #include "astar.h"
 #include "utils/line_of_sight.h"
+#include "utils/line_of_sight_cache.h"
+#include "utils/path_smoother.h"
 
 #include <vector>
+#include <utility>
 
 /**
  * @class AStarPS
@@ -60,14 +63,49 @@ public:
      */
     void resetStatistics();
 
+    /**
+     * @brief Заменить эвристику базового поиска A*
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { astar_.setHeuristic(std::move(heuristic)); }
+
+    /**
+     * @brief Подключить фильтр отсечения соседей базового поиска A*
+     * @param filter Фильтр соседей (пустой - без отсечения)
+     */
+    void setNeighborFilter(NeighborFilter filter) { astar_.setNeighborFilter(std::move(filter)); }
+
+    /**
+     * @brief Подключить генератор преемников базового поиска A*
+     * @param successors Генератор преемников (пустой - соседи по сетке)
+     */
+    void setSuccessorFunction(SuccessorFunction successors) { astar_.setSuccessorFunction(std::move(successors)); }
+
+    /**
+     * @brief Подключить кэш прямой видимости для сглаживания
+     * @param cache Кэш, разделяемый с другими алгоритмами (nullptr - без кэша); не принадлежит алгоритму
+     */
+    void setLineOfSightCache(LineOfSightCache* cache) { smoother_.setLineOfSightCache(cache); }
+
+    /**
+     * @brief Получить конвейер сглаживания для настройки
+     *
+     * По умолчанию включено жадное срезание без натягивания, как до
+     * появления PathSmoother; экспоненциальный режим и натягивание дают
+     * немного другие (обычно более короткие) пути.
+     * @return Сглаживатель алгоритма
+     */
+    PathSmoother& getSmoother() { return smoother_; }
+
 private:
-    Grid& grid_;                                    ///< Ссылка на сетку для проверки видимости
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
     AStar astar_;                                   ///< Базовый алгоритм A*
     double original_path_length_;                   ///< Длина пути до сглаживания
     double smoothed_path_length_;                   ///< Длина пути после сглаживания
+    PathSmoother smoother_;                         ///< Конвейер сглаживания
     
     /**
-     * @brief Сгладить путь методом "натягивания веревки"
+     * @brief Сгладить путь методом "натягивания веревки" (через PathSmoother)
      * @param original_path Исходный путь, найденный A*
      * @return Вектор узлов сглаженного пути
      */
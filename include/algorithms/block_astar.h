@@ -0,0 +1,118 @@
+/**
+ * @file block_astar.h
+ * @brief Реализация алгоритма Block A*
+ *
+ * Block A* раскрывает не отдельные клетки, а целые блоки B x B: стоимости
+ * клеток периметра блока обновляются за один шаг по базе локальных
+ * расстояний (LDDB), индексируемой битовым шаблоном препятствий блока
+ */
+
+#ifndef BLOCK_ASTAR_H
+#define BLOCK_ASTAR_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+#include "utils/local_distance_database.h"
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class BlockAStar
+ * @brief Block A* с общей базой локальных расстояний
+ *
+ * Путь строится по клеткам периметра блоков, а участки внутри блоков
+ * восстанавливаются локальным поиском только для выбранного пути.
+ * Результат - оптимальный 8-связный путь, который можно передать
+ * в сглаживание для получения any-angle траектории.
+ */
+class BlockAStar {
+public:
+    /**
+     * @brief Конструктор алгоритма Block A*
+     * @param grid Ссылка на сетку для поиска
+     * @param block_size Сторона блока (4 или 8)
+     */
+    explicit BlockAStar(Grid& grid, int block_size = config::BLOCK_ASTAR_SIZE);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых блоков в последнем поиске
+     * @return Количество раскрытых блоков
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить используемую базу локальных расстояний
+     * @return Разделяемый указатель на LDDB
+     */
+    std::shared_ptr<LocalDistanceDatabase> getDatabase() const { return lddb_; }
+
+    /**
+     * @brief Заменить эвристику поиска
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { heuristic_ = std::move(heuristic); }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    HeuristicFunction heuristic_;                   ///< Подключенная эвристика (пустая - стандартная)
+    int block_size_;                                ///< Сторона блока
+    std::shared_ptr<LocalDistanceDatabase> lddb_;   ///< Общая база расстояний
+    int nodes_expanded_;                            ///< Счетчик раскрытых блоков
+    double path_length_;                            ///< Длина последнего найденного пути
+
+    int blocks_x_;                                  ///< Количество блоков по X
+    int blocks_y_;                                  ///< Количество блоков по Y
+    std::uint32_t search_id_;                       ///< Номер текущего поиска
+
+    std::vector<std::uint32_t> cell_stamp_;         ///< Номер поиска для клетки
+    std::vector<double> g_;                         ///< Стоимость пути до клетки
+    std::vector<int> parent_;                       ///< Предыдущая опорная клетка
+
+    std::vector<std::uint32_t> block_stamp_;        ///< Номер поиска для блока
+    std::vector<std::uint64_t> pattern_;            ///< Шаблон препятствий блока
+    std::vector<double> heap_value_;                ///< Ключ блока в открытом списке
+    std::vector<std::vector<int>> ingress_;         ///< Обновленные клетки входа блока
+
+    /// Подготовить массивы состояния к новому поиску
+    void prepareState();
+
+    /// Инициализировать блок при первом обращении в текущем поиске
+    void touchBlock(int block);
+
+    /// Стоимость клетки в текущем поиске
+    double cost(int cell) const;
+
+    /// Расстояния от клетки до всех клеток ее блока (движение внутри блока)
+    std::vector<double> localDistances(int block, int x, int y) const;
+
+    /// Путь между двумя клетками одного блока (без первой клетки)
+    void localPath(int block, int sx, int sy, int tx, int ty,
+                   std::vector<std::pair<int, int>>& cells) const;
+};
+
+#endif // BLOCK_ASTAR_H
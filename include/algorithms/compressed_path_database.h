@@ -0,0 +1,154 @@
+/**
+ * @file compressed_path_database.h
+ * @brief Сжатая база путей (таблицы первых ходов) для статических карт
+ *
+ * Для каждой исходной клетки хранится оптимальный первый ход ко всем
+ * целевым клеткам. Цели упорядочены обходом в глубину, поэтому соседние
+ * по порядку клетки обычно имеют одинаковый первый ход, и строка таблицы
+ * хорошо сжимается кодированием длин серий. Запрос не выполняет поиска:
+ * путь восстанавливается последовательными первыми ходами.
+ */
+
+#ifndef COMPRESSED_PATH_DATABASE_H
+#define COMPRESSED_PATH_DATABASE_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class CompressedPathDatabase
+ * @brief Поиск пути по предвычисленным таблицам первых ходов
+ *
+ * База строится в несколько потоков (по одному поиску Дейкстры на каждую
+ * свободную клетку), сохраняется в файл и затем отображается в память
+ * (mmap), так что повторные запуски на той же карте обходятся без
+ * построения. Файл содержит хеш карты и отклоняется при ее изменении.
+ * Запрос сверяет версию карты с той, для которой база построена или
+ * открыта, и перестраивает базу, если карта изменилась.
+ */
+class CompressedPathDatabase {
+public:
+    /**
+     * @brief Конструктор базы путей
+     * @param grid Ссылка на сетку для поиска
+     * @param threads Количество потоков построения (0 - по числу ядер)
+     */
+    explicit CompressedPathDatabase(Grid& grid, unsigned threads = config::CPD_BUILD_THREADS);
+
+    ~CompressedPathDatabase();
+
+    CompressedPathDatabase(const CompressedPathDatabase&) = delete;
+    CompressedPathDatabase& operator=(const CompressedPathDatabase&) = delete;
+
+    /**
+     * @brief Построить базу в памяти
+     * @throw std::runtime_error если свободных клеток больше CPD_MAX_CELLS
+     */
+    void build();
+
+    /**
+     * @brief Сохранить базу в двоичный файл
+     * @param filename Имя файла
+     * @return true при успехе
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Отобразить базу из файла в память
+     * @param filename Имя файла
+     * @return true если файл существует и построен для этой карты
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Открыть базу из файла, а при его отсутствии построить и сохранить
+     * @param filename Имя файла кэша
+     * @throw std::runtime_error если карта слишком велика для построения
+     */
+    void buildOrOpen(const std::string& filename);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден или таблица ведет в
+     *        отсеченную или зарезервированную клетку
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество обращений к таблицам в последнем поиске
+     * @return Количество шагов восстановления пути
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить время последнего построения
+     * @return Время в миллисекундах (0 если база открыта из файла)
+     */
+    double getBuildTime() const { return build_time_; }
+
+    /**
+     * @brief Получить размер базы
+     * @return Размер в байтах
+     */
+    std::size_t getSizeBytes() const { return word_count_ * sizeof(std::uint32_t); }
+
+    /**
+     * @brief Получить общее количество серий
+     * @return Количество серий во всех строках
+     */
+    std::size_t getRunCount() const;
+
+    /**
+     * @brief Отображена ли база из файла
+     * @return true если данные читаются через mmap
+     */
+    bool isMapped() const { return mapped_ != nullptr; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    unsigned threads_;                              ///< Количество потоков построения
+    int nodes_expanded_;                            ///< Счетчик шагов
+    double path_length_;                            ///< Длина последнего найденного пути
+    double build_time_;                             ///< Время последнего построения (мс)
+
+    std::vector<std::uint32_t> buffer_;             ///< Данные базы, построенной в памяти
+    void* mapped_;                                  ///< Отображенный файл (nullptr если нет)
+    std::size_t mapped_bytes_;                      ///< Размер отображения
+    const std::uint32_t* data_;                     ///< Начало данных (buffer_ или mapped_)
+    std::size_t word_count_;                        ///< Размер данных в словах
+    std::uint64_t grid_version_;                    ///< Версия карты, для которой база построена или открыта
+
+    std::vector<int> rank_;                         ///< Клетка -> позиция в порядке обхода (-1 для препятствий)
+
+    /// Освободить отображение файла
+    void unmap();
+
+    /// Проверить заголовок данных и заполнить rank_
+    bool attach(const std::uint32_t* data, std::size_t words);
+
+    /// Первый ход из клетки с позицией source к клетке с позицией target
+    int firstMove(int source, int target) const;
+};
+
+#endif // COMPRESSED_PATH_DATABASE_H
@@ -0,0 +1,161 @@
+/**
+ * @file focal_search.h
+ * @brief Реализация фокального поиска (A*ε) с вторичной эвристикой
+ *
+ * Ограниченно-субоптимальный вариант A*: из открытого списка выбираются
+ * узлы с f <= (1 + ε) * f_min, а среди них раскрывается лучший по
+ * вторичному ключу (число поворотов, расстояние до цели, зазор до препятствий)
+ */
+
+#ifndef FOCAL_SEARCH_H
+#define FOCAL_SEARCH_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <set>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @enum FocalKey
+ * @brief Вторичный ключ упорядочивания списка FOCAL
+ */
+enum class FocalKey {
+    GoalDistance,                       ///< Меньшее расстояние до цели
+    FewestTurns,                        ///< Меньшее число поворотов на пути
+    Clearance                           ///< Больший зазор до препятствий
+};
+
+/**
+ * @class FocalSearch
+ * @brief Фокальный поиск с доказуемой границей субоптимальности
+ *
+ * Закрытые узлы сразу не переоткрываются: если путь к закрытому узлу
+ * улучшился, узел получает новую стоимость и родителя и попадает в список
+ * INCONS (как в ARA*). Нижняя оценка оптимума - наименьшее f по OPEN и
+ * INCONS, и FOCAL ограничен (1 + ε) этой оценкой, поэтому выбранная цель
+ * не длиннее (1 + ε) оптимума. Когда FOCAL пустеет из-за INCONS, узлы
+ * списка возвращаются в OPEN, и проход исправления раскрывает узлы по f
+ * с немедленным переоткрытием, пока минимум OPEN не превысит (1 + ε)
+ * прежнего фронта.
+ */
+class FocalSearch {
+public:
+    /**
+     * @brief Конструктор фокального поиска
+     * @param grid Ссылка на сетку для поиска
+     * @param key Вторичный ключ для списка FOCAL
+     * @param epsilon Допустимое относительное удлинение пути по умолчанию
+     */
+    explicit FocalSearch(Grid& grid, FocalKey key = FocalKey::GoalDistance,
+                         double epsilon = config::FOCAL_EPSILON);
+
+    /**
+     * @brief Найти путь с ε по умолчанию
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Найти путь с заданным для этого запроса ε
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @param epsilon Допустимое относительное удлинение пути (>= 0)
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::invalid_argument если epsilon < 0
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y, double epsilon);
+
+    /**
+     * @brief Получить количество раскрытых узлов в последнем поиске
+     * @return Количество раскрытых узлов
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить доказанную границу субоптимальности последнего пути
+     * @return Отношение длины пути к нижней оценке оптимума (0 если путь не найден)
+     */
+    double getSuboptimalityBound() const { return suboptimality_bound_; }
+
+    /**
+     * @brief Получить нижнюю оценку длины оптимального пути
+     * @return Минимальное f по OPEN и INCONS в момент завершения
+     */
+    double getLowerBound() const { return lower_bound_; }
+
+    /**
+     * @brief Установить вторичный ключ
+     * @param key Новый ключ
+     */
+    void setFocalKey(FocalKey key) { key_ = key; }
+
+    /**
+     * @brief Заменить эвристику поиска
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { heuristic_ = std::move(heuristic); }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    HeuristicFunction heuristic_;                   ///< Подключенная эвристика (пустая - стандартная)
+    FocalKey key_;                                  ///< Вторичный ключ
+    double default_epsilon_;                        ///< ε по умолчанию
+    int nodes_expanded_;                            ///< Счетчик раскрытых узлов
+    double path_length_;                            ///< Длина последнего найденного пути
+    double suboptimality_bound_;                    ///< Доказанная граница субоптимальности
+    double lower_bound_;                            ///< Нижняя оценка оптимума
+
+    std::uint32_t search_id_;                       ///< Номер текущего поиска
+    std::vector<std::uint32_t> stamp_;              ///< Номер поиска, в котором клетка посещена
+    std::vector<double> g_;                         ///< Стоимость пути от старта
+    std::vector<double> f_;                         ///< Оценка f
+    std::vector<double> secondary_;                 ///< Значение вторичного ключа
+    std::vector<int> parent_;                       ///< Индекс родительской клетки
+    std::vector<int> turns_;                        ///< Число поворотов на пути
+    std::vector<char> closed_;                      ///< Флаг закрытого узла
+    std::vector<int> clearance_;                    ///< Зазор до препятствий в клетках
+
+    using OpenEntry = std::pair<double, int>;                   ///< (f, индекс)
+    using FocalEntry = std::pair<std::pair<double, double>, int>; ///< ((ключ, f), индекс)
+
+    /**
+     * @brief Подготовить массивы состояния к новому поиску
+     */
+    void prepareState();
+
+    /**
+     * @brief Рассчитать зазор до препятствий для всех клеток
+     */
+    void computeClearance();
+
+    /**
+     * @brief Восстановить путь по массиву родителей
+     * @param end_index Индекс конечной клетки
+     * @return Вектор узлов пути (от начала до конца)
+     */
+    std::vector<Node*> reconstructPath(int end_index);
+};
+
+#endif // FOCAL_SEARCH_H
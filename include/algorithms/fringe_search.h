@@ -0,0 +1,119 @@
+/**
+ * @file fringe_search.h
+ * @brief Реализация алгоритма Fringe Search для поиска пути
+ *
+ * Fringe Search заменяет приоритетную очередь A* двусвязным списком
+ * "сейчас/потом" и итеративно увеличиваемым порогом f, как в IDA*,
+ * но без повторного раскрытия всего дерева на каждой итерации
+ */
+
+#ifndef FRINGE_SEARCH_H
+#define FRINGE_SEARCH_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class FringeSearch
+ * @brief Реализация алгоритма Fringe Search с плоским состоянием по клеткам
+ *
+ * Все данные поиска (g, родитель, звенья списка) хранятся в массивах,
+ * индексируемых номером клетки y * width + x. Массивы не очищаются между
+ * запросами: актуальность записи определяется номером поиска.
+ */
+class FringeSearch {
+public:
+    /**
+     * @brief Конструктор алгоритма Fringe Search
+     * @param grid Ссылка на сетку для поиска
+     */
+    explicit FringeSearch(Grid& grid);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых узлов в последнем поиске
+     * @return Количество раскрытых узлов
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить количество итераций порога f в последнем поиске
+     * @return Количество итераций
+     */
+    int getIterations() const { return iterations_; }
+
+    /**
+     * @brief Заменить эвристику поиска
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { heuristic_ = std::move(heuristic); }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    HeuristicFunction heuristic_;                   ///< Подключенная эвристика (пустая - стандартная)
+    int nodes_expanded_;                            ///< Счетчик раскрытых узлов
+    double path_length_;                            ///< Длина последнего найденного пути
+    int iterations_;                                ///< Число итераций порога
+
+    std::uint32_t search_id_;                       ///< Номер текущего поиска
+    std::vector<std::uint32_t> stamp_;              ///< Номер поиска, в котором клетка посещена
+    std::vector<double> g_;                         ///< Стоимость пути от старта
+    std::vector<double> h_;                         ///< Кэш эвристики до цели
+    std::vector<int> parent_;                       ///< Индекс родительской клетки
+    std::vector<int> prev_;                         ///< Предыдущий элемент списка fringe
+    std::vector<int> next_;                         ///< Следующий элемент списка fringe
+    std::vector<char> in_list_;                     ///< Флаг нахождения в списке fringe
+
+    /**
+     * @brief Подготовить массивы состояния к новому поиску
+     */
+    void prepareState();
+
+    /**
+     * @brief Вставить клетку в список после указанной
+     * @param after Клетка, после которой выполняется вставка
+     * @param index Вставляемая клетка
+     */
+    void insertAfter(int after, int index);
+
+    /**
+     * @brief Удалить клетку из списка
+     * @param index Удаляемая клетка
+     * @param head Голова списка (обновляется при удалении первого элемента)
+     */
+    void unlink(int index, int& head);
+
+    /**
+     * @brief Восстановить путь по массиву родителей
+     * @param end_index Индекс конечной клетки
+     * @return Вектор узлов пути (от начала до конца)
+     */
+    std::vector<Node*> reconstructPath(int end_index);
+};
+
+#endif // FRINGE_SEARCH_H
@@ -0,0 +1,146 @@
+/**
+ * @file goal_field_search.h
+ * @brief Поиск пути спуском по полю расстояний до цели
+ *
+ * Для цели один раз считается обратный поиск Дейкстры по всей карте:
+ * расстояние от каждой клетки до цели и лучший первый ход из нее. Любой
+ * запрос к той же цели затем отвечается спуском по полю за O(длина пути)
+ * без поиска. Это выгодно, когда много стартов ведут к одной цели
+ * (например, подключение приборов к одному стояку).
+ */
+
+#ifndef GOAL_FIELD_SEARCH_H
+#define GOAL_FIELD_SEARCH_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class GoalFieldSearch
+ * @brief Поля расстояний до целей с LRU-кэшем и спуском по ним
+ *
+ * Поле строится обратным поиском Дейкстры с очередью из корзин шириной в
+ * наименьшую стоимость хода: клетки одной корзины не могут улучшить друг
+ * друга, поэтому большие корзины раскрываются в несколько потоков.
+ * Стоимости считаются в фиксированной точке, поэтому лучший ход из клетки
+ * выбирается точно. Кэш хранит последние поля для текущих версий карты и
+ * отсечения (Grid::getVersion, Grid::getPruningVersion) и очищается при
+ * смене любой из них.
+ */
+class GoalFieldSearch {
+public:
+    /**
+     * @brief Поле расстояний до одной цели
+     */
+    struct GoalField {
+        int goal_x;                         ///< Координата X цели
+        int goal_y;                         ///< Координата Y цели
+        std::uint64_t version;              ///< Версия карты, для которой построено поле
+        std::uint64_t pruning_version;      ///< Версия отсечения, для которой построено поле
+        std::vector<float> distance;        ///< Расстояние до цели по клеткам (бесконечность - недостижима)
+        std::vector<std::uint8_t> next_move; ///< Лучший ход из клетки (индекс направления, 8 - нет хода)
+        double build_time;                  ///< Время построения (мс)
+    };
+
+    /**
+     * @brief Конструктор поиска по полям
+     * @param grid Ссылка на сетку для поиска
+     * @param cache_capacity Наибольшее число полей в кэше (не меньше 1)
+     * @param threads Количество потоков построения поля (0 - по числу ядер)
+     * @throw std::invalid_argument если cache_capacity равно 0
+     */
+    explicit GoalFieldSearch(Grid& grid, std::size_t cache_capacity = config::GOAL_FIELD_CACHE_SIZE,
+                             unsigned threads = config::GOAL_FIELD_BUILD_THREADS);
+
+    /**
+     * @brief Получить поле цели из кэша или построить его
+     * @param goal_x Координата X цели
+     * @param goal_y Координата Y цели
+     * @return Поле расстояний до цели
+     * @throw std::runtime_error если цель вне карты или занята
+     */
+    std::shared_ptr<const GoalField> getField(int goal_x, int goal_y);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество шагов спуска в последнем поиске
+     * @return Количество раскрытых узлов
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+    /**
+     * @brief Очистить кэш полей
+     */
+    void clear();
+
+    /// Время последнего построения поля (мс)
+    double getBuildTime() const { return build_time_; }
+
+    /// Количество построенных полей за время жизни объекта
+    int getFieldBuilds() const { return field_builds_; }
+
+    /// Количество запросов поля, отвеченных кэшем, за время жизни объекта
+    int getCacheHits() const { return cache_hits_; }
+
+    /// Количество полей в кэше
+    std::size_t getCachedFields() const { return lru_.size(); }
+
+    /// Память полей в кэше и масок ходов в байтах
+    std::size_t getMemoryBytes() const;
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    std::size_t cache_capacity_;                    ///< Наибольшее число полей в кэше
+    unsigned threads_;                              ///< Количество потоков построения
+    int nodes_expanded_;                            ///< Счетчик шагов спуска
+    double path_length_;                            ///< Длина последнего найденного пути
+    double build_time_;                             ///< Время последнего построения поля (мс)
+    int field_builds_;                              ///< Счетчик построенных полей
+    int cache_hits_;                                ///< Счетчик попаданий в кэш
+
+    std::list<std::shared_ptr<const GoalField>> lru_; ///< Поля от недавно использованного к давнему
+    std::unordered_map<int, std::list<std::shared_ptr<const GoalField>>::iterator> index_; ///< Клетка цели -> поле
+    std::uint64_t cache_version_;                   ///< Версия карты полей в кэше
+    std::uint64_t cache_pruning_version_;           ///< Версия отсечения полей в кэше
+
+    std::vector<std::uint8_t> moves_;               ///< Разрешенные ходы из клетки (бит на направление)
+    std::vector<std::uint8_t> entries_;             ///< Направления ходов, ведущих в клетку (обратные ребра)
+    std::uint64_t moves_version_;                   ///< Версия карты масок ходов (0 - не построены)
+    std::uint64_t moves_pruning_version_;           ///< Версия отсечения масок ходов
+
+    /// Пересчитать маски ходов, если карта изменилась
+    void updateMoves();
+
+    /// Построить поле цели обратным поиском Дейкстры
+    std::shared_ptr<const GoalField> buildField(int goal_x, int goal_y);
+};
+
+#endif // GOAL_FIELD_SEARCH_H
@@ -0,0 +1,202 @@
+/**
+ * @file hpa_star.h
+ * @brief Иерархический поиск пути HPA* поверх сетки
+ *
+ * Сетка разбивается на кластеры, на общих границах соседних кластеров
+ * выбираются входы, а расстояния между входами одного кластера
+ * кэшируются как ребра абстрактного графа. Запрос решается на
+ * абстрактном графе, после чего уточняются только выбранные сегменты.
+ * Поддерживается несколько уровней иерархии: кластер уровня l состоит
+ * из HPA_LEVEL_FACTOR x HPA_LEVEL_FACTOR кластеров уровня l-1.
+ */
+
+#ifndef HPA_STAR_H
+#define HPA_STAR_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @class HPAStar
+ * @brief Иерархический A* с локальной перестройкой кластеров
+ *
+ * Абстрактный граф строится один раз (build()) и затем используется
+ * для всех запросов. После изменения препятствий на сетке нужно вызвать
+ * updateRegion() для измененной области: перестраиваются только
+ * затронутые кластеры и их родители на верхних уровнях.
+ */
+class HPAStar {
+public:
+    /**
+     * @brief Конструктор иерархического поиска
+     * @param grid Ссылка на сетку для поиска
+     * @param cluster_size Сторона кластера первого уровня в клетках
+     * @param levels Количество уровней абстракции (>= 1)
+     * @throw std::invalid_argument при некорректных параметрах
+     */
+    explicit HPAStar(Grid& grid, int cluster_size = config::HPA_CLUSTER_SIZE,
+                     int levels = config::HPA_LEVELS);
+
+    /**
+     * @brief Построить абстрактный граф для всей сетки
+     */
+    void build();
+
+    /**
+     * @brief Перестроить кластеры, затронутые изменением клеток в прямоугольнике
+     * @param x0 Левая граница области
+     * @param y0 Верхняя граница области
+     * @param x1 Правая граница области (включительно)
+     * @param y1 Нижняя граница области (включительно)
+     */
+    void updateRegion(int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых узлов в последнем поиске
+     * @return Раскрытия на абстрактном графе и при уточнении сегментов
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить количество узлов абстрактного графа
+     * @return Количество живых абстрактных узлов
+     */
+    int getAbstractNodeCount() const;
+
+    /**
+     * @brief Получить время последнего построения или перестройки
+     * @return Время в миллисекундах
+     */
+    double getBuildTime() const { return build_time_; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    /**
+     * @brief Ребро абстрактного графа
+     */
+    struct AbstractEdge {
+        int to;                         ///< Узел-приемник
+        double cost;                    ///< Стоимость перехода
+        int level;                      ///< Уровень ребра
+        bool inter;                     ///< true - переход через границу кластеров
+    };
+
+    /**
+     * @brief Узел абстрактного графа (вход кластера)
+     */
+    struct AbstractNode {
+        int x;                          ///< Координата X клетки
+        int y;                          ///< Координата Y клетки
+        int level;                      ///< Максимальный уровень, на котором узел участвует
+        bool alive;                     ///< Узел существует
+        bool temporary;                 ///< Временный узел старта или цели
+        std::vector<int> border_levels; ///< Уровни границ, на которых лежит узел
+        std::vector<AbstractEdge> edges;///< Инцидентные ребра
+    };
+
+    /**
+     * @brief Прямоугольник кластера (границы включительно)
+     */
+    struct Rect {
+        int x0, y0, x1, y1;
+
+        bool contains(int x, int y) const {
+            return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+        }
+    };
+
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    int cluster_size_;                              ///< Сторона кластера первого уровня
+    int levels_;                                    ///< Количество уровней
+    bool built_;                                    ///< Граф построен
+    int nodes_expanded_;                            ///< Счетчик раскрытых узлов
+    double path_length_;                            ///< Длина последнего найденного пути
+    double build_time_;                             ///< Время последнего построения (мс)
+
+    std::vector<AbstractNode> nodes_;               ///< Абстрактные узлы
+    std::vector<int> free_nodes_;                   ///< Освобожденные индексы узлов
+    std::unordered_map<int, int> node_at_cell_;     ///< Клетка -> постоянный узел
+    std::unordered_map<long long, std::vector<std::pair<int, int>>> border_transitions_; ///< Граница -> пары узлов
+
+    /// Сторона кластера уровня level
+    int clusterSize(int level) const;
+
+    /// Прямоугольник кластера уровня level, содержащего клетку
+    Rect clusterRect(int x, int y, int level) const;
+
+    /// Уровень границы, проходящей по координате coord
+    int borderLevel(int coord) const;
+
+    /// Наибольший уровень границы, которую пересекает ход между соседними клетками
+    int transitionLevel(int x0, int y0, int x1, int y1) const;
+
+    /// Ключ границы первого уровня: vertical - граница x = cx * size
+    long long borderKey(int cx, int cy, bool vertical) const;
+
+    int createNode(int x, int y, int level, bool temporary);
+    int acquireBorderNode(int x, int y, int border_level);
+    void releaseBorderNode(int id, int border_level);
+    void deleteNode(int id);
+    void addEdge(int a, int b, double cost, int level, bool inter);
+    void removeEdge(int a, int b, int level, bool inter);
+
+    /// Построить входы на границе первого уровня
+    void buildBorder(int cx, int cy, bool vertical);
+
+    /// Удалить входы границы первого уровня
+    void clearBorder(int cx, int cy, bool vertical);
+
+    /// Собрать постоянные узлы уровня >= level на периметре кластера
+    std::vector<int> perimeterNodes(const Rect& rect, int level) const;
+
+    /// Пересчитать внутренние ребра кластера уровня level
+    void buildIntraEdges(const Rect& rect, int level);
+
+    /// Подключить временный узел ко всем уровням
+    void connectTemporary(int id, const std::vector<int>& other_temporary);
+
+    /// Дейкстра по клеткам внутри прямоугольника (расстояния до всех клеток)
+    std::vector<double> gridDistances(const Rect& rect, int sx, int sy);
+
+    /// A* по клеткам внутри прямоугольника
+    bool gridPath(const Rect& rect, int sx, int sy, int tx, int ty,
+                  std::vector<std::pair<int, int>>& cells);
+
+    /// Проходимо ли ребро на уровне поиска level
+    bool edgeUsable(const AbstractEdge& edge, int level) const;
+
+    /// Дейкстра/A* по абстрактному графу уровня level в пределах прямоугольника
+    std::unordered_map<int, double> abstractSearch(int source, int target, int level,
+                                                   const Rect* rect,
+                                                   std::vector<int>* path);
+
+    /// Уточнить абстрактное ребро до последовательности клеток
+    void refineEdge(int a, int b, int level, std::vector<std::pair<int, int>>& cells);
+};
+
+#endif // HPA_STAR_H
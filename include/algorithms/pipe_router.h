@@ -0,0 +1,207 @@
+/**
+ * @file pipe_router.h
+ * @brief Последовательная трассировка нескольких труб без пересечений
+ *
+ * Трубы прокладываются по очереди, и каждая проложенная труба вместе с
+ * запретной зоной становится препятствием для следующих. Зоны ставятся
+ * резервом клеток (слой ObstacleInflator) прямо в исходной сетке, без ее
+ * копирования, повторной инфляции и изменения препятствий карты. Если
+ * трубу проложить нельзя, трубы с меньшим приоритетом вырываются (rip-up)
+ * и встают в очередь заново (reroute); труба, которой мешают только карта
+ * и трубы не ниже ее приоритета, помечается как заблокированная.
+ */
+
+#ifndef PIPE_ROUTER_H
+#define PIPE_ROUTER_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+#include "grid/obstacle_inflator.h"
+#include "algorithms/astar.h"
+#include "utils/bit_wavefront.h"
+
+#include <vector>
+#include <deque>
+#include <cstdint>
+
+/**
+ * @struct PipeRequest
+ * @brief Труба, которую нужно проложить
+ */
+struct PipeRequest {
+    int start_x;                                    ///< Координата X начала
+    int start_y;                                    ///< Координата Y начала
+    int end_x;                                      ///< Координата X конца
+    int end_y;                                      ///< Координата Y конца
+    int priority;                                   ///< Приоритет (труба вырывает только трубы с меньшим)
+};
+
+/**
+ * @enum PipeStatus
+ * @brief Состояние трубы после трассировки
+ */
+enum class PipeStatus {
+    Routed,                                         ///< Труба проложена
+    Deadlocked                                      ///< Пути нет даже без труб меньшего приоритета или исчерпан лимит перекладок
+};
+
+/**
+ * @struct PipeRoute
+ * @brief Результат трассировки одной трубы
+ */
+struct PipeRoute {
+    std::vector<Node*> path;                        ///< Путь трубы (пустой, если не проложена)
+    PipeStatus status = PipeStatus::Deadlocked;     ///< Состояние трубы
+    double length = 0.0;                            ///< Длина пути
+    int attempts = 0;                               ///< Число поисков пути для трубы
+    int reroutes = 0;                               ///< Сколько раз труба была вырвана и переложена
+    double time_ms = 0.0;                           ///< Суммарное время поисков для трубы (мс)
+};
+
+/**
+ * @class PipeRouter
+ * @brief Пакетная трассировка труб с вырыванием и перекладкой по приоритету
+ *
+ * Все поиски идут одним экземпляром A* по одной и той же сетке, а
+ * запретные зоны ставятся и снимаются слоем с подсчетом штампов, так что
+ * вырывание трубы меняет резерв только клеток ее зоны. Концы труб
+ * освобождены от зон: их положение задано, и чужая зона не должна
+ * закрывать сам конец. Если чужая труба проходит рядом с концом или
+ * через него, трубе не выйти из конца, и это обычный конфликт: более
+ * приоритетная труба вырывает мешающую. После route() зоны проложенных
+ * труб остаются в сетке; clear() и деструктор снимают резерв, исключение
+ * в route() тоже.
+ *
+ * A* проверяет связность по компонентам карты без резерва, поэтому
+ * трубу, отрезанную зонами, он искал бы по всей компоненте. Перед каждым
+ * поиском связность проверяется битовой волной по строкам занятости,
+ * объединенным с закрытыми клетками; слушатель слоя обновляет их по
+ * каждой смене резерва.
+ */
+class PipeRouter {
+public:
+    /**
+     * @brief Конструктор трассировщика
+     * @param grid Сетка (уже раздутая под радиус трубы)
+     * @param clearance Радиус запретной зоны вокруг клеток проложенной трубы
+     * @param max_reroutes Наибольшее число перекладок одной трубы
+     * @throw std::invalid_argument если радиус зоны отрицательный
+     */
+    PipeRouter(Grid& grid, double clearance = config::PIPE_ROUTER_CLEARANCE,
+               int max_reroutes = config::PIPE_ROUTER_MAX_REROUTES);
+
+    PipeRouter(const PipeRouter&) = delete;
+    PipeRouter& operator=(const PipeRouter&) = delete;
+
+    /**
+     * @brief Проложить набор труб в порядке передачи
+     *
+     * Труба, оставшаяся заблокированной, встает в очередь снова, когда
+     * вырывание освобождает место на карте.
+     * @param pipes Трубы; прежде проложенные трубы предварительно снимаются
+     * @return Результаты по трубам (в порядке передачи)
+     */
+    const std::vector<PipeRoute>& route(const std::vector<PipeRequest>& pipes);
+
+    /**
+     * @brief Снять зоны всех труб и освобождения концов и забыть результаты
+     */
+    void clear();
+
+    /**
+     * @brief Подключить генератор преемников к поиску труб (например, RSR той же сетки)
+     * @param successors Генератор преемников
+     */
+    void setSuccessorFunction(SuccessorFunction successors) { astar_.setSuccessorFunction(std::move(successors)); }
+
+    /**
+     * @brief Задать слушателя смены резерва клеток зонами труб
+     * @param listener Слушатель; должен жить дольше трассировщика
+     */
+    void setCellListener(CellListener listener) { listener_ = std::move(listener); }
+
+    /// Результаты последней трассировки (в порядке передачи)
+    const std::vector<PipeRoute>& getRoutes() const { return routes_; }
+
+    /// Количество проложенных труб
+    int getRoutedCount() const;
+
+    /// Количество заблокированных труб
+    int getDeadlockCount() const;
+
+    /// Количество вырываний труб за последнюю трассировку
+    int getRipUps() const { return rip_ups_; }
+
+    /**
+     * @brief Получить количество раскрытых узлов за последнюю трассировку
+     * @return Количество раскрытых узлов
+     */
+    long long getNodesExpanded() const { return nodes_expanded_; }
+
+    /// Количество поисков, отброшенных проверкой связности с учетом зон
+    int getUnreachableSkips() const { return unreachable_skips_; }
+
+    /// Полное время последней трассировки (мс)
+    double getTotalTime() const { return total_time_; }
+
+    /// Слой запретных зон проложенных труб
+    const ObstacleInflator& getOverlay() const { return overlay_; }
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    // Строки и слушатель объявлены до слоя: деструктор слоя снимает зоны через них
+    std::vector<std::uint64_t> closed_rows_;        ///< Строки занятости вместе с отсеченными и зарезервированными клетками
+    CellListener listener_;                         ///< Внешний слушатель смены резерва (может быть пустым)
+    ObstacleInflator overlay_;                      ///< Запретные зоны проложенных труб
+    BitWavefront reachability_;                     ///< Волна по closed_rows_ для проверки связности
+    AStar astar_;                                   ///< Поиск, общий для всех труб
+    int max_reroutes_;                              ///< Лимит перекладок одной трубы
+
+    std::vector<PipeRequest> pipes_;                ///< Трубы последней трассировки
+    std::vector<PipeRoute> routes_;                 ///< Результаты по трубам
+    std::vector<std::uint8_t> footprint_;           ///< Отметки зоны новой трубы при поиске конфликтов
+    std::vector<std::uint8_t> queued_;              ///< Труба стоит в очереди
+    int rip_ups_;                                   ///< Счетчик вырываний
+    int unreachable_skips_;                         ///< Счетчик поисков, отброшенных проверкой связности
+    long long nodes_expanded_;                      ///< Счетчик раскрытых узлов
+    double total_time_;                             ///< Полное время трассировки (мс)
+
+    /**
+     * @brief Пересобрать строки closed_rows_ по текущей сетке
+     */
+    void refreshClosedRows();
+
+    /**
+     * @brief Обновить бит клетки в closed_rows_ и сообщить внешнему слушателю
+     * @param x Координата X клетки, резерв которой сменился
+     * @param y Координата Y клетки
+     */
+    void onCellChanged(int x, int y);
+
+    /**
+     * @brief Найти путь трубы на текущей сетке
+     * @param index Индекс трубы
+     * @return Путь (пустой, если его нет)
+     */
+    std::vector<Node*> search(int index);
+
+    /**
+     * @brief Проложить трубы из очереди (тело route())
+     * @param queue Очередь индексов труб
+     */
+    void routeQueue(std::deque<int>& queue);
+
+    /**
+     * @brief Трубы меньшего приоритета, с зонами которых пересекается путь
+     *
+     * Пара клеток ближе радиуса зоны конфликтует, если хотя бы одна из них
+     * не освобождена: зона освобожденного конца его не закрывает, но
+     * закрывает соседние клетки другой трубы.
+     * @param path Путь новой трубы
+     * @param candidates Трубы меньшего приоритета (непроложенные не конфликтуют)
+     * @return Индексы конфликтующих труб
+     */
+    std::vector<int> findConflicts(const std::vector<Node*>& path, const std::vector<int>& candidates);
+};
+
+#endif // PIPE_ROUTER_H
@@ -0,0 +1,149 @@
+/**
+ * @file quadtree_search.h
+ * @brief Поиск пути по листьям квадродерева свободного пространства
+ *
+ * Карта представляется регионным квадродеревом: однородные (целиком
+ * свободные или целиком занятые) квадраты не делятся дальше. A* идет по
+ * свободным листьям, соединенным по общим сторонам и углам, а найденная
+ * цепочка листьев уточняется до пути по клеткам: внутри квадрата любой
+ * октильный маршрут свободен, поэтому достаточно выбрать точки перехода
+ * через общие границы.
+ */
+
+#ifndef QUADTREE_SEARCH_H
+#define QUADTREE_SEARCH_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+/**
+ * @class QuadtreeSearch
+ * @brief A* по свободным листьям квадродерева с уточнением до клеток
+ *
+ * Дерево и списки смежности листьев строятся один раз (build(), либо
+ * лениво при первом запросе). Стоимость ребра между листьями - расстояние
+ * между их центрами (для листа старта и цели - между самими клетками),
+ * поэтому путь не обязательно кратчайший; точки перехода через границы
+ * выбираются так, чтобы сократить итоговый путь по клеткам.
+ */
+class QuadtreeSearch {
+public:
+    /**
+     * @brief Конструктор поиска по квадродереву
+     * @param grid Ссылка на сетку для поиска
+     * @param max_leaf_size Наибольшая сторона свободного листа (степень двойки)
+     * @throw std::invalid_argument если max_leaf_size не степень двойки
+     */
+    explicit QuadtreeSearch(Grid& grid, int max_leaf_size = config::QUADTREE_MAX_LEAF_SIZE);
+
+    /**
+     * @brief Построить квадродерево и смежность листьев по текущей сетке
+     */
+    void build();
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых листьев в последнем поиске
+     * @return Количество раскрытых узлов
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+    /// Количество свободных листьев
+    int getLeafCount() const { return static_cast<int>(leaves_.size()); }
+
+    /// Память дерева, листьев и смежности в байтах
+    std::size_t getMemoryBytes() const;
+
+    /// Время последнего построения (мс)
+    double getBuildTime() const { return build_time_; }
+
+private:
+    /**
+     * @brief Узел дерева: либо четыре дочерних узла подряд, либо лист
+     */
+    struct TreeNode {
+        int first_child;                ///< Индекс первого из 4 потомков (-1 для листа)
+        int leaf;                       ///< Свободный лист (-1 для занятого листа или внутреннего узла)
+    };
+
+    /**
+     * @brief Свободный квадрат
+     */
+    struct Leaf {
+        int x;                          ///< Левая граница
+        int y;                          ///< Верхняя граница
+        int size;                       ///< Сторона квадрата
+    };
+
+    /**
+     * @brief Результат поиска листа по клетке
+     */
+    struct Location {
+        int leaf;                       ///< Свободный лист (-1 если клетка занята или вне карты)
+        int x;                          ///< Левая граница найденного листа дерева
+        int y;                          ///< Верхняя граница найденного листа дерева
+        int size;                       ///< Сторона найденного листа дерева
+    };
+
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    int max_leaf_size_;                             ///< Наибольшая сторона свободного листа
+    bool built_;                                    ///< Дерево построено
+    int nodes_expanded_;                            ///< Счетчик раскрытых листьев
+    double path_length_;                            ///< Длина последнего найденного пути
+    double build_time_;                             ///< Время последнего построения (мс)
+
+    int root_size_;                                 ///< Сторона корневого квадрата (степень двойки)
+    std::vector<TreeNode> tree_;                    ///< Узлы дерева, корень - tree_[0]
+    std::vector<Leaf> leaves_;                      ///< Свободные листья
+    std::vector<int> adjacency_offset_;             ///< Начало списка соседей листа в adjacency_
+    std::vector<int> adjacency_;                    ///< Соседние свободные листья подряд
+
+    /// Построить поддерево квадрата (однородность проверяется Grid::countObstacles)
+    void buildNode(int node, int x, int y, int size);
+
+    /// Найти лист дерева, содержащий клетку
+    Location locate(int x, int y) const;
+
+    /// Центр листа (для листа старта или цели - соответствующая клетка)
+    std::pair<double, double> anchor(int leaf, int start_leaf, int start_x, int start_y,
+                                     int end_leaf, int end_x, int end_y) const;
+
+    /**
+     * @brief Уточнить цепочку листьев до последовательности клеток
+     * @param leaves Цепочка листьев от старта до цели
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Клетки пути
+     */
+    std::vector<std::pair<int, int>> refine(const std::vector<int>& leaves, int start_x, int start_y,
+                                            int end_x, int end_y) const;
+};
+
+#endif // QUADTREE_SEARCH_H
@@ -0,0 +1,203 @@
+/**
+ * @file sma_star.h
+ * @brief Реализация алгоритма SMA* (A* с ограниченной памятью)
+ *
+ * Вариант A*, который работает в заданном бюджете памяти: при его
+ * исчерпании из памяти удаляется худший лист, а его оценка f
+ * переносится в родителя, чтобы поддерево можно было восстановить позже
+ */
+
+#ifndef SMA_STAR_H
+#define SMA_STAR_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <utility>
+#include <set>
+#include <unordered_map>
+#include <cstddef>
+
+/**
+ * @class SMAStar
+ * @brief Поиск пути с явным бюджетом памяти в байтах
+ *
+ * Пока бюджета хватает, поведение совпадает с A*. Когда память
+ * заканчивается, поиск не прерывается, а "забывает" листья с наибольшим f
+ * и при необходимости раскрывает их родителей повторно. Если повторные
+ * раскрытия не дают продвинуться, поиск перезапускается с увеличенным весом
+ * эвристики, и оптимальность ослабляется до известной границы.
+ */
+class SMAStar {
+public:
+    /**
+     * @brief Конструктор алгоритма SMA*
+     * @param grid Ссылка на сетку для поиска
+     * @param memory_budget_bytes Бюджет памяти на узлы поиска в байтах
+     * @throw std::invalid_argument если бюджет меньше двух узлов
+     */
+    explicit SMAStar(Grid& grid, std::size_t memory_budget_bytes = config::SEARCH_MEMORY_BUDGET);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден или не помещается в бюджет
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых узлов в последнем поиске
+     * @return Количество раскрытых узлов (с учетом повторных раскрытий)
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить пиковый объем памяти, занятой узлами поиска
+     * @return Объем памяти в байтах
+     */
+    std::size_t getPeakMemoryUsed() const { return peak_nodes_ * kBytesPerNode; }
+
+    /**
+     * @brief Получить гарантированную границу субоптимальности пути
+     * @return 1.0 для оптимального пути, иначе вес эвристики последней попытки
+     */
+    double getSuboptimalityBound() const { return suboptimality_bound_; }
+
+    /**
+     * @brief Получить количество узлов, удаленных из памяти
+     * @return Количество "забытых" узлов (по всем попыткам)
+     */
+    int getNodesForgotten() const { return nodes_forgotten_; }
+
+    /**
+     * @brief Получить бюджет памяти
+     * @return Бюджет в байтах
+     */
+    std::size_t getMemoryBudget() const { return memory_budget_; }
+
+    /**
+     * @brief Заменить эвристику поиска
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { heuristic_ = std::move(heuristic); }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    /**
+     * @brief Запись об узле, находящемся в памяти
+     */
+    struct Record {
+        double g;                       ///< Стоимость пути от старта
+        double h;                       ///< Эвристика до цели
+        double f;                       ///< Оценка f (с учетом перенесенных значений)
+        double forgotten_f;             ///< Минимальное f забытых потомков
+        int parent;                     ///< Индекс родительской клетки
+        int depth;                      ///< Глубина в дереве поиска
+        int children;                   ///< Число потомков в памяти
+        bool in_open;                   ///< Находится ли узел в открытом списке
+    };
+
+    /**
+     * @brief Ключ открытого списка: меньший f, затем больший depth
+     */
+    struct OpenKey {
+        double f;
+        int depth;
+        int index;
+
+        bool operator<(const OpenKey& other) const {
+            if (f != other.f) return f < other.f;
+            if (depth != other.depth) return depth > other.depth;
+            return index < other.index;
+        }
+    };
+
+    /**
+     * @brief Результат одной попытки поиска
+     */
+    enum class SearchOutcome {
+        Found,                          ///< Путь найден
+        NotFound,                       ///< Цель недостижима
+        MemoryExhausted                 ///< Попытка не уложилась в бюджет
+    };
+
+    /// Оценка памяти на один узел: запись, элемент хэш-таблицы и открытого списка
+    static constexpr std::size_t kBytesPerNode = sizeof(Record) + 64;
+
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    HeuristicFunction heuristic_;                   ///< Подключенная эвристика (пустая - стандартная)
+    std::size_t memory_budget_;                     ///< Бюджет памяти в байтах
+    std::size_t max_nodes_;                         ///< Максимальное число узлов в памяти
+    int nodes_expanded_;                            ///< Счетчик раскрытых узлов
+    int nodes_forgotten_;                           ///< Счетчик забытых узлов
+    std::size_t peak_nodes_;                        ///< Пиковое число узлов в памяти
+    double path_length_;                            ///< Длина последнего найденного пути
+    double suboptimality_bound_;                    ///< Граница субоптимальности пути
+    int expanding_index_;                           ///< Раскрываемый узел (не удаляется)
+
+    std::unordered_map<int, Record> records_;       ///< Узлы в памяти
+    std::set<OpenKey> open_;                        ///< Открытый список
+
+    /**
+     * @brief Выполнить одну попытку поиска с заданным весом эвристики
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @param weight Вес эвристики
+     * @param path Найденный путь (выходной параметр)
+     * @return Результат попытки: NotFound, если фронт исчерпан и ни одна
+     *         запись не была отброшена из-за бюджета (цель отрезана, например,
+     *         отсеченными или зарезервированными клетками)
+     */
+    SearchOutcome search(int start_x, int start_y, int end_x, int end_y,
+                         double weight, std::vector<Node*>& path);
+
+    /**
+     * @brief Добавить узел в открытый список
+     */
+    void pushOpen(int index, Record& record);
+
+    /**
+     * @brief Удалить узел из открытого списка
+     */
+    void eraseOpen(int index, Record& record);
+
+    /**
+     * @brief Удалить из памяти худший лист, кроме указанного узла
+     * @param protected_index Узел, который нельзя удалять
+     * @return true если лист удален
+     */
+    bool forgetWorstLeaf(int protected_index);
+
+    /**
+     * @brief Уменьшить счетчик потомков и вернуть родителя в открытый список
+     * @param parent_index Индекс родителя
+     * @param child_f Оценка f удаляемого потомка
+     */
+    void detachChild(int parent_index, double child_f);
+
+    /**
+     * @brief Восстановить путь по цепочке родителей
+     * @param end_index Индекс конечной клетки
+     * @return Вектор узлов пути (от начала до конца)
+     */
+    std::vector<Node*> reconstructPath(int end_index);
+};
+
+#endif // SMA_STAR_H
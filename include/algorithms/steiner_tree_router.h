@@ -0,0 +1,124 @@
+/**
+ * @file steiner_tree_router.h
+ * @brief Трассировка сети из нескольких выводов (дерево Штейнера)
+ *
+ * Магистраль подключается к N приборам деревом наименьшей (приближенно)
+ * суммарной длины. Используется эвристика Такахаши - Мацуямы: дерево
+ * растет от корня, и на каждом шаге присоединяется ближайший к дереву
+ * неподключенный вывод по кратчайшему пути до любой клетки дерева.
+ * Результат не длиннее 2(1 - 1/N) от оптимума.
+ */
+
+#ifndef STEINER_TREE_ROUTER_H
+#define STEINER_TREE_ROUTER_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+#include "utils/fixed_point_search.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class SteinerTreeRouter
+ * @brief Дерево Такахаши - Мацуямы на одном продолжаемом поиске Дейкстры
+ *
+ * Расстояния до дерева не пересчитываются заново после каждого вывода:
+ * клетки присоединенного пути становятся источниками с нулевым
+ * расстоянием и добавляются в ту же очередь, а поиск продолжается с
+ * ленивым удалением устаревших записей. Расстояния при росте дерева
+ * только уменьшаются, поэтому заново раскрывается лишь область, которую
+ * новый путь приблизил. Дерево выдается отрезками между развилками и
+ * выводами: общий участок нескольких ветвей - один отрезок.
+ */
+class SteinerTreeRouter {
+public:
+    /**
+     * @brief Конструктор трассировщика
+     * @param grid Ссылка на сетку
+     * @throw std::invalid_argument если на сетке больше 2^24 клеток
+     */
+    explicit SteinerTreeRouter(Grid& grid);
+
+    /**
+     * @brief Построить дерево от корня ко всем выводам
+     * @param terminals Выводы; первый - корень (магистраль)
+     * @throw std::runtime_error если вывод занят, вне карты или недостижим
+     */
+    void route(const std::vector<std::pair<int, int>>& terminals);
+
+    /**
+     * @brief Начать новое дерево из одного корня
+     * @param root_x Координата X корня
+     * @param root_y Координата Y корня
+     * @throw std::runtime_error если корень занят или вне карты
+     */
+    void reset(int root_x, int root_y);
+
+    /**
+     * @brief Присоединить выводы к текущему дереву, продолжая прежний поиск
+     * @param terminals Новые выводы (уже лежащие на дереве подключаются без пути)
+     * @throw std::runtime_error если дерево не начато, карта изменилась или вывод недостижим
+     */
+    void addTerminals(const std::vector<std::pair<int, int>>& terminals);
+
+    /// Отрезки дерева: цепочки соседних клеток между развилками и выводами
+    const std::vector<std::vector<Node*>>& getSegments() const { return segments_; }
+
+    /// Выводы в порядке присоединения (индексы в порядке передачи, корень - 0)
+    const std::vector<int>& getConnectionOrder() const { return connection_order_; }
+
+    /// Суммарная длина дерева (каждый отрезок учитывается один раз)
+    double getTotalLength() const { return total_length_; }
+
+    /// Количество клеток дерева
+    int getTreeCells() const { return static_cast<int>(tree_cells_.size()); }
+
+    /**
+     * @brief Получить количество раскрытых узлов с начала дерева
+     * @return Количество раскрытых узлов
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /// Время построения с начала дерева (мс)
+    double getRouteTime() const { return route_time_; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    std::uint64_t version_;                         ///< Версия карты, на которой начато дерево (0 - не начато)
+    std::uint64_t pruning_version_;                 ///< Версия отсечения, на которой начато дерево
+    int nodes_expanded_;                            ///< Счетчик раскрытых узлов
+    double total_length_;                           ///< Суммарная длина дерева
+    double route_time_;                             ///< Время построения (мс)
+
+    std::vector<std::uint64_t> dist_;               ///< Расстояние до дерева в фиксированной точке
+    std::vector<int> parent_;                       ///< Предыдущая клетка кратчайшего пути от дерева
+    std::vector<std::uint8_t> settled_;             ///< Расстояние окончательно и распространено
+    std::vector<int> terminal_;                     ///< Неподключенный вывод клетки (-1 - нет)
+    fixed_point::Queue queue_;                      ///< Очередь продолжаемого поиска
+
+    std::vector<int> tree_cells_;                   ///< Клетки дерева
+    std::vector<std::pair<int, int>> tree_edges_;   ///< Ребра дерева (пары соседних клеток)
+    std::vector<std::uint8_t> junction_;            ///< Клетка - вывод (конец отрезка при любой степени)
+    std::vector<int> pending_;                      ///< Клетки неподключенных выводов
+    int terminal_count_;                            ///< Выводов передано с начала дерева
+    std::vector<int> connection_order_;             ///< Порядок присоединения выводов
+    std::vector<std::vector<Node*>> segments_;      ///< Отрезки дерева
+
+    /// Добавить клетку в дерево как источник с нулевым расстоянием
+    void addTreeCell(int cell);
+
+    /// Присоединить ближайший неподключенный вывод
+    void connectNearest();
+
+    /// Разбить дерево на отрезки между развилками и выводами
+    void buildSegments();
+};
+
+#endif // STEINER_TREE_ROUTER_H
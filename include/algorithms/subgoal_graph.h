@@ -0,0 +1,180 @@
+/**
+ * @file subgoal_graph.h
+ * @brief Простые графы подцелей (Simple Subgoal Graphs, SUB)
+ *
+ * Подцели ставятся у выпуклых углов препятствий, а две подцели
+ * соединяются ребром, если одна напрямую h-достижима из другой:
+ * между ними есть путь длины октильного расстояния, не проходящий
+ * через другие подцели. Кратчайший путь на сетке поворачивает только
+ * в подцелях, поэтому поиск по такому графу дает оптимальный путь.
+ */
+
+#ifndef SUBGOAL_GRAPH_H
+#define SUBGOAL_GRAPH_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class SubgoalGraph
+ * @brief Поиск пути по графу подцелей с локальной перестройкой
+ *
+ * Граф строится один раз (build()) или загружается с диска (load()).
+ * Запрос подключает старт и цель к графу, ищет путь A* по подцелям
+ * и уточняет каждое ребро до 8-связного пути на сетке. После изменения
+ * препятствий нужно вызвать updateRegion() для измененной области.
+ */
+class SubgoalGraph {
+public:
+    /**
+     * @brief Конструктор графа подцелей
+     * @param grid Ссылка на сетку для поиска
+     */
+    explicit SubgoalGraph(Grid& grid);
+
+    /**
+     * @brief Построить граф подцелей для всей сетки
+     */
+    void build();
+
+    /**
+     * @brief Перестроить граф после изменения клеток в прямоугольнике
+     *
+     * Пересчитываются подцели вокруг области и ребра тех подцелей,
+     * чей просмотренный при построении участок пересекает область.
+     * @param x0 Левая граница области
+     * @param y0 Верхняя граница области
+     * @param x1 Правая граница области (включительно)
+     * @param y1 Нижняя граница области (включительно)
+     */
+    void updateRegion(int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Сохранить граф в двоичный файл
+     * @param filename Имя файла
+     * @return true при успехе
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Загрузить граф из двоичного файла
+     *
+     * Файл должен быть сохранен для той же карты: проверяются размеры
+     * сетки, хеш карты (fixed_point::mapHash) и проходимость всех подцелей.
+     * @param filename Имя файла
+     * @return true если файл существует и совместим с сеткой
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов, представляющий найденный путь
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых подцелей в последнем поиске
+     * @return Количество раскрытых узлов графа
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить количество подцелей
+     * @return Количество живых подцелей
+     */
+    int getSubgoalCount() const;
+
+    /**
+     * @brief Получить количество ребер графа
+     * @return Количество неориентированных ребер
+     */
+    int getEdgeCount() const;
+
+    /**
+     * @brief Получить время последнего построения или перестройки
+     * @return Время в миллисекундах
+     */
+    double getBuildTime() const { return build_time_; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    /**
+     * @brief Подцель и ее ребра
+     */
+    struct Subgoal {
+        int x;                          ///< Координата X клетки
+        int y;                          ///< Координата Y клетки
+        bool alive;                     ///< Подцель существует
+        int min_x, min_y;               ///< Просмотренный при поиске ребер участок
+        int max_x, max_y;
+        std::vector<int> edges;         ///< Напрямую h-достижимые подцели
+    };
+
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    bool built_;                                    ///< Граф построен
+    int nodes_expanded_;                            ///< Счетчик раскрытых узлов
+    double path_length_;                            ///< Длина последнего найденного пути
+    double build_time_;                             ///< Время последнего построения (мс)
+
+    std::vector<Subgoal> subgoals_;                 ///< Подцели
+    std::vector<int> free_subgoals_;                ///< Освобожденные индексы подцелей
+    std::vector<int> subgoal_at_;                   ///< Клетка -> подцель (-1 если нет)
+
+    std::uint32_t search_id_;                       ///< Номер текущего поиска
+    std::vector<std::uint32_t> stamp_;              ///< Номер поиска для подцели
+    std::vector<double> g_;                         ///< Стоимость пути до подцели
+    std::vector<int> parent_;                       ///< Предыдущая подцель
+    std::vector<double> goal_edge_;                 ///< Стоимость ребра подцель -> цель
+    std::vector<std::uint32_t> goal_stamp_;         ///< Номер поиска для goal_edge_
+
+    /// Является ли клетка выпуклым углом препятствия
+    bool isSubgoalCell(int x, int y) const;
+
+    /// Октильное расстояние между клетками
+    static double octile(int x0, int y0, int x1, int y1);
+
+    int createSubgoal(int x, int y);
+    void clearEdges(int id);
+
+    /**
+     * @brief Найти подцели, напрямую h-достижимые из клетки
+     * @param x Координата X клетки
+     * @param y Координата Y клетки
+     * @param target Дополнительная клетка-цель (-1 если нет)
+     * @param target_reached Устанавливается в true, если цель h-достижима
+     * @param owner Подцель, для которой запоминается просмотренный участок (-1 если нет)
+     * @return Индексы найденных подцелей без повторов
+     */
+    std::vector<int> directReachable(int x, int y, int target, bool* target_reached, int owner);
+
+    /// Пересчитать ребра подцели и обновить ребра соседей
+    void connectSubgoal(int id, const std::vector<char>& rebuilt);
+
+    /// Уточнить h-достижимый отрезок до клеток (без первой клетки)
+    void refineSegment(int sx, int sy, int tx, int ty, std::vector<std::pair<int, int>>& cells) const;
+
+    /// Подготовить массивы поиска к новому запросу
+    void prepareSearch();
+};
+
+#endif // SUBGOAL_GRAPH_H
@@ -11,10 +11,13 @@
 #define THETASTAR_H
 
 #include "grid/grid.h"
+#include "../utils/goal_set.h"
 #include "../utils/line_of_sight.h"
+#include "../utils/line_of_sight_cache.h"
 #include "../../config.h"
 
 #include <vector>
+#include <utility>
 #include <memory>
 #include <queue>
 #include <functional>
@@ -42,6 +45,26 @@ public:
      * @throw std::runtime_error если путь не найден
      */
     std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Найти any-angle путь до ближайшей из нескольких целей одним поиском
+     *
+     * Эвристика - GoalSet::estimateAnyAngle до ближайшей цели, поиск
+     * останавливается на первой извлеченной цели. Подключенная эвристика
+     * рассчитана на одну цель и здесь не используется.
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param goals Цели (занятые и недостижимые пропускаются)
+     * @return Вектор узлов пути до достигнутой цели (только старт, если он сам - цель)
+     * @throw std::runtime_error если ни одна цель не достижима
+     */
+    std::vector<Node*> findPathToAny(int start_x, int start_y, const std::vector<std::pair<int, int>>& goals);
+
+    /**
+     * @brief Получить цель, достигнутую последним findPathToAny
+     * @return Индекс цели во входном списке (-1 если поиска к нескольким целям не было)
+     */
+    int getReachedGoal() const { return reached_goal_; }
     
     /**
      * @brief Получить количество раскрытых узлов в последнем поиске
@@ -60,10 +83,48 @@ public:
      */
     void resetStatistics();
 
+    /**
+     * @brief Заменить эвристику поиска
+     * @param heuristic Допустимая эвристика (пустая - евклидово расстояние)
+     */
+    void setHeuristic(HeuristicFunction heuristic) { heuristic_ = std::move(heuristic); }
+
+    /**
+     * @brief Подключить кэш прямой видимости
+     * @param cache Кэш, разделяемый с другими алгоритмами (nullptr - без кэша); не принадлежит алгоритму
+     */
+    void setLineOfSightCache(LineOfSightCache* cache) { los_cache_ = cache; }
+
 private:
     Grid& grid_;                                    ///< Ссылка на рабочую сетку
     int nodes_expanded_;                            ///< Счетчик раскрытых узлов
     double path_length_;                            ///< Длина последнего найденного пути
+    int reached_goal_;                              ///< Цель последнего findPathToAny (-1 - нет)
+    HeuristicFunction heuristic_;                   ///< Подключенная эвристика (пустая - стандартная)
+    LineOfSightCache* los_cache_;                   ///< Подключенный кэш видимости (nullptr - без кэша)
+
+    /// Эвристическая оценка от узла до цели
+    double heuristic(const Node& from, const Node& target) const {
+        return heuristic_ ? heuristic_(from, target) : from.calculateHeuristic(target);
+    }
+
+    /// Проверка прямой видимости (через кэш, если он подключен)
+    bool hasLineOfSight(const Node& from, const Node& to) const {
+        return los_cache_ ? los_cache_->hasLineOfSight(grid_, from, to)
+                          : line_of_sight::hasLineOfSight(grid_, from, to);
+    }
+    
+    /**
+     * @brief Основной цикл Theta* от подготовленного начального узла
+     * @param start_node Начальный узел (свободный, данные поиска сброшены)
+     * @param is_goal Проверка, является ли узел целью
+     * @param estimate Эвристика до цели
+     * @param target Единственная цель (nullptr при поиске к нескольким целям)
+     * @return Путь до первой извлеченной цели
+     * @throw std::runtime_error если путь не найден
+     */
+    template<typename GoalTest, typename Estimate>
+    std::vector<Node*> search(Node& start_node, const GoalTest& is_goal, const Estimate& estimate, Node* target);
     
     /**
      * @brief Восстановить путь от конечного узла до начального
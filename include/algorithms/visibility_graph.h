@@ -0,0 +1,135 @@
+/**
+ * @file visibility_graph.h
+ * @brief Граф видимости по углам препятствий для any-angle запросов
+ *
+ * Вершины графа - свободные клетки у выпуклых углов препятствий и у концов
+ * стен, ребра - пары вершин с прямой видимостью (line_of_sight::isPathClear).
+ * Хранятся только касательные ребра: ребро, уходящее от угла в сторону,
+ * противоположную препятствию, не может входить в натянутый путь.
+ */
+
+#ifndef VISIBILITY_GRAPH_H
+#define VISIBILITY_GRAPH_H
+
+#include "../../config.h"
+#include "grid/grid.h"
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * @class VisibilityGraph
+ * @brief Поиск any-angle пути по графу видимости
+ *
+ * Граф строится один раз для статической карты (build(), в несколько
+ * потоков). Запрос временно подключает старт и цель ко всем видимым
+ * вершинам и выполняет A* с евклидовой эвристикой, поэтому проверки
+ * видимости во время поиска не нужны.
+ */
+class VisibilityGraph {
+public:
+    /**
+     * @brief Конструктор графа видимости
+     * @param grid Ссылка на сетку для поиска
+     * @param threads Количество потоков построения (0 - по числу ядер)
+     */
+    explicit VisibilityGraph(Grid& grid, unsigned threads = config::VISIBILITY_BUILD_THREADS);
+
+    /**
+     * @brief Построить граф видимости для всей сетки
+     * @throw std::runtime_error если вершин больше VISIBILITY_MAX_VERTICES
+     */
+    void build();
+
+    /**
+     * @brief Найти путь от начальной до конечной точки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @return Вектор узлов-вершин any-angle пути
+     * @throw std::runtime_error если путь не найден
+     */
+    std::vector<Node*> findPath(int start_x, int start_y, int end_x, int end_y);
+
+    /**
+     * @brief Получить количество раскрытых вершин в последнем поиске
+     * @return Количество раскрытых вершин
+     */
+    int getNodesExpanded() const { return nodes_expanded_; }
+
+    /**
+     * @brief Получить длину найденного пути в последнем поиске
+     * @return Длина пути
+     */
+    double getPathLength() const { return path_length_; }
+
+    /**
+     * @brief Получить количество вершин графа
+     * @return Количество вершин
+     */
+    int getVertexCount() const { return static_cast<int>(vertices_.size()); }
+
+    /**
+     * @brief Получить количество ребер графа
+     * @return Количество ориентированных ребер
+     */
+    int getEdgeCount() const { return edge_count_; }
+
+    /**
+     * @brief Получить время последнего построения
+     * @return Время в миллисекундах
+     */
+    double getBuildTime() const { return build_time_; }
+
+    /**
+     * @brief Сбросить статистику алгоритма
+     */
+    void resetStatistics();
+
+private:
+    /**
+     * @brief Ребро графа видимости
+     */
+    struct Edge {
+        int to;                         ///< Вершина-приемник
+        double cost;                    ///< Евклидова длина
+    };
+
+    /**
+     * @brief Вершина графа (клетка у угла препятствия)
+     */
+    struct Vertex {
+        int x;                          ///< Координата X клетки
+        int y;                          ///< Координата Y клетки
+        std::uint8_t corners;           ///< Битовая маска квадрантов с препятствием
+        std::vector<Edge> edges;        ///< Исходящие касательные ребра
+    };
+
+    Grid& grid_;                                    ///< Ссылка на рабочую сетку
+    unsigned threads_;                              ///< Количество потоков построения
+    bool built_;                                    ///< Граф построен
+    int nodes_expanded_;                            ///< Счетчик раскрытых вершин
+    double path_length_;                            ///< Длина последнего найденного пути
+    double build_time_;                             ///< Время последнего построения (мс)
+    int edge_count_;                                ///< Количество ребер
+
+    std::vector<Vertex> vertices_;                  ///< Вершины графа
+
+    std::uint32_t search_id_;                       ///< Номер текущего поиска
+    std::vector<std::uint32_t> stamp_;              ///< Номер поиска для вершины
+    std::vector<double> g_;                         ///< Стоимость пути до вершины
+    std::vector<int> parent_;                       ///< Предыдущая вершина
+    std::vector<double> goal_edge_;                 ///< Длина ребра вершина -> цель (бесконечность если нет)
+
+    /// Маска квадрантов (qx, qy), для которых клетка - выпуклый угол препятствия, и флаг конца стены
+    std::uint8_t cornerMask(int x, int y) const;
+
+    /// Может ли ребро из вершины в направлении (dx, dy) быть частью натянутого пути
+    bool isTangent(const Vertex& vertex, int dx, int dy) const;
+
+    /// Прямая видимость из (x0, y0) в (x1, y1); соседние клетки - по ходу сетки
+    bool isVisible(int x0, int y0, int x1, int y1) const;
+};
+
+#endif // VISIBILITY_GRAPH_H
@@ -15,6 +15,7 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <cstdint>
 
 /**
  * @class Grid
@@ -22,6 +23,8 @@
  */
 class Grid {
 public:
+    static constexpr int kMaxFreeRun = 0xFFFF;      ///< Предел хранимой длины свободного отрезка
+    
     /**
      * @brief Конструктор сетки
      * @param width Ширина сетки
@@ -111,16 +114,259 @@ public:
      * @return Вектор указателей на соседние узлы
      */
     std::vector<Node*> getNeighbors(const Node& node);
+    
+    /**
+     * @brief Проверить допустимость хода из клетки в соседнюю
+     * 
+     * Те же правила, что и в getNeighbors(), но без создания вектора:
+     * используется алгоритмами с плоским состоянием по клеткам.
+     * В отсеченную (Node::pruned) и зарезервированную (Node::reserved)
+     * клетку войти нельзя.
+     * @param x Координата X исходной клетки
+     * @param y Координата Y исходной клетки
+     * @param dx Смещение по X (-1, 0, 1)
+     * @param dy Смещение по Y (-1, 0, 1)
+     * @return true если ход допустим
+     */
+    bool canMove(int x, int y, int dx, int dy) const;
+    
+    /**
+     * @brief Получить метку компоненты связности клетки
+     * 
+     * Метки поддерживаются системой непересекающихся множеств (union-find):
+     * удаление препятствия объединяет компоненты на месте, установка
+     * препятствия, которая может разрезать компоненту, откладывает полный
+     * пересчет до следующего запроса. Прямое изменение Node::walkable через
+     * getNode() не отслеживается.
+     * @param x Координата X
+     * @param y Координата Y
+     * @return Метка компоненты (-1 для препятствий и координат вне сетки)
+     */
+    int getComponent(int x, int y) const;
+    
+    /**
+     * @brief Проверить, соединены ли две клетки каким-либо путем
+     * @param start_x Координата X первой клетки
+     * @param start_y Координата Y первой клетки
+     * @param end_x Координата X второй клетки
+     * @param end_y Координата Y второй клетки
+     * @return true если обе клетки свободны и лежат в одной компоненте
+     */
+    bool isReachable(int start_x, int start_y, int end_x, int end_y) const;
+    
+    /**
+     * @brief Отметить клетку как отсеченную для текущего запроса
+     * 
+     * Отсеченная клетка не является препятствием (isObstacle() и прямая
+     * видимость ее не учитывают), но getNeighbors() и canMove() не ведут в нее,
+     * а isBlocked() считает ее закрытой. Предобработка (HPA*, граф подцелей,
+     * RSR) видит отсечение на момент построения; отрезки графа видимости
+     * проверяются прямой видимостью и отсечение не учитывают.
+     * @param x Координата X
+     * @param y Координата Y
+     * @param pruned true - отсечь, false - вернуть
+     */
+    void setPruned(int x, int y, bool pruned);
+    
+    /**
+     * @brief Проверить, отсечена ли клетка
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если клетка отсечена
+     */
+    bool isPruned(int x, int y) const;
+    
+    /**
+     * @brief Проверить, закрыта ли клетка для входа
+     * 
+     * Препятствие, отсеченная или зарезервированная клетка или координаты
+     * вне сетки: тот же
+     * критерий входа, что и в canMove(). Используется предобработкой,
+     * которая размечает проходимые клетки без ходов (границы кластеров,
+     * подцели, прямоугольники, шаблоны блоков).
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если в клетку войти нельзя
+     */
+    bool isBlocked(int x, int y) const;
+    
+    /**
+     * @brief Снять отсечение со всех клеток
+     */
+    void clearPruned();
+    
+    /**
+     * @brief Зарезервировать клетку временным слоем
+     * 
+     * Слой временных препятствий (ObstacleInflator) поверх карты: как и
+     * отсеченная, зарезервированная клетка не является препятствием для
+     * isObstacle(), прямой видимости, компонент связности и таблиц сумм и
+     * отрезков, но getNeighbors() и canMove() не ведут в нее. Версия карты
+     * не меняется, поэтому резерв не сбрасывает кэши, построенные по
+     * занятости; меняется версия отсечения.
+     * @param x Координата X
+     * @param y Координата Y
+     * @param reserved true - зарезервировать, false - освободить
+     */
+    void setReserved(int x, int y, bool reserved);
+    
+    /**
+     * @brief Проверить, зарезервирована ли клетка
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если клетка зарезервирована
+     */
+    bool isReserved(int x, int y) const;
+    
+    /**
+     * @brief Подсчитать препятствия в прямоугольнике за O(1)
+     * 
+     * Используется таблица префиксных сумм (integral image) по слою
+     * препятствий. После изменений таблица пересчитывается лениво при
+     * следующем запросе и только начиная с самой левой верхней измененной
+     * клетки. Клетки вне сетки считаются препятствиями, как в isObstacle().
+     * @param x0 Левая граница (включительно)
+     * @param y0 Верхняя граница (включительно)
+     * @param x1 Правая граница (включительно)
+     * @param y1 Нижняя граница (включительно)
+     * @return Количество занятых клеток
+     */
+    int countObstacles(int x0, int y0, int x1, int y1) const;
+    
+    /**
+     * @brief Актуализировать таблицу сумм препятствий заранее
+     * 
+     * countObstacles() пересчитывает таблицу сам, но это запись в общее
+     * состояние: перед чтением из нескольких потоков таблицу нужно
+     * актуализировать явно.
+     */
+    void refreshObstacleCounts() const;
+    
+    /**
+     * @brief Актуализировать длины свободных отрезков заранее
+     * 
+     * Как и для таблицы сумм, перед чтением getFreeRun() из нескольких
+     * потоков устаревшие линии нужно пересчитать явно.
+     */
+    void refreshFreeRuns() const;
+    
+    /**
+     * @brief Получить упакованную строку занятости
+     * 
+     * Бит x % 64 слова x / 64 установлен, если клетка (x, y) - препятствие.
+     * Строки обновляются вместе с проходимостью клеток и используются
+     * битовыми проверками прямой видимости.
+     * @param y Номер строки (должен быть корректным)
+     * @return Указатель на getOccupancyStride() слов строки
+     */
+    const std::uint64_t* getOccupancyRow(int y) const { return &occupancy_[static_cast<std::size_t>(y) * occupancy_stride_]; }
+    
+    /// Количество 64-битных слов в строке занятости
+    int getOccupancyStride() const { return occupancy_stride_; }
+    
+    /**
+     * @brief Получить версию карты
+     * 
+     * Версия берется из общего для всех сеток счетчика при создании сетки
+     * и при каждом изменении проходимости клетки. Копия сетки наследует
+     * версию, поэтому равные версии означают одинаковую занятость: по ней
+     * кэши результатов проверяют, что записи относятся к этой карте.
+     * @return Версия карты
+     */
+    std::uint64_t getVersion() const { return version_; }
+    
+    /**
+     * @brief Получить версию отсечения клеток
+     * 
+     * Меняется, когда setPruned(), clearPruned() или setReserved()
+     * действительно закрывают или открывают клетку для входа; берется из
+     * того же счетчика, что и версия карты. Отсечение и резерв не трогают
+     * getVersion(), чтобы не сбрасывать кэши прямой видимости, а кэши,
+     * которые их учитывают, проверяют обе версии.
+     * @return Версия отсечения (0 - в сетке ничего не отсекалось)
+     */
+    std::uint64_t getPruningVersion() const { return pruning_version_; }
+    
+    /**
+     * @brief Получить длину свободного отрезка от клетки в направлении
+     * 
+     * Для каждой клетки и каждого из 8 направлений хранится число подряд
+     * идущих свободных клеток, начиная с нее самой. Изменение клетки
+     * помечает устаревшими ее строку, столбец и две диагонали; при следующем
+     * запросе пересчитываются только помеченные линии, поэтому массовое
+     * заполнение карты стоит один проход по ней.
+     * @param x Координата X
+     * @param y Координата Y
+     * @param dx Направление по X (-1, 0, 1)
+     * @param dy Направление по Y (-1, 0, 1), не одновременно с dx равное 0
+     * @return Длина отрезка (0 для препятствия или клетки вне сетки);
+     *         kMaxFreeRun означает "не меньше kMaxFreeRun"
+     */
+    int getFreeRun(int x, int y, int dx, int dy) const {
+        if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+            return 0;
+        }
+        if (!dirty_run_lines_.empty()) {
+            refreshFreeRuns();
+        }
+        return free_runs_[(static_cast<std::size_t>(y) * width_ + x) * 8 + runDirection(dx, dy)];
+    }
 
 private:
     int width_;                                     ///< Ширина сетки
     int height_;                                    ///< Высота сетки
     std::vector<std::vector<Node>> nodes_;          ///< Двумерный массив узлов
     
+    mutable std::vector<int> component_parent_;     ///< Лес union-find (элементы создаются при освобождении клеток)
+    mutable std::vector<int> component_node_;       ///< Клетка -> элемент union-find
+    mutable bool components_valid_;                 ///< Метки компонент актуальны
+    
+    mutable std::vector<int> obstacle_sums_;        ///< Префиксные суммы препятствий, (width+1) x (height+1)
+    mutable int sums_dirty_x_;                      ///< Левая граница устаревшей части таблицы (width_ - актуальна)
+    mutable int sums_dirty_y_;                      ///< Верхняя граница устаревшей части таблицы (height_ - актуальна)
+    
+    int occupancy_stride_;                          ///< Слов на строку занятости
+    std::vector<std::uint64_t> occupancy_;          ///< Битовые строки препятствий
+    std::uint64_t version_;                         ///< Версия карты (меняется при изменении проходимости)
+    std::uint64_t pruning_version_;                 ///< Версия отсечения и резерва (0 - ничего не закрывалось)
+    mutable std::vector<std::uint16_t> free_runs_;  ///< Длины свободных отрезков, 8 направлений на клетку
+    mutable std::vector<std::uint8_t> run_line_dirty_; ///< Флаги устаревших линий: строки, столбцы, диагонали
+    mutable std::vector<int> dirty_run_lines_;      ///< Номера устаревших линий
+    
     /**
      * @brief Инициализировать сетку
      */
     void initializeGrid();
+    
+    /// Ход по правилам canMove() без учета отсечения
+    bool isMoveOpen(int x, int y, int dx, int dy) const;
+    
+    /// Пересчитать компоненты связности всей сетки
+    void rebuildComponents() const;
+    
+    /// Корень множества элемента union-find (со сжатием пути)
+    int findComponent(int element) const;
+    
+    /// Объединить компоненты двух свободных клеток
+    void uniteCells(int cell_a, int cell_b) const;
+    
+    /// Может ли новое препятствие в клетке разрезать ее компоненту
+    bool mayDisconnect(int x, int y) const;
+    
+    /// Отметить изменение проходимости клетки: таблица сумм, строка занятости, версия, отрезки
+    void markObstacleChanged(int x, int y);
+    
+    /// Номер направления (dx, dy) в таблице свободных отрезков
+    static int runDirection(int dx, int dy) {
+        int index = (dy + 1) * 3 + (dx + 1);
+        return index > 4 ? index - 1 : index;
+    }
+    
+    /// Пометить устаревшими линии свободных отрезков через клетку
+    void markFreeRunsDirty(int x, int y);
+    
+    /// Пересчитать отрезки вдоль линии в обоих направлениях
+    void sweepFreeRuns(int x, int y, int dx, int dy) const;
 };
 
 #endif // GRID_H
\ No newline at end of file
@@ -12,6 +12,8 @@
 #include "../../config.h"
 #include <memory>
 #include <cmath>
+#include <functional>
+#include <vector>
 
 /**
  * @struct Node
@@ -22,6 +24,8 @@ struct Node {
     int y;                          ///< Координата Y на сетке
     
     bool walkable;                  ///< Доступность узла (true - проходимый)
+    bool pruned;                    ///< Клетка отсечена для текущего запроса (тупик или болото)
+    bool reserved;                  ///< Клетка занята временным слоем (например, зоной проложенной трубы)
     
     double g_cost;                  ///< Стоимость пути от старта до этого узла
     double h_cost;                  ///< Эвристическая оценка до цели
@@ -36,7 +40,7 @@ struct Node {
      * @param is_walkable Флаг проходимости
      */
     Node(int x_coord, int y_coord, bool is_walkable = true)
-        : x(x_coord), y(y_coord), walkable(is_walkable),
+        : x(x_coord), y(y_coord), walkable(is_walkable), pruned(false), reserved(false),
           g_cost(0.0), h_cost(0.0), f_cost(0.0), parent(nullptr) {}
     
     /**
@@ -103,4 +107,39 @@ struct Node {
     }
 };
 
+/**
+ * @brief Подключаемая эвристика: оценка стоимости пути от узла до цели
+ *
+ * Пустая функция означает стандартную Node::calculateHeuristic.
+ */
+using HeuristicFunction = std::function<double(const Node& from, const Node& target)>;
+
+/**
+ * @brief Подключаемый фильтр соседей: можно ли идти из узла в соседа к цели
+ *
+ * Возвращает false для ходов, заведомо не лежащих ни на одном оптимальном
+ * пути к цели. Пустая функция означает отсутствие фильтрации.
+ */
+using NeighborFilter = std::function<bool(const Node& from, const Node& neighbor, const Node& target)>;
+
+/**
+ * @struct Successor
+ * @brief Преемник узла от подключаемого генератора: клетка и стоимость перехода
+ */
+struct Successor {
+    int x;                              ///< Координата X клетки
+    int y;                              ///< Координата Y клетки
+    double cost;                        ///< Стоимость перехода из раскрываемого узла
+};
+
+/**
+ * @brief Подключаемый генератор преемников вместо Grid::getNeighbors
+ *
+ * Заполняет successors для раскрываемого узла. Преемник может быть
+ * несоседней клеткой (макроребро); тогда октильный маршрут до нее
+ * (сначала по диагонали, затем по прямой) обязан быть свободен.
+ */
+using SuccessorFunction = std::function<void(const Node& from, const Node& target,
+                                             std::vector<Successor>& successors)>;
+
 #endif // NODE_H
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * @file obstacle_inflator.h
+ * @brief Инкрементальная инфляция: слой временных препятствий поверх сетки
+ *
+ * Grid::inflateObstacles раздувает все препятствия карты разом и не
+ * умеет отменять результат. Инфлятор ставит и снимает отдельные "штампы"
+ * (клетка вместе с кругом заданного радиуса) прямо в исходной сетке, не
+ * копируя ее: каждая клетка слоя хранит число накрывающих ее штампов, и
+ * резерв клетки (Grid::setReserved) меняется только при переходе счетчика
+ * через ноль. Клетки, занятые в исходной карте, слой не трогает.
+ */
+
+#ifndef OBSTACLE_INFLATOR_H
+#define OBSTACLE_INFLATOR_H
+
+#include "grid.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <functional>
+
+/**
+ * @brief Слушатель смены резерва клетки
+ * @param x Координата X клетки, резерв которой поставлен или снят
+ * @param y Координата Y клетки
+ */
+using CellListener = std::function<void(int x, int y)>;
+
+/**
+ * @class ObstacleInflator
+ * @brief Счетчики штампов по клеткам и их применение к сетке
+ *
+ * Штампы закрывают клетки резервом, а не препятствиями: поиск по
+ * getNeighbors() и canMove() их обходит, а версия карты, строки
+ * занятости, компоненты связности, таблицы сумм и отрезков и кэши прямой
+ * видимости не меняются. Освобожденные клетки (setExempt) штампы не
+ * закрывают, но учитывают в счетчиках. Деструктор снимает все штампы,
+ * поэтому слой, выходящий из области видимости (в том числе при
+ * исключении), не оставляет резерв в сетке. Слушатель (setCellListener)
+ * узнает о каждой смене резерва, чтобы структуры над сеткой (например,
+ * RectangularSymmetryReduction::update) обновлялись локально.
+ */
+class ObstacleInflator {
+public:
+    /**
+     * @brief Конструктор слоя
+     * @param grid Сетка, к которой применяются штампы
+     * @param radius Радиус штампа в клетках (клетки с расстоянием до центра не больше радиуса)
+     * @throw std::invalid_argument если радиус отрицательный
+     */
+    ObstacleInflator(Grid& grid, double radius);
+
+    /**
+     * @brief Деструктор: снимает все штампы
+     */
+    ~ObstacleInflator();
+
+    ObstacleInflator(const ObstacleInflator&) = delete;
+    ObstacleInflator& operator=(const ObstacleInflator&) = delete;
+
+    /**
+     * @brief Поставить штамп с центром в клетке
+     * @param x Координата X центра
+     * @param y Координата Y центра
+     */
+    void stamp(int x, int y);
+
+    /**
+     * @brief Снять штамп, поставленный ранее с тем же центром
+     * @param x Координата X центра
+     * @param y Координата Y центра
+     */
+    void erase(int x, int y);
+
+    /**
+     * @brief Поставить штампы во всех клетках пути
+     * @param path Путь (узлы сетки)
+     */
+    void stampPath(const std::vector<Node*>& path);
+
+    /**
+     * @brief Снять штампы всех клеток пути
+     * @param path Путь, штампы которого были поставлены stampPath
+     */
+    void erasePath(const std::vector<Node*>& path);
+
+    /**
+     * @brief Снять все штампы и освобождения и вернуть сетке исходный резерв
+     */
+    void clear();
+
+    /**
+     * @brief Освободить клетку от штампов или вернуть ее слою
+     *
+     * Освобожденная клетка не закрывается штампами (например, конец трубы,
+     * который нельзя занять зоной соседней трубы). Если клетка уже накрыта,
+     * резерв снимается или ставится сразу.
+     * @param x Координата X
+     * @param y Координата Y
+     * @param exempt true - освободить, false - вернуть слою
+     */
+    void setExempt(int x, int y, bool exempt);
+
+    /**
+     * @brief Освобождена ли клетка от штампов
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если клетка освобождена (false вне карты)
+     */
+    bool isExempt(int x, int y) const;
+
+    /**
+     * @brief Количество штампов, накрывающих клетку
+     * @param x Координата X
+     * @param y Координата Y
+     * @return Количество штампов (0 вне карты)
+     */
+    int getCoverage(int x, int y) const;
+
+    /**
+     * @brief Закрыта ли клетка резервом этого слоя
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если клетка свободна в исходной карте, но накрыта штампом и не освобождена
+     */
+    bool isOverlay(int x, int y) const;
+
+    /**
+     * @brief Задать слушателя смены резерва клеток
+     *
+     * Вызывается после каждой постановки и снятия резерва, в том числе из
+     * clear() и деструктора, поэтому должен жить дольше слоя.
+     * @param listener Слушатель (пустой - отключить)
+     */
+    void setCellListener(CellListener listener) { listener_ = std::move(listener); }
+
+    /// Смещения клеток штампа относительно центра
+    const std::vector<std::pair<int, int>>& getOffsets() const { return offsets_; }
+
+    /// Радиус штампа в клетках
+    double getRadius() const { return radius_; }
+
+    /// Количество переключений резерва клеток сетки с создания слоя
+    long long getToggledCells() const { return toggled_cells_; }
+
+private:
+    Grid& grid_;                                    ///< Сетка, к которой применяются штампы
+    double radius_;                                 ///< Радиус штампа
+    std::vector<std::pair<int, int>> offsets_;      ///< Клетки штампа относительно центра
+    std::vector<int> coverage_;                     ///< Число штампов на клетке
+    std::vector<std::uint8_t> owned_;               ///< Клетка зарезервирована этим слоем
+    std::vector<std::uint8_t> exempt_;              ///< Клетка освобождена от штампов
+    long long toggled_cells_;                       ///< Счетчик переключений резерва
+    CellListener listener_;                         ///< Слушатель смены резерва (может быть пустым)
+
+    /// Зарезервировать или освободить клетку, если ее состояние должно измениться
+    void updateCell(std::size_t cell);
+
+    /// Поставить или снять резерв клетки и сообщить слушателю
+    void toggleCell(int x, int y, bool reserved);
+};
+
+#endif // OBSTACLE_INFLATOR_H
@@ -0,0 +1,30 @@
+/**
+ * @file caves.h
+ * @brief Сценарий "Пещеры"
+ */
+
+#ifndef CAVES_H
+#define CAVES_H
+
+#include "grid/grid.h"
+
+namespace scenarios {
+
+/**
+ * @brief Создать сценарий "Пещеры" (клеточный автомат)
+ * 
+ * Случайное заполнение сглаживается правилом "4-5", после чего старт и
+ * финиш ставятся в самой большой пещере у противоположных углов карты.
+ * @param grid Сетка для инициализации
+ * @param start_x Начальная координата X (выходной параметр)
+ * @param start_y Начальная координата Y (выходной параметр)
+ * @param end_x Конечная координата X (выходной параметр)
+ * @param end_y Конечная координата Y (выходной параметр)
+ * @param seed Seed для генератора случайных чисел
+ */
+void createCaves(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
+                 unsigned int seed = 42);
+
+} // namespace scenarios
+
+#endif // CAVES_H
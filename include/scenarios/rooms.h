@@ -0,0 +1,32 @@
+/**
+ * @file rooms.h
+ * @brief Сценарий "Комнаты"
+ */
+
+#ifndef ROOMS_H
+#define ROOMS_H
+
+#include "grid/grid.h"
+
+namespace scenarios {
+
+/**
+ * @brief Создать сценарий "Комнаты"
+ * 
+ * Карта делится стенами на квадратные комнаты; двери прорезаются по
+ * случайному остовному дереву комнат и небольшому числу лишних проходов,
+ * поэтому многие комнаты оказываются тупиками.
+ * @param grid Сетка для инициализации
+ * @param start_x Начальная координата X (выходной параметр)
+ * @param start_y Начальная координата Y (выходной параметр)
+ * @param end_x Конечная координата X (выходной параметр)
+ * @param end_y Конечная координата Y (выходной параметр)
+ * @param room_size Сторона комнаты вместе со стеной
+ * @param seed Seed для генератора случайных чисел
+ */
+void createRooms(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
+                 int room_size = 10, unsigned int seed = 42);
+
+} // namespace scenarios
+
+#endif // ROOMS_H
@@ -40,6 +40,13 @@ namespace scenarios {
  */
 std::vector<TestScenario> createAllScenarios();
 
+/**
+ * @brief Создать большие сгенерированные сценарии для сравнения времени работы
+ * @param size Сторона квадратной карты в клетках
+ * @return Вектор сценариев (не сохраняются на диск)
+ */
+std::vector<TestScenario> createLargeScenarios(int size = config::LARGE_GRID_SIZE);
+
 /**
  * @brief Сохранить сценарий в файл
  * @param scenario Сценарий для сохранения
@@ -100,6 +107,10 @@ void createManyObstacles(Grid& grid, int& start_x, int& start_y, int& end_x, int
 void createNarrowCorridors(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
                           int corridor_width = 3);
 void createRandomObstacles(Grid& grid, int density, unsigned int seed = 42);
+void createCaves(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
+                 unsigned int seed = 42);
+void createRooms(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
+                 int room_size = 10, unsigned int seed = 42);
 bool isPathPossible(const Grid& grid, int start_x, int start_y, int end_x, int end_y);
 std::string getScenarioName(int index);
 
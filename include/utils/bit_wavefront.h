@@ -0,0 +1,172 @@
+/**
+ * @file bit_wavefront.h
+ * @brief Битово-параллельная волна по упакованным строкам занятости
+ *
+ * Волна работает со словами по 64 клетки: соседство по строке - сдвиги
+ * слова с переносом бита из соседнего слова, соседство между строками -
+ * побитовое ИЛИ строк выше и ниже, ограничение свободными клетками -
+ * побитовое И с инверсией занятости. Поддерживаются 4- и 8-связность.
+ */
+
+#ifndef BIT_WAVEFRONT_H
+#define BIT_WAVEFRONT_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @enum Connectivity
+ * @brief Связность клеток для волны
+ */
+enum class Connectivity {
+    Four,                               ///< Соседи по сторонам
+    Eight                               ///< Соседи по сторонам и углам (со срезанием углов)
+};
+
+/**
+ * @class BitWavefront
+ * @brief Маски достижимости и слои расстояний в шагах по упакованной карте
+ *
+ * Достижимость (flood) считается построчными проходами вниз и вверх:
+ * строка получает затравку из уже достигнутых соседних строк и заливается
+ * до краев свободных отрезков логарифмической заливкой внутри слова с
+ * переносом между словами. Строки пересчитываются, только пока меняются
+ * их соседи, поэтому открытая карта заливается за несколько проходов.
+ * Расстояния (computeDistances) считаются обычной волной по шагам, но
+ * фронт хранится как список непустых слов, и каждый шаг стоит
+ * пропорционально его размеру, а не размеру карты.
+ * Объект не копирует карту: сетка (или массив занятости) должна жить
+ * дольше него, а результаты описывают карту на момент вызова.
+ */
+class BitWavefront {
+public:
+    /**
+     * @brief Конструктор по сетке
+     * @param grid Сетка; используются ее строки занятости
+     * @param connectivity Связность (по умолчанию - как у ходов Grid)
+     */
+    explicit BitWavefront(const Grid& grid, Connectivity connectivity = defaultConnectivity());
+
+    /**
+     * @brief Конструктор по упакованной занятости без Grid
+     *
+     * Позволяет заливать карты, для которых сетка узлов слишком велика.
+     * @param occupancy Строки занятости: бит x % 64 слова y * stride + x / 64 - препятствие
+     * @param width Ширина карты
+     * @param height Высота карты
+     * @param stride Слов на строку (не меньше (width + 63) / 64)
+     * @param connectivity Связность
+     * @throw std::invalid_argument если размеры некорректны
+     */
+    BitWavefront(const std::uint64_t* occupancy, int width, int height, int stride, Connectivity connectivity);
+
+    /**
+     * @brief Связность, которой соответствуют ходы Grid::canMove
+     *
+     * При запрете срезания углов диагональный ход требует двух свободных
+     * соседей по сторонам, поэтому достижимость совпадает с 4-связной.
+     * @return Connectivity::Eight, если разрешены диагонали со срезанием углов
+     */
+    static Connectivity defaultConnectivity();
+
+    /**
+     * @brief Залить область, достижимую из клетки
+     * @param x Координата X источника
+     * @param y Координата Y источника
+     * @return Количество достигнутых клеток (0 если источник занят или вне карты)
+     */
+    long long flood(int x, int y);
+
+    /**
+     * @brief Залить область, достижимую из нескольких источников
+     * @param sources Источники (занятые и внешние пропускаются)
+     * @return Количество достигнутых клеток
+     */
+    long long flood(const std::vector<std::pair<int, int>>& sources);
+
+    /**
+     * @brief Посчитать расстояния в шагах от источника
+     * @param x Координата X источника
+     * @param y Координата Y источника
+     * @param max_distance Наибольшее расстояние волны (-1 - без ограничения)
+     * @return Наибольшее достигнутое расстояние (-1 если источник занят или вне карты)
+     */
+    int computeDistances(int x, int y, int max_distance = -1);
+
+    /**
+     * @brief Посчитать расстояния в шагах от ближайшего из источников
+     * @param sources Источники (расстояние 0)
+     * @param max_distance Наибольшее расстояние волны (-1 - без ограничения)
+     * @return Наибольшее достигнутое расстояние (-1 если ни один источник не свободен)
+     */
+    int computeDistances(const std::vector<std::pair<int, int>>& sources, int max_distance = -1);
+
+    /**
+     * @brief Достигнута ли клетка последней заливкой или волной
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если клетка достигнута
+     */
+    bool isReached(int x, int y) const;
+
+    /**
+     * @brief Получить строку маски достижимости
+     * @param y Номер строки (должен быть корректным)
+     * @return Указатель на getStride() слов; бит установлен для достигнутой клетки
+     */
+    const std::uint64_t* getReachedRow(int y) const { return &reached_[static_cast<std::size_t>(y) * stride_]; }
+
+    /**
+     * @brief Получить расстояние последней волны
+     * @param x Координата X
+     * @param y Координата Y
+     * @return Расстояние в шагах (-1 если клетка не достигнута или вне карты)
+     */
+    int getDistance(int x, int y) const;
+
+    /// Слой расстояний последней волны, width * height значений по строкам (-1 - не достигнута)
+    const std::vector<int>& getDistances() const { return distances_; }
+
+    /// Слов на строку маски
+    int getStride() const { return stride_; }
+
+    /// Количество пересчитанных строк (flood) или шагов волны (computeDistances) в последнем вызове
+    long long getIterations() const { return iterations_; }
+
+    /// Время последнего вызова (мс)
+    double getLastTime() const { return last_time_; }
+
+private:
+    const std::uint64_t* occupancy_;                ///< Строки занятости
+    int width_;                                     ///< Ширина карты
+    int height_;                                    ///< Высота карты
+    int stride_;                                    ///< Слов на строку
+    int words_;                                     ///< Слов с клетками карты в строке
+    Connectivity connectivity_;                     ///< Связность
+    std::uint64_t last_word_mask_;                  ///< Биты клеток карты в последнем слове строки
+
+    std::vector<std::uint64_t> reached_;            ///< Маска достигнутых клеток
+    std::vector<int> distances_;                    ///< Расстояния последней волны
+    long long iterations_;                          ///< Счетчик пересчитанных строк или шагов
+    double last_time_;                              ///< Время последнего вызова (мс)
+
+    /// Свободные клетки слова строки
+    std::uint64_t freeWord(int y, int w) const;
+
+    /// Слово соседей слова w строки row (3 слова вокруг) по горизонтали
+    std::uint64_t spreadWord(const std::uint64_t* row, int w) const;
+
+    /**
+     * @brief Пересчитать строку заливки по соседним строкам
+     * @param y Номер строки
+     * @param pending Флаги строк, ожидающих пересчета
+     * @param row Буфер строки (getStride() слов)
+     */
+    void floodRow(int y, std::vector<char>& pending, std::vector<std::uint64_t>& row);
+};
+
+#endif // BIT_WAVEFRONT_H
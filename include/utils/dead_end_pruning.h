@@ -0,0 +1,100 @@
+/**
+ * @file dead_end_pruning.h
+ * @brief Отсечение тупиков и "болот" перед поиском пути
+ *
+ * Тупик - часть карты, отделенная от пути "старт - цель" шарниром
+ * (точкой сочленения): ни один простой путь не заходит в нее, если старт
+ * или цель не лежат внутри. Болото - небольшая область, любой проход
+ * через которую можно заменить не более длинным обходом, поэтому без
+ * нее сохраняется хотя бы один оптимальный путь.
+ */
+
+#ifndef DEAD_END_PRUNING_H
+#define DEAD_END_PRUNING_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+#include <array>
+
+/**
+ * @class DeadEndPruning
+ * @brief Предобработка тупиков и болот и разметка отсеченных клеток
+ *
+ * build() строит дерево блоков и шарниров (двусвязные компоненты) и
+ * выращивает болота с локальной проверкой обходов. apply() для конкретного
+ * запроса отмечает через Grid::setPruned() все клетки вне блоков на пути
+ * между стартом и целью и все болота, не содержащие старт или цель.
+ * Алгоритмы, обходящие сетку через getNeighbors()/canMove(), пропускают
+ * отмеченные клетки без изменений в своем коде.
+ */
+class DeadEndPruning {
+public:
+    /**
+     * @brief Конструктор предобработки
+     * @param grid Сетка без отсечений, для которой строятся области
+     */
+    explicit DeadEndPruning(const Grid& grid);
+
+    /**
+     * @brief Построить дерево блоков и болота
+     */
+    void build();
+
+    /**
+     * @brief Отметить отсеченные клетки для запроса
+     * @param target Сетка алгоритма (той же карты), в которой ставятся отметки
+     * @param start_x Начальная координата X
+     * @param start_y Начальная координата Y
+     * @param end_x Конечная координата X
+     * @param end_y Конечная координата Y
+     * @param prune_swamps Отсекать ли болота; обход болота оптимален только
+     *                     для 8-связных путей, поэтому any-angle алгоритмам
+     *                     достаточно тупиков
+     * @return Количество отсеченных свободных клеток
+     */
+    int apply(Grid& target, int start_x, int start_y, int end_x, int end_y, bool prune_swamps = true) const;
+
+    /// Количество болот
+    int getSwampCount() const { return swamp_count_; }
+
+    /// Количество клеток во всех болотах
+    int getSwampCellCount() const { return swamp_cells_; }
+
+    /// Количество двусвязных блоков
+    int getBlockCount() const { return block_count_; }
+
+    /// Время последнего построения (мс)
+    double getBuildTime() const { return build_time_; }
+
+private:
+    const Grid& grid_;                              ///< Карта, для которой построены области
+    double build_time_;                             ///< Время последнего построения (мс)
+
+    int block_count_;                               ///< Количество блоков
+    std::vector<int> cell_block_;                   ///< Клетка -> блок (-1 для препятствий и шарниров)
+    std::vector<int> cut_index_;                    ///< Клетка -> номер шарнира (-1 если не шарнир)
+    std::vector<std::vector<int>> cut_blocks_;      ///< Шарнир -> блоки, которым он принадлежит
+    std::vector<std::vector<int>> tree_;            ///< Дерево: блоки [0, B), затем шарниры
+
+    int swamp_count_;                               ///< Количество болот
+    int swamp_cells_;                               ///< Клеток в болотах
+    std::vector<int> swamp_;                        ///< Клетка -> болото (-1 если нет)
+    std::vector<std::vector<int>> swamp_members_;   ///< Клетки каждого болота
+    std::vector<std::array<int, 4>> swamp_bounds_;  ///< Прямоугольник болота (min_x, min_y, max_x, max_y)
+
+    /// Найти двусвязные блоки и шарниры (итеративный алгоритм Тарьяна)
+    void buildBlocks();
+
+    /// Вырастить болота жадно от клеток у препятствий
+    void buildSwamps();
+
+    /// Проверить условие болота для области region с номером id
+    bool isSwamp(const std::vector<int>& region, int id) const;
+
+    /// Узел дерева блоков и шарниров, содержащий клетку
+    int treeNode(int cell) const;
+};
+
+#endif // DEAD_END_PRUNING_H
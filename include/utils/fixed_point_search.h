@@ -0,0 +1,126 @@
+/**
+ * @file fixed_point_search.h
+ * @brief Общие средства поиска со стоимостями в фиксированной точке
+ *
+ * Стоимости ходов хранятся как целые числа, умноженные на 2^20: ошибка
+ * округления на пути много меньше разности неравных сумм a + b * sqrt(2),
+ * поэтому равные по длине пути сравниваются точно. Элемент очереди -
+ * одно 64-битное слово (стоимость << kNodeBits) | клетка.
+ */
+
+#ifndef FIXED_POINT_SEARCH_H
+#define FIXED_POINT_SEARCH_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+#include <queue>
+#include <functional>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @namespace fixed_point
+ * @brief Пространство имен для поиска со стоимостями в фиксированной точке
+ */
+namespace fixed_point {
+
+constexpr int kCostShift = 20;                                  ///< Двоичный порядок масштаба стоимостей
+constexpr double kCostScale = 1 << kCostShift;                  ///< Масштаб стоимостей: единица стоимости
+constexpr int kNodeBits = 24;                                   ///< Биты клетки в элементе очереди
+constexpr std::uint64_t kNodeMask = (1ULL << kNodeBits) - 1;    ///< Маска клетки в элементе очереди
+constexpr std::uint64_t kUnreached = std::numeric_limits<std::uint64_t>::max(); ///< Расстояние до непосещенной клетки
+
+/// Очередь с приоритетом по наименьшей стоимости
+using Queue = std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>>;
+
+/**
+ * @brief Стоимость хода в фиксированной точке
+ * @param dx Смещение по X (-1, 0, 1)
+ * @param dy Смещение по Y (-1, 0, 1)
+ * @return Стоимость хода, умноженная на kCostScale
+ */
+inline std::uint64_t stepCost(int dx, int dy) {
+    return static_cast<std::uint64_t>(
+        std::llround(((dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0) * kCostScale));
+}
+
+/// Упаковать стоимость и клетку в элемент очереди
+inline std::uint64_t packEntry(std::uint64_t cost, int cell) {
+    return (cost << kNodeBits) | static_cast<std::uint64_t>(cell);
+}
+
+/// Стоимость из элемента очереди
+inline std::uint64_t entryCost(std::uint64_t entry) { return entry >> kNodeBits; }
+
+/// Клетка из элемента очереди
+inline int entryCell(std::uint64_t entry) { return static_cast<int>(entry & kNodeMask); }
+
+/// Перевести стоимость из фиксированной точки
+inline double toCost(std::uint64_t cost) { return static_cast<double>(cost) / kCostScale; }
+
+/**
+ * @brief Дейкстра от источника с множествами оптимальных первых ходов
+ *
+ * Граф задан таблицей соседей neighbors[v * 8 + d] (-1 если хода d нет),
+ * вершин не больше 2^kNodeBits. Множество первых ходов first[v] - маска
+ * направлений из источника, с которых начинается хотя бы один кратчайший
+ * путь до v; оно наследуется от всех оптимальных родителей.
+ * @param neighbors Таблица соседей
+ * @param step_cost Стоимость хода по каждому из восьми направлений
+ * @param source Источник
+ * @param dist Расстояния (размер - число вершин; заполняется заново)
+ * @param first Маски первых ходов (заполняются вызывающим, для недостижимых остаются как есть)
+ */
+template <typename MoveMask>
+void firstMoveDijkstra(const std::vector<int>& neighbors, const std::uint64_t (&step_cost)[8], int source,
+                       std::vector<std::uint64_t>& dist, std::vector<MoveMask>& first) {
+    std::fill(dist.begin(), dist.end(), kUnreached);
+
+    Queue queue;
+    dist[source] = 0;
+    queue.push(packEntry(0, source));
+
+    while (!queue.empty()) {
+        std::uint64_t entry = queue.top();
+        queue.pop();
+        std::uint64_t cost = entryCost(entry);
+        int current = entryCell(entry);
+        if (cost > dist[current]) {
+            continue;
+        }
+
+        for (int d = 0; d < 8; ++d) {
+            int next = neighbors[static_cast<std::size_t>(current) * 8 + d];
+            if (next == -1) {
+                continue;
+            }
+            std::uint64_t candidate = cost + step_cost[d];
+            MoveMask moves = current == source ? static_cast<MoveMask>(1u << d) : first[current];
+            if (candidate < dist[next]) {
+                dist[next] = candidate;
+                first[next] = moves;
+                queue.push(packEntry(candidate, next));
+            } else if (candidate == dist[next]) {
+                first[next] |= moves;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Хеш карты для проверки файлов кэша
+ *
+ * FNV-1a по размерам, проходимости клеток и правилам движения
+ * (диагонали, их стоимость, срезание углов): таблицы путей, построенные
+ * для другой карты или при других правилах, не совпадут по хешу.
+ * @param grid Сетка
+ * @return 64-битный хеш
+ */
+std::uint64_t mapHash(const Grid& grid);
+
+} // namespace fixed_point
+
+#endif // FIXED_POINT_SEARCH_H
@@ -0,0 +1,112 @@
+/**
+ * @file goal_bounding.h
+ * @brief Отсечение соседей по ограничивающим прямоугольникам целей (goal bounding)
+ *
+ * Для каждой клетки и каждого из 8 направлений хранится прямоугольник,
+ * содержащий все цели, оптимальный путь к которым может начинаться ходом в
+ * этом направлении. Если цель запроса вне прямоугольника, ход в это
+ * направление не лежит ни на одном оптимальном пути и соседа можно пропустить.
+ */
+
+#ifndef GOAL_BOUNDING_H
+#define GOAL_BOUNDING_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class GoalBounding
+ * @brief Таблица прямоугольников целей для всех клеток и направлений
+ *
+ * Таблица строится поиском Дейкстры от каждой свободной клетки (в несколько
+ * потоков) и сохраняется в компактный двоичный файл: 8 прямоугольников
+ * uint16 на клетку, с хешем карты для проверки совместимости. Прямоугольник
+ * учитывает все оптимальные первые ходы, поэтому отсечение сохраняет
+ * оптимальность A*.
+ */
+class GoalBounding {
+public:
+    /**
+     * @brief Конструктор таблицы
+     * @param grid Сетка, для которой строится таблица
+     * @param threads Количество потоков построения (0 - по числу ядер)
+     */
+    explicit GoalBounding(const Grid& grid, unsigned threads = config::GOAL_BOUNDING_BUILD_THREADS);
+
+    /**
+     * @brief Построить таблицу в памяти
+     * @throw std::runtime_error если свободных клеток больше GOAL_BOUNDING_MAX_CELLS
+     */
+    void build();
+
+    /**
+     * @brief Сохранить таблицу в двоичный файл
+     * @param filename Имя файла
+     * @return true при успехе
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Загрузить таблицу из двоичного файла
+     * @param filename Имя файла
+     * @return true если файл существует и построен для этой карты
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Загрузить таблицу из файла, а при его отсутствии построить и сохранить
+     * @param filename Имя файла кэша
+     * @throw std::runtime_error если карта слишком велика для построения
+     */
+    void buildOrLoad(const std::string& filename);
+
+    /**
+     * @brief Может ли ход из клетки лежать на оптимальном пути к цели
+     * @param x Координата X клетки
+     * @param y Координата Y клетки
+     * @param dx Смещение хода по X (-1, 0, 1)
+     * @param dy Смещение хода по Y (-1, 0, 1)
+     * @param target_x Координата X цели
+     * @param target_y Координата Y цели
+     * @return false если цель вне прямоугольника направления
+     */
+    bool allows(int x, int y, int dx, int dy, int target_x, int target_y) const;
+
+    /**
+     * @brief Получить фильтр соседей для подключения к алгоритму
+     * @return Фильтр; ссылается на этот объект
+     */
+    NeighborFilter asFilter() const;
+
+    /// Построена ли таблица
+    bool isReady() const { return !boxes_.empty(); }
+
+    /// Размер таблицы в байтах
+    std::size_t getSizeBytes() const { return boxes_.size() * sizeof(Box); }
+
+    /// Время последнего построения (мс, 0 если таблица загружена)
+    double getBuildTime() const { return build_time_; }
+
+private:
+    /**
+     * @brief Прямоугольник целей; пустой, если min_x > max_x
+     */
+    struct Box {
+        std::uint16_t min_x;            ///< Левая граница
+        std::uint16_t min_y;            ///< Верхняя граница
+        std::uint16_t max_x;            ///< Правая граница
+        std::uint16_t max_y;            ///< Нижняя граница
+    };
+
+    const Grid& grid_;                              ///< Сетка, для которой построена таблица
+    unsigned threads_;                              ///< Количество потоков построения
+    double build_time_;                             ///< Время последнего построения (мс)
+    std::vector<Box> boxes_;                        ///< Прямоугольники: клетка * 8 + направление
+};
+
+#endif // GOAL_BOUNDING_H
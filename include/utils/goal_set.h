@@ -0,0 +1,83 @@
+/**
+ * @file goal_set.h
+ * @brief Множество целей и эвристика до ближайшей из них
+ *
+ * Поиск к любой из K целей идет одним A*: эвристика - минимум допустимых
+ * оценок по целям, поэтому она остается допустимой и согласованной, а
+ * первая извлеченная из очереди цель достигнута оптимально. Для большого
+ * K минимум по целям дорог, и оценкой служит слой расстояний в шагах от
+ * всех целей сразу (битовая волна).
+ */
+
+#ifndef GOAL_SET_H
+#define GOAL_SET_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+/**
+ * @class GoalSet
+ * @brief Цели поиска с проверкой принадлежности и оценкой расстояния
+ *
+ * Слой шагов не учитывает стоимость диагонали, но каждый ход стоит не
+ * меньше единицы, поэтому число шагов не превосходит длины пути по сетке.
+ * Слой строится в конструкторе и описывает карту на этот момент.
+ */
+class GoalSet {
+public:
+    /**
+     * @brief Конструктор множества целей
+     * @param grid Сетка поиска
+     * @param goals Цели (занятые, внешние и повторные пропускаются)
+     * @param field_threshold Количество целей, с которого оценка берется из слоя шагов
+     */
+    GoalSet(const Grid& grid, const std::vector<std::pair<int, int>>& goals,
+            int field_threshold = config::MULTI_GOAL_FIELD_THRESHOLD);
+
+    /**
+     * @brief Найти цель по клетке
+     * @param x Координата X
+     * @param y Координата Y
+     * @return Индекс цели во входном списке (-1 если клетка не цель)
+     */
+    int find(int x, int y) const;
+
+    /**
+     * @brief Оценка длины пути по сетке до ближайшей цели
+     * @param node Узел
+     * @return Допустимая согласованная оценка (бесконечность, если цели недостижимы)
+     */
+    double estimate(const Node& node) const;
+
+    /**
+     * @brief Оценка длины any-angle пути до ближайшей цели
+     *
+     * Евклидов минимум допустим для любых путей; слой шагов делится на
+     * sqrt(4 - 2 sqrt(2)), как в LandmarkHeuristic::estimateAnyAngle.
+     * @param node Узел
+     * @return Допустимая оценка для Theta*
+     */
+    double estimateAnyAngle(const Node& node) const;
+
+    /// Допустимые цели (свободные, без повторов)
+    const std::vector<std::pair<int, int>>& getGoals() const { return goals_; }
+
+    /// Нет ни одной допустимой цели
+    bool empty() const { return goals_.empty(); }
+
+    /// Оценка берется из слоя шагов
+    bool usesField() const { return !hops_.empty(); }
+
+private:
+    const Grid& grid_;                              ///< Сетка поиска
+    std::vector<std::pair<int, int>> goals_;        ///< Допустимые цели
+    std::vector<Node> targets_;                     ///< Узлы целей для Node::calculateHeuristic
+    std::unordered_map<int, int> index_;            ///< Клетка -> индекс цели во входном списке
+    std::vector<int> hops_;                         ///< Шаги до ближайшей цели (пусто - минимум по целям)
+};
+
+#endif // GOAL_SET_H
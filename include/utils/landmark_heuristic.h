@@ -0,0 +1,121 @@
+/**
+ * @file landmark_heuristic.h
+ * @brief Эвристика ориентиров (ALT, дифференциальная эвристика)
+ *
+ * Для K ориентиров заранее вычисляются кратчайшие расстояния d(L, v) до всех
+ * клеток. По неравенству треугольника |d(L, t) - d(L, v)| не превосходит
+ * расстояния от v до t, поэтому максимум по ориентирам - допустимая
+ * эвристика, гораздо более информированная в лабиринтах, чем евклидова.
+ */
+
+#ifndef LANDMARK_HEURISTIC_H
+#define LANDMARK_HEURISTIC_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class LandmarkHeuristic
+ * @brief Предвычисленные расстояния от ориентиров и оценка ALT
+ *
+ * Ориентиры выбираются методом самой дальней точки, поиски Дейкстры от
+ * них выполняются параллельно. Расстояния хранятся по клеткам (K значений
+ * подряд) в uint16 с фиксированной точкой, а если диапазон не помещается -
+ * во float. Таблица не зависит от цели, поэтому одна сборка обслуживает
+ * все запросы на статической карте.
+ */
+class LandmarkHeuristic {
+public:
+    /**
+     * @brief Конструктор эвристики
+     * @param grid Сетка, для которой строится таблица
+     * @param landmarks Количество ориентиров
+     * @param threads Количество потоков построения (0 - по числу ядер)
+     */
+    explicit LandmarkHeuristic(const Grid& grid, int landmarks = config::ALT_LANDMARKS,
+                               unsigned threads = config::ALT_BUILD_THREADS);
+
+    /**
+     * @brief Выбрать ориентиры и вычислить расстояния от них
+     * @throw std::runtime_error если на карте нет свободных клеток
+     */
+    void build();
+
+    /**
+     * @brief Оценка длины кратчайшего пути по сетке
+     * @param x Координата X исходной клетки
+     * @param y Координата Y исходной клетки
+     * @param target_x Координата X цели
+     * @param target_y Координата Y цели
+     * @return Максимум из оценки ALT и октильного расстояния
+     */
+    double estimate(int x, int y, int target_x, int target_y) const;
+
+    /**
+     * @brief Оценка длины any-angle пути
+     *
+     * Кратчайший путь по 8-связной сетке длиннее any-angle пути не более
+     * чем в sqrt(4 - 2 sqrt(2)) раз, поэтому оценка делится на этот
+     * коэффициент и остается допустимой для Theta*.
+     */
+    double estimateAnyAngle(int x, int y, int target_x, int target_y) const;
+
+    /**
+     * @brief Получить эвристику для подключения к алгоритму
+     * @param any_angle true для any-angle алгоритмов (Theta*)
+     * @return Функция эвристики; ссылается на этот объект
+     */
+    HeuristicFunction asFunction(bool any_angle = false) const;
+
+    /// Построена ли таблица
+    bool isBuilt() const { return built_; }
+
+    /// Количество ориентиров
+    int getLandmarkCount() const { return static_cast<int>(landmarks_.size()); }
+
+    /// Координаты ориентиров
+    const std::vector<std::pair<int, int>>& getLandmarks() const { return landmarks_; }
+
+    /// Хранятся ли расстояния в компактном формате uint16
+    bool isCompact() const { return !compact_.empty(); }
+
+    /// Размер таблицы расстояний в байтах
+    std::size_t getSizeBytes() const {
+        return compact_.size() * sizeof(std::uint16_t) + wide_.size() * sizeof(float);
+    }
+
+    /// Время последнего построения (мс)
+    double getBuildTime() const { return build_time_; }
+
+private:
+    /// Значение "недостижимо" в компактной таблице
+    static constexpr std::uint16_t kUnreachable = 0xFFFF;
+
+    const Grid& grid_;                              ///< Сетка, для которой построена таблица
+    int requested_;                                 ///< Запрошенное количество ориентиров
+    unsigned threads_;                              ///< Количество потоков построения
+    bool built_;                                    ///< Таблица построена
+    double build_time_;                             ///< Время последнего построения (мс)
+
+    std::vector<std::pair<int, int>> landmarks_;    ///< Выбранные ориентиры
+    double scale_;                                  ///< Масштаб фиксированной точки uint16
+    double slack_;                                  ///< Запас на погрешность округления float
+    std::vector<std::uint16_t> compact_;            ///< Расстояния uint16 (клетка * K + ориентир)
+    std::vector<float> wide_;                       ///< Расстояния float, если uint16 не хватает
+
+    /// Выбрать ориентиры методом самой дальней точки (по октильному расстоянию)
+    void selectLandmarks();
+
+    /// Поиск Дейкстры от клетки, результат - расстояния (бесконечность для недостижимых)
+    std::vector<float> distancesFrom(int x, int y) const;
+
+    /// Оценка ALT без учета октильного расстояния
+    double landmarkBound(int cell, int target) const;
+};
+
+#endif // LANDMARK_HEURISTIC_H
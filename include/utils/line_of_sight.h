@@ -39,6 +39,58 @@ bool hasLineOfSight(const Grid& grid, const Node& from, const Node& to);
  */
 bool hasLineOfSightSupercover(const Grid& grid, const Node& from, const Node& to);
 
+/**
+ * @brief Обойти клетки отрезка без выделения памяти, с ранним выходом
+ * 
+ * Обход по ошибке Брезенхема от центра клетки (x0, y0) до центра (x1, y1).
+ * С суперпокрытием при точном попадании в угол делается диагональный шаг,
+ * и обход совпадает с обходом Amanatides-Woo для отрезка между центрами
+ * клеток (getLineCells). Без суперпокрытия в этом случае делается шаг по Y,
+ * как в isPathClear. Посетитель вызывается как visitor(x, y) и возвращает
+ * false, чтобы остановить обход.
+ * @param x0 Начальная координата X
+ * @param y0 Начальная координата Y
+ * @param x1 Конечная координата X
+ * @param y1 Конечная координата Y
+ * @param supercover Диагональный шаг при прохождении через угол клетки
+ * @param visitor Посетитель клеток
+ * @return true если обход дошел до конца, false если его остановил посетитель
+ */
+template <typename Visitor>
+inline bool traverseLine(int x0, int y0, int x1, int y1, bool supercover, Visitor&& visitor) {
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    int x = x0;
+    int y = y0;
+    int n = 1 + dx + dy;
+    const int x_inc = (x1 > x0) ? 1 : -1;
+    const int y_inc = (y1 > y0) ? 1 : -1;
+    int error = dx - dy;
+    dx *= 2;
+    dy *= 2;
+    
+    for (; n > 0; --n) {
+        if (!visitor(x, y)) {
+            return false;
+        }
+        
+        if (error > 0) {
+            x += x_inc;
+            error -= dy;
+        } else if (error < 0 || !supercover) {
+            y += y_inc;
+            error += dx;
+        } else {
+            // Отрезок проходит через угол: обе клетки сразу
+            x += x_inc;
+            y += y_inc;
+            error += dx - dy;
+            --n;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Получает все клетки, через которые проходит линия между двумя узлами
  * @param from Начальный узел
@@ -49,6 +101,10 @@ std::vector<std::pair<int, int>> getLineCells(int x0, int y0, int x1, int y1);
 
 /**
  * @brief Проверяет, пересекает ли отрезок между двумя точками какие-либо препятствия
+ * 
+ * Отрезки по осям и диагоналям проверяются за O(1) по длинам свободных
+ * отрезков сетки (Grid::getFreeRun), крутые - переходами по вертикальным
+ * отрезкам в каждом столбце, пологие - битовыми масками строк.
  * @param grid Ссылка на сетку
  * @param x0 Начальная координата X
  * @param y0 Начальная координата Y
@@ -0,0 +1,102 @@
+/**
+ * @file line_of_sight_cache.h
+ * @brief Кэш результатов проверки прямой видимости
+ *
+ * Theta* и сглаживание A*PS многократно проверяют видимость между одними и
+ * теми же парами клеток: в пределах одного поиска (родитель родителя для
+ * соседних узлов) и между повторными запросами на той же карте. Кэш хранит
+ * результат для упорядоченной пары клеток и сбрасывается при изменении
+ * версии карты.
+ */
+
+#ifndef LINE_OF_SIGHT_CACHE_H
+#define LINE_OF_SIGHT_CACHE_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class LineOfSightCache
+ * @brief Ограниченная таблица с открытой адресацией без блокировок
+ *
+ * Каждая ячейка - одно 64-битное атомарное слово: индексы двух клеток
+ * (по 24 бита), номер эпохи (15 бит) и результат проверки. Запись и чтение
+ * ячейки атомарны, поэтому кэш можно разделять между потоками без мьютекса;
+ * при промахе вытесняется одна из проверенных ячеек. Эпоха меняется, когда
+ * приходит запрос по сетке с новой версией (Grid::getVersion), и записи
+ * прежних эпох считаются пустыми. Смена версии не должна совпадать по
+ * времени с запросами по другой версии: карта меняется между поисками.
+ * Карты больше 2^24 клеток обслуживаются без кэша.
+ */
+class LineOfSightCache {
+public:
+    /**
+     * @brief Конструктор кэша
+     * @param slots Количество ячеек (степень двойки)
+     * @throw std::invalid_argument если slots не степень двойки
+     */
+    explicit LineOfSightCache(std::size_t slots = config::LOS_CACHE_SLOTS);
+
+    /**
+     * @brief Проверить, что отрезок не пересекает препятствия (с кэшированием)
+     * @param grid Ссылка на сетку
+     * @param x0 Начальная координата X
+     * @param y0 Начальная координата Y
+     * @param x1 Конечная координата X
+     * @param y1 Конечная координата Y
+     * @return Результат line_of_sight::isPathClear
+     */
+    bool isPathClear(const Grid& grid, int x0, int y0, int x1, int y1);
+
+    /**
+     * @brief Проверить прямую видимость между узлами (с кэшированием)
+     * @param grid Ссылка на сетку
+     * @param from Начальный узел
+     * @param to Конечный узел
+     * @return Результат line_of_sight::hasLineOfSight
+     */
+    bool hasLineOfSight(const Grid& grid, const Node& from, const Node& to) {
+        return isPathClear(grid, from.x, from.y, to.x, to.y);
+    }
+
+    /**
+     * @brief Очистить все ячейки
+     */
+    void clear();
+
+    /// Количество попаданий с последнего сброса статистики
+    std::uint64_t getHits() const { return hits_.load(std::memory_order_relaxed); }
+
+    /// Количество промахов с последнего сброса статистики
+    std::uint64_t getMisses() const { return misses_.load(std::memory_order_relaxed); }
+
+    /// Доля попаданий (%) с последнего сброса статистики
+    double getHitRate() const;
+
+    /**
+     * @brief Сбросить счетчики попаданий и промахов (содержимое кэша сохраняется)
+     */
+    void resetStatistics();
+
+    /// Память таблицы в байтах
+    std::size_t getSizeBytes() const { return slot_count_ * sizeof(std::atomic<std::uint64_t>); }
+
+private:
+    std::size_t slot_count_;                              ///< Количество ячеек
+    int hash_shift_;                                      ///< Сдвиг мультипликативного хеша
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots_; ///< Ячейки (0 - пустая)
+    std::atomic<std::uint64_t> version_;                  ///< Версия карты текущей эпохи
+    std::atomic<std::uint32_t> epoch_;                    ///< Текущая эпоха (1..0x7FFF)
+    std::atomic<std::uint64_t> hits_;                     ///< Счетчик попаданий
+    std::atomic<std::uint64_t> misses_;                   ///< Счетчик промахов
+
+    /// Перейти к эпохе для версии карты; возвращает текущую эпоху
+    std::uint32_t syncEpoch(std::uint64_t version);
+};
+
+#endif // LINE_OF_SIGHT_CACHE_H
@@ -0,0 +1,122 @@
+/**
+ * @file local_distance_database.h
+ * @brief База локальных расстояний (LDDB) для Block A*
+ *
+ * Для каждого шаблона препятствий блока B x B (битовая маска, бит
+ * ly * B + lx означает препятствие) хранятся кратчайшие расстояния между
+ * всеми парами клеток периметра блока при движении только внутри блока.
+ */
+
+#ifndef LOCAL_DISTANCE_DATABASE_H
+#define LOCAL_DISTANCE_DATABASE_H
+
+#include "../../config.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class LocalDistanceDatabase
+ * @brief Таблица расстояний "периметр - периметр" для всех шаблонов блока
+ *
+ * Для блоков 4x4 таблица строится полностью (2^16 шаблонов), для 8x8 -
+ * лениво, по мере встречи шаблонов на картах. База не зависит от карты,
+ * поэтому один экземпляр разделяется всеми сетками и сохраняется на диск.
+ */
+class LocalDistanceDatabase {
+public:
+    /// Значение "недостижимо" в таблице
+    static constexpr std::uint16_t kUnreachable = 0xFFFF;
+
+    /// Масштаб фиксированной точки: расстояние = значение / kScale
+    static constexpr double kScale = 1024.0;
+
+    /**
+     * @brief Конструктор базы
+     * @param block_size Сторона блока (4 или 8)
+     * @throw std::invalid_argument для других размеров
+     */
+    explicit LocalDistanceDatabase(int block_size);
+
+    /**
+     * @brief Получить общий экземпляр базы для размера блока
+     *
+     * При первом обращении база загружается из файла кэша, а если его нет -
+     * строится (для 4x4 полностью) и сохраняется.
+     * @param block_size Сторона блока (4 или 8)
+     * @return Разделяемый указатель на базу
+     */
+    static std::shared_ptr<LocalDistanceDatabase> shared(int block_size);
+
+    /**
+     * @brief Получить имя файла кэша для размера блока
+     * @param block_size Сторона блока
+     * @return Путь к файлу
+     */
+    static std::string cachePath(int block_size);
+
+    /**
+     * @brief Построить таблицы для всех шаблонов (только для блоков 4x4)
+     */
+    void buildAll();
+
+    /**
+     * @brief Получить таблицу расстояний для шаблона
+     * @param pattern Битовая маска препятствий блока
+     * @return Указатель на матрицу P x P (строка - откуда, столбец - куда)
+     */
+    const std::uint16_t* distances(std::uint64_t pattern);
+
+    /**
+     * @brief Сохранить базу в двоичный файл
+     * @param filename Имя файла
+     * @return true при успехе
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Загрузить базу из двоичного файла
+     * @param filename Имя файла
+     * @return true если файл существует, совместим по формату и построен при
+     *         текущих ALLOW_DIAGONAL_MOVEMENT, DIAGONAL_COST и правиле срезания углов
+     */
+    bool load(const std::string& filename);
+
+    /// Сторона блока
+    int getBlockSize() const { return block_size_; }
+
+    /// Количество клеток периметра
+    int getPerimeterSize() const { return static_cast<int>(perimeter_.size()); }
+
+    /// Индекс клетки периметра по локальным координатам (-1 для внутренних)
+    int perimeterIndex(int lx, int ly) const { return perimeter_index_[ly * block_size_ + lx]; }
+
+    /// Локальные координаты клетки периметра
+    std::pair<int, int> perimeterCell(int index) const { return perimeter_[index]; }
+
+    /// Количество шаблонов, для которых таблица уже вычислена
+    std::size_t getPatternCount() const;
+
+    /// Перевести значение таблицы в стоимость пути
+    static double toCost(std::uint16_t value) { return value / kScale; }
+
+private:
+    int block_size_;                                        ///< Сторона блока
+    std::vector<std::pair<int, int>> perimeter_;            ///< Клетки периметра
+    std::vector<int> perimeter_index_;                      ///< Клетка -> индекс периметра
+    std::vector<std::uint16_t> dense_;                      ///< Полная таблица (4x4)
+    std::vector<char> dense_ready_;                         ///< Вычислен ли шаблон (4x4)
+    std::unordered_map<std::uint64_t, std::vector<std::uint16_t>> sparse_; ///< Ленивые таблицы (8x8)
+
+    /// Вычислить матрицу расстояний для шаблона
+    void computeTable(std::uint64_t pattern, std::uint16_t* out) const;
+
+    /// Размер матрицы одного шаблона
+    std::size_t tableSize() const { return perimeter_.size() * perimeter_.size(); }
+};
+
+#endif // LOCAL_DISTANCE_DATABASE_H
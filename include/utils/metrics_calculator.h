@@ -14,6 +14,7 @@
 
 #include <vector>
 #include <cmath>
+#include <cstddef>
 
 /**
  * @struct PathMetrics
@@ -37,6 +38,12 @@ struct PathMetrics {
     double avg_obstacle_distance;       ///< Среднее расстояние до препятствий
     double max_curvature;               ///< Максимальная кривизна пути
     
+    // Метрики памяти
+    std::size_t peak_memory_bytes = 0;  ///< Пиковая память узлов поиска (если алгоритм ее считает)
+    
+    // Метрики кэширования
+    double los_cache_hit_rate = 0.0;    ///< Доля попаданий в кэш прямой видимости (%), если он подключен
+    
     // Статистические метрики
     double execution_time;              ///< Время выполнения (мс)
     bool success;                       ///< Успешность поиска
@@ -83,6 +90,9 @@ double calculateSmoothness(const std::vector<Node*>& path);
 
 /**
  * @brief Вычислить минимальное и среднее расстояние до препятствий
+ * 
+ * Учитываются все клетки, через которые проходят отрезки между узлами
+ * пути (суперпокрытие), а не только сами узлы.
  * @param path Вектор узлов пути
  * @param grid Сетка
  * @return Пара: минимальное расстояние, среднее расстояние
@@ -0,0 +1,119 @@
+/**
+ * @file path_smoother.h
+ * @brief Сглаживание пути: срезание углов по прямой видимости и натягивание
+ *
+ * Сглаживание выполняется в два этапа. Сначала из каждого опорного узла
+ * выбирается дальний видимый узел пути (жадно или экспоненциальным и
+ * двоичным поиском), затем опорные узлы по желанию сдвигаются вдоль
+ * коридора исходного пути, пока натянутая через них ломаная укорачивается.
+ * Проверки видимости могут дополнительно требовать зазор до препятствий.
+ */
+
+#ifndef PATH_SMOOTHER_H
+#define PATH_SMOOTHER_H
+
+#include "grid/grid.h"
+#include "utils/line_of_sight_cache.h"
+#include "../../config.h"
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum ShortcutMode
+ * @brief Способ поиска дальнего видимого узла
+ */
+enum class ShortcutMode {
+    Greedy,                             ///< Перебор подряд до первого невидимого узла: O(n) проверок на опорный узел
+    Exponential                         ///< Подряд до PATH_SMOOTHER_LINEAR_PROBES, затем удвоение шага и двоичный поиск: O(log n) проверок
+};
+
+/**
+ * @class PathSmoother
+ * @brief Переиспользуемый конвейер сглаживания пути по сетке
+ *
+ * Экспоненциальный поиск никогда не выбирает узел ближе, чем жадный:
+ * все узлы до первого невидимого видны, поэтому двоичный поиск не
+ * опускается ниже него. На коротких срезах (лабиринты) жадный режим и
+ * так делает около одной проверки на клетку пути, поэтому первые узлы
+ * проверяются подряд, а выигрыш экспоненциального режима - в длинных
+ * срезах, где жадный перебор проверяет все промежуточные узлы. Натягивание сдвигает каждый опорный узел по
+ * клеткам исходного пути между соседними опорными узлами к положению
+ * с наименьшей суммой длин двух отрезков; узел, между соседями которого
+ * есть прямая видимость, удаляется.
+ */
+class PathSmoother {
+public:
+    /**
+     * @brief Конструктор сглаживателя
+     * @param grid Сетка, по которой проверяется видимость
+     */
+    explicit PathSmoother(const Grid& grid);
+
+    /**
+     * @brief Сгладить путь
+     * @param path Путь из соседних клеток (как его возвращает поиск по сетке)
+     * @return Опорные узлы сглаженного пути; первый и последний совпадают с исходными
+     */
+    std::vector<Node*> smooth(const std::vector<Node*>& path);
+
+    /// Выбрать способ поиска дальнего видимого узла
+    void setShortcutMode(ShortcutMode mode) { mode_ = mode; }
+
+    /// Включить или выключить натягивание по коридору исходного пути
+    void setStringPulling(bool enabled) { string_pulling_ = enabled; }
+
+    /**
+     * @brief Задать минимальный зазор до препятствий для срезаемых отрезков
+     * @param cells Зазор в клетках по слою расстояний до препятствий (0 - только прямая видимость)
+     */
+    void setMinClearance(int cells) { min_clearance_ = cells; }
+
+    /**
+     * @brief Подключить кэш прямой видимости
+     * @param cache Кэш (nullptr - без кэша); не принадлежит сглаживателю
+     */
+    void setLineOfSightCache(LineOfSightCache* cache) { los_cache_ = cache; }
+
+    /// Количество проверок видимости в последнем сглаживании
+    long long getVisibilityChecks() const { return visibility_checks_; }
+
+    /// Время последнего сглаживания (мс)
+    double getSmoothTime() const { return smooth_time_; }
+
+    /**
+     * @brief Сбросить статистику
+     */
+    void resetStatistics();
+
+private:
+    const Grid& grid_;                              ///< Сетка для проверки видимости
+    ShortcutMode mode_;                             ///< Способ поиска дальнего видимого узла
+    bool string_pulling_;                           ///< Натягивание включено
+    int min_clearance_;                             ///< Минимальный зазор срезаемых отрезков
+    LineOfSightCache* los_cache_;                   ///< Подключенный кэш видимости (nullptr - без кэша)
+    long long visibility_checks_;                   ///< Проверок видимости в последнем сглаживании
+    double smooth_time_;                            ///< Время последнего сглаживания (мс)
+
+    std::vector<int> clearance_;                    ///< Слой зазоров до препятствий в клетках
+    std::uint64_t clearance_version_;               ///< Версия карты, для которой посчитан слой (0 - не посчитан)
+
+    /// Виден ли узел to из from (с учетом минимального зазора)
+    bool isVisible(const Node& from, const Node& to);
+
+    /// Пересчитать слой зазоров, если карта изменилась
+    void updateClearance();
+
+    /// Индекс дальнего видимого узла пути из узла anchor
+    std::size_t farthestVisible(const std::vector<Node*>& path, std::size_t anchor);
+
+    /**
+     * @brief Натянуть опорные узлы по коридору исходного пути
+     * @param path Исходный путь
+     * @param waypoints Индексы опорных узлов в исходном пути (изменяются)
+     */
+    void pullString(const std::vector<Node*>& path, std::vector<std::size_t>& waypoints);
+};
+
+#endif // PATH_SMOOTHER_H
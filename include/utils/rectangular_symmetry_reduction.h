@@ -0,0 +1,122 @@
+/**
+ * @file rectangular_symmetry_reduction.h
+ * @brief Устранение симметрий разбиением карты на пустые прямоугольники (RSR)
+ *
+ * Свободное пространство разбивается на максимальные пустые прямоугольники.
+ * Внутренние клетки прямоугольника не раскрываются: любой оптимальный путь
+ * через него заменяется путем той же длины, который входит и выходит через
+ * периметр, а пересечение прямоугольника выполняется одним макроребром
+ * между клетками периметра с октильной стоимостью.
+ */
+
+#ifndef RECTANGULAR_SYMMETRY_REDUCTION_H
+#define RECTANGULAR_SYMMETRY_REDUCTION_H
+
+#include "grid/grid.h"
+#include "../../config.h"
+
+#include <vector>
+
+/**
+ * @class RectangularSymmetryReduction
+ * @brief Разбиение на прямоугольники и генератор преемников для A*
+ *
+ * Разбиение строится жадно по строкам и хранится как номер прямоугольника
+ * для каждой клетки. При изменении клетки (препятствие или резерв, например
+ * из слушателя ObstacleInflator) вызывается update(), который удаляет
+ * прямоугольники вокруг нее и заново покрывает только освободившуюся
+ * область. Прямоугольники со стороной меньше RSR_MIN_RECTANGLE_SIDE не
+ * сокращаются: на них макроребра дороже сэкономленных раскрытий. Генератор преемников (asSuccessorFunction) подключается к A*
+ * без изменения кода поиска; внутренние старт и цель обрабатываются
+ * отдельно, поэтому длина пути остается оптимальной.
+ */
+class RectangularSymmetryReduction {
+public:
+    /**
+     * @brief Конструктор разбиения
+     * @param grid Сетка, для которой строится разбиение
+     */
+    explicit RectangularSymmetryReduction(const Grid& grid);
+
+    /**
+     * @brief Построить разбиение всей карты
+     */
+    void build();
+
+    /**
+     * @brief Локально перестроить разбиение после изменения клетки
+     * @param x Координата X измененной клетки
+     * @param y Координата Y измененной клетки
+     * @throw std::runtime_error если разбиение еще не построено
+     */
+    void update(int x, int y);
+
+    /**
+     * @brief Является ли клетка внутренней клеткой прямоугольника (не на периметре)
+     * @param x Координата X
+     * @param y Координата Y
+     * @return true если клетка не раскрывается поиском
+     */
+    bool isInterior(int x, int y) const;
+
+    /**
+     * @brief Заполнить преемников узла: соседей вне внутренних областей и макроребра
+     * @param from Раскрываемый узел
+     * @param target Цель поиска (внутренняя цель остается достижимой)
+     * @param successors Выходной список преемников
+     */
+    void getSuccessors(const Node& from, const Node& target, std::vector<Successor>& successors) const;
+
+    /**
+     * @brief Получить генератор преемников для подключения к алгоритму
+     * @return Генератор; ссылается на этот объект
+     */
+    SuccessorFunction asSuccessorFunction() const;
+
+    /// Количество прямоугольников
+    int getRectangleCount() const { return rectangle_count_; }
+
+    /// Количество внутренних (не раскрываемых) клеток
+    int getInteriorCellCount() const;
+
+    /// Время последнего полного построения (мс)
+    double getBuildTime() const { return build_time_; }
+
+private:
+    /**
+     * @brief Пустой прямоугольник разбиения (границы включительно)
+     */
+    struct Rectangle {
+        int min_x;                      ///< Левая граница
+        int min_y;                      ///< Верхняя граница
+        int max_x;                      ///< Правая граница
+        int max_y;                      ///< Нижняя граница
+    };
+
+    const Grid& grid_;                              ///< Сетка, для которой построено разбиение
+    double build_time_;                             ///< Время последнего построения (мс)
+    int rectangle_count_;                           ///< Количество живых прямоугольников
+    std::vector<Rectangle> rectangles_;             ///< Прямоугольники (удаленные - в free_ids_)
+    std::vector<int> free_ids_;                     ///< Номера удаленных прямоугольников для повторного использования
+    std::vector<int> cell_rectangle_;               ///< Клетка -> прямоугольник (-1 для препятствий)
+
+    /// Сокращается ли прямоугольник: обе стороны не короче RSR_MIN_RECTANGLE_SIDE
+    static bool hasInterior(const Rectangle& rectangle) {
+        return rectangle.max_x - rectangle.min_x + 1 >= config::RSR_MIN_RECTANGLE_SIDE &&
+               rectangle.max_y - rectangle.min_y + 1 >= config::RSR_MIN_RECTANGLE_SIDE;
+    }
+
+    /// Свободна ли клетка и не покрыта ли она еще прямоугольником
+    bool isUncovered(int x, int y) const;
+
+    /// Покрыть непокрытые свободные клетки области жадными прямоугольниками
+    void cover(int min_x, int min_y, int max_x, int max_y);
+
+    /// Удалить прямоугольник и освободить его клетки
+    void removeRectangle(int id);
+
+    /// Стоимость октильного маршрута между клетками
+    static double octileCost(int x0, int y0, int x1, int y1);
+};
+
+#endif // RECTANGULAR_SYMMETRY_REDUCTION_H
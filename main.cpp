@@ -7,12 +7,34 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <random>
+#include <cmath>
 
 #include "config.h"
 #include "scenarios/test_scenarios.h"
 #include "algorithms/astar.h"
 #include "algorithms/astar_ps.h"
 #include "algorithms/thetastar.h"
+#include "algorithms/fringe_search.h"
+#include "algorithms/sma_star.h"
+#include "algorithms/focal_search.h"
+#include "algorithms/hpa_star.h"
+#include "algorithms/quadtree_search.h"
+#include "algorithms/block_astar.h"
+#include "algorithms/subgoal_graph.h"
+#include "algorithms/visibility_graph.h"
+#include "algorithms/compressed_path_database.h"
+#include "algorithms/goal_field_search.h"
+#include "algorithms/steiner_tree_router.h"
+#include "algorithms/pipe_router.h"
+#include "utils/landmark_heuristic.h"
+#include "utils/goal_bounding.h"
+#include "utils/dead_end_pruning.h"
+#include "utils/rectangular_symmetry_reduction.h"
+#include "utils/line_of_sight.h"
+#include "utils/bit_wavefront.h"
+#include "utils/line_of_sight_cache.h"
+#include "utils/path_smoother.h"
 #include "utils/metrics_calculator.h"
 #include "utils/csv_writer.h"
 
@@ -67,18 +89,147 @@ std::vector<AlgorithmResult> runScenarioTests(const TestScenario& scenario, CSVW
     
     // Создаем копии сетки для каждого алгоритма
     Grid grid_astar = scenario.grid;
-    Grid grid_astar_ps = scenario.grid;
     Grid grid_thetastar = scenario.grid;
+    Grid grid_fringe = scenario.grid;
+    Grid grid_sma = scenario.grid;
+    Grid grid_focal = scenario.grid;
+    Grid grid_hpa = scenario.grid;
+    Grid grid_block = scenario.grid;
+    Grid grid_subgoal = scenario.grid;
+    Grid grid_visibility = scenario.grid;
+    Grid grid_cpd = scenario.grid;
+    Grid grid_astar_alt = scenario.grid;
+    Grid grid_thetastar_alt = scenario.grid;
+    Grid grid_astar_gb = scenario.grid;
+    Grid grid_astar_de = scenario.grid;
+    Grid grid_thetastar_de = scenario.grid;
+    Grid grid_astar_rsr = scenario.grid;
+    Grid grid_quadtree = scenario.grid;
     
     // Инфляция препятствий
     grid_astar.inflateObstacles(config::AGENT_RADIUS);
-    grid_astar_ps.inflateObstacles(config::AGENT_RADIUS);
     grid_thetastar.inflateObstacles(config::AGENT_RADIUS);
+    grid_fringe.inflateObstacles(config::AGENT_RADIUS);
+    grid_sma.inflateObstacles(config::AGENT_RADIUS);
+    grid_focal.inflateObstacles(config::AGENT_RADIUS);
+    grid_hpa.inflateObstacles(config::AGENT_RADIUS);
+    grid_block.inflateObstacles(config::AGENT_RADIUS);
+    grid_subgoal.inflateObstacles(config::AGENT_RADIUS);
+    grid_visibility.inflateObstacles(config::AGENT_RADIUS);
+    grid_cpd.inflateObstacles(config::AGENT_RADIUS);
+    grid_astar_alt.inflateObstacles(config::AGENT_RADIUS);
+    grid_thetastar_alt.inflateObstacles(config::AGENT_RADIUS);
+    grid_astar_gb.inflateObstacles(config::AGENT_RADIUS);
+    grid_astar_de.inflateObstacles(config::AGENT_RADIUS);
+    grid_thetastar_de.inflateObstacles(config::AGENT_RADIUS);
+    grid_astar_rsr.inflateObstacles(config::AGENT_RADIUS);
+    grid_quadtree.inflateObstacles(config::AGENT_RADIUS);
+    
+    // A*PS работает на копии карты Theta*: одна версия сетки позволяет делить кэш видимости
+    Grid grid_astar_ps = grid_thetastar;
+    LineOfSightCache los_cache;
     
     // Создаем алгоритмы
     AStar astar(grid_astar);
     AStarPS astar_ps(grid_astar_ps);
     ThetaStar thetastar(grid_thetastar);
+    astar_ps.setLineOfSightCache(&los_cache);
+    thetastar.setLineOfSightCache(&los_cache);
+    FringeSearch fringe(grid_fringe);
+    SMAStar sma_star(grid_sma, config::SEARCH_MEMORY_BUDGET);
+    FocalSearch focal(grid_focal, FocalKey::GoalDistance, config::FOCAL_EPSILON);
+    HPAStar hpa(grid_hpa);
+    BlockAStar block_astar(grid_block);
+    SubgoalGraph subgoal_graph(grid_subgoal);
+    VisibilityGraph visibility(grid_visibility);
+    CompressedPathDatabase cpd(grid_cpd);
+    AStar astar_alt(grid_astar_alt);
+    ThetaStar thetastar_alt(grid_thetastar_alt);
+    AStar astar_gb(grid_astar_gb);
+    AStar astar_de(grid_astar_de);
+    ThetaStar thetastar_de(grid_thetastar_de);
+    AStar astar_rsr(grid_astar_rsr);
+    QuadtreeSearch quadtree(grid_quadtree);
+    
+    // Абстрактный граф HPA* строится один раз до замеров запросов
+    hpa.build();
+    std::cout << "HPAStar build: " << hpa.getBuildTime() << "ms, abstract nodes: "
+              << hpa.getAbstractNodeCount() << std::endl;
+    
+    subgoal_graph.build();
+    std::cout << "SubgoalGraph build: " << subgoal_graph.getBuildTime() << "ms, subgoals: "
+              << subgoal_graph.getSubgoalCount() << ", edges: "
+              << subgoal_graph.getEdgeCount() << std::endl;
+    
+    // Граф видимости растет квадратично, на больших картах он пропускается
+    bool visibility_ready = true;
+    try {
+        visibility.build();
+        std::cout << "VisibilityGraph build: " << visibility.getBuildTime() << "ms, vertices: "
+                  << visibility.getVertexCount() << ", edges: "
+                  << visibility.getEdgeCount() << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "VisibilityGraph skipped: " << e.what() << std::endl;
+        visibility_ready = false;
+    }
+    
+    // База первых ходов кэшируется на диске и отображается в память
+    bool cpd_ready = true;
+    try {
+        cpd.buildOrOpen("cpd_" + scenario.name + ".bin");
+        std::cout << "CompressedPathDatabase " << (cpd.getBuildTime() > 0.0 ? "build: " : "opened: ")
+                  << cpd.getBuildTime() << "ms, size: " << cpd.getSizeBytes() << " bytes, runs: "
+                  << cpd.getRunCount() << (cpd.isMapped() ? " (mmap)" : "") << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "CompressedPathDatabase skipped: " << e.what() << std::endl;
+        cpd_ready = false;
+    }
+    
+    // Таблицы ориентиров строятся один раз и подключаются к A* и Theta* как эвристика
+    LandmarkHeuristic landmarks(grid_astar_alt);
+    landmarks.build();
+    astar_alt.setHeuristic(landmarks.asFunction());
+    thetastar_alt.setHeuristic(landmarks.asFunction(true));
+    std::cout << "LandmarkHeuristic build: " << landmarks.getBuildTime() << "ms, landmarks: "
+              << landmarks.getLandmarkCount() << ", size: " << landmarks.getSizeBytes() << " bytes ("
+              << (landmarks.isCompact() ? "uint16" : "float") << ")" << std::endl;
+    
+    // Прямоугольники целей кэшируются на диске, как и база первых ходов
+    GoalBounding bounding(grid_astar_gb);
+    bool bounding_ready = true;
+    try {
+        bounding.buildOrLoad("gb_" + scenario.name + ".bin");
+        astar_gb.setNeighborFilter(bounding.asFilter());
+        std::cout << "GoalBounding " << (bounding.getBuildTime() > 0.0 ? "build: " : "loaded: ")
+                  << bounding.getBuildTime() << "ms, size: " << bounding.getSizeBytes() << " bytes" << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "GoalBounding skipped: " << e.what() << std::endl;
+        bounding_ready = false;
+    }
+    
+    // Тупики и болота размечаются один раз: запрос сценария фиксирован
+    DeadEndPruning pruning(grid_astar_de);
+    pruning.build();
+    int pruned_cells = pruning.apply(grid_astar_de, scenario.start_x, scenario.start_y,
+                                     scenario.end_x, scenario.end_y);
+    pruning.apply(grid_thetastar_de, scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y,
+                  false);
+    std::cout << "DeadEndPruning build: " << pruning.getBuildTime() << "ms, blocks: "
+              << pruning.getBlockCount() << ", swamps: " << pruning.getSwampCount() << " ("
+              << pruning.getSwampCellCount() << " cells), pruned for query: " << pruned_cells << std::endl;
+    
+    // Пустые прямоугольники: A* раскрывает только их периметры
+    RectangularSymmetryReduction rectangles(grid_astar_rsr);
+    rectangles.build();
+    astar_rsr.setSuccessorFunction(rectangles.asSuccessorFunction());
+    std::cout << "RSR build: " << rectangles.getBuildTime() << "ms, rectangles: "
+              << rectangles.getRectangleCount() << ", interior cells: "
+              << rectangles.getInteriorCellCount() << std::endl;
+    
+    quadtree.build();
+    std::cout << "Quadtree build: " << quadtree.getBuildTime() << "ms, free leaves: " << quadtree.getLeafCount()
+              << ", memory: " << quadtree.getMemoryBytes() << " bytes (grid nodes: "
+              << grid_quadtree.getWidth() * grid_quadtree.getHeight() * sizeof(Node) << " bytes)" << std::endl;
     
     // Запускаем тесты
     std::vector<AlgorithmResult> results;
@@ -89,11 +240,159 @@ std::vector<AlgorithmResult> runScenarioTests(const TestScenario& scenario, CSVW
             astar.resetStatistics();
             astar_ps.resetStatistics();
             thetastar.resetStatistics();
+            fringe.resetStatistics();
+            sma_star.resetStatistics();
+            focal.resetStatistics();
+            hpa.resetStatistics();
+            block_astar.resetStatistics();
+            subgoal_graph.resetStatistics();
+            visibility.resetStatistics();
+            cpd.resetStatistics();
+            astar_alt.resetStatistics();
+            thetastar_alt.resetStatistics();
+            astar_gb.resetStatistics();
+            astar_de.resetStatistics();
+            thetastar_de.resetStatistics();
+            astar_rsr.resetStatistics();
+            quadtree.resetStatistics();
         }
         
         results.push_back(runTest(astar, scenario, "AStar"));
+        
+        los_cache.resetStatistics();
         results.push_back(runTest(astar_ps, scenario, "AStarPS"));
+        results.back().metrics.los_cache_hit_rate = los_cache.getHitRate();
+        double astar_ps_hit_rate = los_cache.getHitRate();
+        
+        los_cache.resetStatistics();
         results.push_back(runTest(thetastar, scenario, "ThetaStar"));
+        results.back().metrics.los_cache_hit_rate = los_cache.getHitRate();
+        if (run == 0) {
+            std::cout << "  LOS cache hit rate: AStarPS " << astar_ps_hit_rate << "%, ThetaStar "
+                      << los_cache.getHitRate() << "% (" << los_cache.getSizeBytes() << " bytes)" << std::endl;
+        }
+        
+        results.push_back(runTest(fringe, scenario, "FringeSearch"));
+        
+        results.push_back(runTest(sma_star, scenario, "SMAStar"));
+        results.back().metrics.peak_memory_bytes = sma_star.getPeakMemoryUsed();
+        if (run == 0 && results.back().metrics.success) {
+            std::cout << "  SMAStar memory: " << sma_star.getPeakMemoryUsed() << " / "
+                      << sma_star.getMemoryBudget() << " bytes, expanded: "
+                      << sma_star.getNodesExpanded() << ", forgotten: "
+                      << sma_star.getNodesForgotten() << ", bound: "
+                      << sma_star.getSuboptimalityBound() << std::endl;
+        }
+        
+        results.push_back(runTest(focal, scenario, "FocalSearch"));
+        if (run == 0 && results.back().metrics.success) {
+            std::cout << "  FocalSearch bound: " << focal.getSuboptimalityBound()
+                      << " (epsilon " << config::FOCAL_EPSILON << ")" << std::endl;
+        }
+        
+        results.push_back(runTest(hpa, scenario, "HPAStar"));
+        
+        results.push_back(runTest(block_astar, scenario, "BlockAStar"));
+        if (run == 0) {
+            std::cout << "  BlockAStar blocks expanded: " << block_astar.getNodesExpanded()
+                      << ", LDDB patterns: " << block_astar.getDatabase()->getPatternCount()
+                      << " (" << config::BLOCK_ASTAR_SIZE << "x" << config::BLOCK_ASTAR_SIZE
+                      << ")" << std::endl;
+        }
+        
+        results.push_back(runTest(subgoal_graph, scenario, "SubgoalGraph"));
+        
+        if (visibility_ready) {
+            results.push_back(runTest(visibility, scenario, "VisibilityGraph"));
+            if (run == 0) {
+                // Сравнение с any-angle алгоритмами, считающими видимость во время поиска
+                std::cout << "  VisibilityGraph vs any-angle:";
+                for (const auto& result : results) {
+                    if (result.metrics.success &&
+                        (result.algorithm_name == "VisibilityGraph" || result.algorithm_name == "ThetaStar" ||
+                         result.algorithm_name == "AStarPS")) {
+                        std::cout << " " << result.algorithm_name << " "
+                                  << result.metrics.path_length << " / "
+                                  << result.metrics.execution_time << "ms;";
+                    }
+                }
+                std::cout << std::endl;
+            }
+        }
+        
+        if (cpd_ready) {
+            results.push_back(runTest(cpd, scenario, "CompressedPathDatabase"));
+        }
+        
+        results.push_back(runTest(astar_alt, scenario, "AStarALT"));
+        results.push_back(runTest(thetastar_alt, scenario, "ThetaStarALT"));
+        if (run == 0) {
+            // Сокращение числа раскрытых узлов относительно евклидовой эвристики
+            auto reduction = [](int plain, int alt) {
+                return plain > 0 ? 100.0 * (plain - alt) / plain : 0.0;
+            };
+            std::cout << "  ALT expansions: AStar " << astar.getNodesExpanded() << " -> "
+                      << astar_alt.getNodesExpanded() << " ("
+                      << reduction(astar.getNodesExpanded(), astar_alt.getNodesExpanded())
+                      << "% reduction), ThetaStar " << thetastar.getNodesExpanded() << " -> "
+                      << thetastar_alt.getNodesExpanded() << " ("
+                      << reduction(thetastar.getNodesExpanded(), thetastar_alt.getNodesExpanded())
+                      << "% reduction)" << std::endl;
+            
+            // Та же эвристика через общий хук остальных алгоритмов с эвристикой
+            FringeSearch fringe_alt(grid_astar_alt);
+            SMAStar sma_star_alt(grid_astar_alt, config::SEARCH_MEMORY_BUDGET);
+            FocalSearch focal_alt(grid_astar_alt, FocalKey::GoalDistance, config::FOCAL_EPSILON);
+            BlockAStar block_astar_alt(grid_astar_alt);
+            fringe_alt.setHeuristic(landmarks.asFunction());
+            sma_star_alt.setHeuristic(landmarks.asFunction());
+            focal_alt.setHeuristic(landmarks.asFunction());
+            block_astar_alt.setHeuristic(landmarks.asFunction());
+            
+            auto altExpansions = [&](auto& engine, int plain, const char* name) {
+                try {
+                    engine.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+                    std::cout << " " << name << " " << plain << " -> " << engine.getNodesExpanded()
+                              << " (" << reduction(plain, engine.getNodesExpanded()) << "% reduction);";
+                } catch (const std::exception& e) {
+                    std::cout << " " << name << " failed: " << e.what() << ";";
+                }
+            };
+            std::cout << "  ALT expansions:";
+            altExpansions(fringe_alt, fringe.getNodesExpanded(), "FringeSearch");
+            altExpansions(sma_star_alt, sma_star.getNodesExpanded(), "SMAStar");
+            altExpansions(focal_alt, focal.getNodesExpanded(), "FocalSearch");
+            altExpansions(block_astar_alt, block_astar.getNodesExpanded(), "BlockAStar");
+            std::cout << std::endl;
+        }
+        
+        if (bounding_ready) {
+            results.push_back(runTest(astar_gb, scenario, "AStarGB"));
+            if (run == 0) {
+                std::cout << "  GoalBounding expansions: AStar " << astar.getNodesExpanded() << " -> "
+                          << astar_gb.getNodesExpanded() << std::endl;
+            }
+        }
+        
+        results.push_back(runTest(astar_de, scenario, "AStarDE"));
+        results.push_back(runTest(thetastar_de, scenario, "ThetaStarDE"));
+        if (run == 0) {
+            std::cout << "  DeadEndPruning expansions: AStar " << astar.getNodesExpanded() << " -> "
+                      << astar_de.getNodesExpanded() << ", ThetaStar " << thetastar.getNodesExpanded()
+                      << " -> " << thetastar_de.getNodesExpanded() << std::endl;
+        }
+        
+        results.push_back(runTest(astar_rsr, scenario, "AStarRSR"));
+        if (run == 0) {
+            std::cout << "  RSR expansions: AStar " << astar.getNodesExpanded() << " -> "
+                      << astar_rsr.getNodesExpanded() << std::endl;
+        }
+        
+        results.push_back(runTest(quadtree, scenario, "QuadtreeSearch"));
+        if (run == 0) {
+            std::cout << "  Quadtree expansions: AStar " << astar.getNodesExpanded() << " -> "
+                      << quadtree.getNodesExpanded() << std::endl;
+        }
     }
     
     // Сохраняем результаты
@@ -102,6 +401,556 @@ std::vector<AlgorithmResult> runScenarioTests(const TestScenario& scenario, CSVW
     return results;  // ВОЗВРАЩАЕМ РЕЗУЛЬТАТЫ
 }
 
+/**
+ * @brief Сравнить число раскрытых узлов A* и Theta* без отсечения и с отсечением тупиков и болот
+ * @param scenario Сценарий (карта и запрос)
+ */
+void runPruningReport(const TestScenario& scenario) {
+    Grid grid_plain = scenario.grid;
+    Grid grid_pruned = scenario.grid;
+    Grid grid_dead_ends = scenario.grid;
+    grid_plain.inflateObstacles(config::AGENT_RADIUS);
+    grid_pruned.inflateObstacles(config::AGENT_RADIUS);
+    grid_dead_ends.inflateObstacles(config::AGENT_RADIUS);
+    
+    DeadEndPruning pruning(grid_plain);
+    pruning.build();
+    int pruned_cells = pruning.apply(grid_pruned, scenario.start_x, scenario.start_y,
+                                     scenario.end_x, scenario.end_y);
+    pruning.apply(grid_dead_ends, scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y, false);
+    
+    AStar astar(grid_plain);
+    AStar astar_pruned(grid_pruned);
+    ThetaStar thetastar(grid_plain);
+    ThetaStar thetastar_pruned(grid_dead_ends);
+    
+    std::cout << "\n=== Dead-end pruning on " << scenario.name << " ===" << std::endl;
+    std::cout << "Build: " << pruning.getBuildTime() << "ms, blocks: " << pruning.getBlockCount()
+              << ", swamps: " << pruning.getSwampCount() << ", pruned for query: " << pruned_cells << std::endl;
+    
+    auto astar_plain_result = runTest(astar, scenario, "AStar");
+    auto astar_pruned_result = runTest(astar_pruned, scenario, "AStarDE");
+    auto theta_plain_result = runTest(thetastar, scenario, "ThetaStar");
+    auto theta_pruned_result = runTest(thetastar_pruned, scenario, "ThetaStarDE");
+    
+    std::cout << "  Expansions: AStar " << astar_plain_result.metrics.nodes_expanded << " -> "
+              << astar_pruned_result.metrics.nodes_expanded << ", ThetaStar "
+              << theta_plain_result.metrics.nodes_expanded << " -> "
+              << theta_pruned_result.metrics.nodes_expanded << std::endl;
+    std::cout << "  Path length: AStar " << astar_plain_result.metrics.path_length << " -> "
+              << astar_pruned_result.metrics.path_length << ", ThetaStar "
+              << theta_plain_result.metrics.path_length << " -> "
+              << theta_pruned_result.metrics.path_length << std::endl;
+    // Отсечение не трогает клетки оптимальных путей: длина A* сохраняется
+    if (std::abs(astar_pruned_result.metrics.path_length - astar_plain_result.metrics.path_length) > 1e-6) {
+        std::cout << "  Mismatch: pruning changed the A* path length" << std::endl;
+    }
+}
+
+/**
+ * @brief Микробенчмарк обхода клеток отрезка: вектор getLineCells против посетителя
+ * 
+ * На одних и тех же случайных отрезках сравниваются проверка суперпокрытия
+ * через полный вектор клеток, обход traverseLine с ранним выходом и
+ * hasLineOfSightSupercover (маски строк и длины свободных отрезков).
+ * @param scenario Сценарий (карта)
+ */
+void runLineOfSightBenchmark(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    grid.refreshObstacleCounts();
+    grid.refreshFreeRuns();
+    
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    std::vector<std::pair<Node, Node>> segments;
+    segments.reserve(config::LOS_BENCHMARK_QUERIES);
+    for (int i = 0; i < config::LOS_BENCHMARK_QUERIES; ++i) {
+        segments.emplace_back(Node(random_x(rng), random_y(rng), true), Node(random_x(rng), random_y(rng), true));
+    }
+    
+    auto measure = [&](const auto& check, int& visible) {
+        visible = 0;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        for (const auto& segment : segments) {
+            visible += check(segment.first, segment.second) ? 1 : 0;
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end_time - start_time).count() / segments.size();
+    };
+    
+    int visible_vector = 0;
+    int visible_visitor = 0;
+    int visible_spans = 0;
+    double vector_ns = measure([&](const Node& from, const Node& to) {
+        for (const auto& cell : line_of_sight::getLineCells(from.x, from.y, to.x, to.y)) {
+            if (grid.isObstacle(cell.first, cell.second)) {
+                return false;
+            }
+        }
+        return true;
+    }, visible_vector);
+    double visitor_ns = measure([&](const Node& from, const Node& to) {
+        return line_of_sight::traverseLine(from.x, from.y, to.x, to.y, true,
+                                           [&](int x, int y) { return !grid.isObstacle(x, y); });
+    }, visible_visitor);
+    double spans_ns = measure([&](const Node& from, const Node& to) {
+        return line_of_sight::hasLineOfSightSupercover(grid, from, to);
+    }, visible_spans);
+    
+    std::cout << "\n=== Supercover traversal on " << scenario.name << " (" << segments.size()
+              << " segments) ===" << std::endl;
+    std::cout << "  getLineCells vector: " << vector_ns << " ns/query, visitor: " << visitor_ns
+              << " ns/query, hasLineOfSightSupercover: " << spans_ns << " ns/query" << std::endl;
+    if (visible_vector != visible_visitor || visible_vector != visible_spans) {
+        std::cout << "  Mismatch: visible " << visible_vector << " / " << visible_visitor << " / "
+                  << visible_spans << std::endl;
+    }
+}
+
+/**
+ * @brief Сравнить битовую заливку с разметкой компонент сетки
+ *
+ * Заливка от старта сценария должна достичь ровно тех клеток, что
+ * Grid::isReachable относит к компоненте старта.
+ * @param scenario Сценарий (карта и старт)
+ */
+void runWavefrontBenchmark(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    
+    auto elapsed = [](auto start_time) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    };
+    
+    // Первая проверка строит разметку компонент, остальные - поиск в ней
+    long long component_cells = 0;
+    auto label_start = std::chrono::high_resolution_clock::now();
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            component_cells += grid.isReachable(scenario.start_x, scenario.start_y, x, y) ? 1 : 0;
+        }
+    }
+    double label_time = elapsed(label_start);
+    
+    BitWavefront wavefront(grid);
+    long long flooded_cells = wavefront.flood(scenario.start_x, scenario.start_y);
+    double flood_time = wavefront.getLastTime();
+    long long flood_rows = wavefront.getIterations();
+    int max_distance = wavefront.computeDistances(scenario.start_x, scenario.start_y);
+    
+    std::cout << "\n=== Bit wavefront on " << scenario.name << " ===" << std::endl;
+    std::cout << "  Component labelling + per-cell queries: " << label_time << "ms, flood: " << flood_time
+              << "ms (" << flood_rows << " row updates), " << flooded_cells << " cells reached" << std::endl;
+    std::cout << "  Hop distance layer: " << wavefront.getLastTime() << "ms, " << wavefront.getIterations()
+              << " wave steps, max distance " << max_distance << std::endl;
+    if (flooded_cells != component_cells) {
+        std::cout << "  Mismatch: component has " << component_cells << " cells" << std::endl;
+    }
+}
+
+/**
+ * @brief Сравнить стоимость сглаживания: жадный перебор против экспоненциального поиска
+ * @param scenario Сценарий (карта и запрос), желательно с длинным путем
+ */
+void runSmoothingBenchmark(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    // Ленивые таблицы сетки пересчитываются до замеров, а не в первом варианте
+    grid.refreshObstacleCounts();
+    grid.refreshFreeRuns();
+    
+    AStar astar(grid);
+    std::vector<Node*> path;
+    try {
+        path = astar.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+    } catch (const std::exception& e) {
+        std::cout << "\nSmoothing benchmark on " << scenario.name << " skipped: " << e.what() << std::endl;
+        return;
+    }
+    
+    std::cout << "\n=== Path smoothing on " << scenario.name << " (" << path.size() << " waypoints, length "
+              << metrics::calculatePathLength(path) << ") ===" << std::endl;
+    
+    struct Variant {
+        const char* name;
+        ShortcutMode mode;
+        bool string_pulling;
+    };
+    const Variant variants[] = {
+        {"Greedy", ShortcutMode::Greedy, false},
+        {"Exponential", ShortcutMode::Exponential, false},
+        {"Exponential+pull", ShortcutMode::Exponential, true}
+    };
+    for (const auto& variant : variants) {
+        PathSmoother smoother(grid);
+        smoother.setShortcutMode(variant.mode);
+        smoother.setStringPulling(variant.string_pulling);
+        
+        double total_time = 0.0;
+        std::vector<Node*> smoothed;
+        for (int run = 0; run < config::NUM_TEST_RUNS; ++run) {
+            smoothed = smoother.smooth(path);
+            total_time += smoother.getSmoothTime();
+        }
+        std::cout << "  " << variant.name << ": " << total_time / config::NUM_TEST_RUNS << "ms, LOS checks: "
+                  << smoother.getVisibilityChecks() << ", waypoints: " << smoothed.size()
+                  << ", length: " << metrics::calculatePathLength(smoothed) << std::endl;
+    }
+}
+
+/**
+ * @brief Сравнить поле расстояний до цели с отдельными запросами A* от многих стартов
+ * @param scenario Сценарий; цель - его конечная точка
+ */
+void runGoalFieldBenchmark(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    
+    // Случайные старты в той же компоненте, что и цель
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    std::vector<std::pair<int, int>> starts;
+    for (int attempt = 0; attempt < 100000 && static_cast<int>(starts.size()) < config::GOAL_FIELD_BENCHMARK_STARTS;
+         ++attempt) {
+        int x = random_x(rng);
+        int y = random_y(rng);
+        if (grid.isReachable(x, y, scenario.end_x, scenario.end_y)) {
+            starts.emplace_back(x, y);
+        }
+    }
+    
+    auto elapsed = [](auto start_time) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    };
+    
+    AStar astar(grid);
+    std::vector<double> astar_lengths(starts.size(), -1.0);
+    auto astar_start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        try {
+            astar.findPath(starts[i].first, starts[i].second, scenario.end_x, scenario.end_y);
+            astar_lengths[i] = astar.getPathLength();
+        } catch (const std::exception&) {
+        }
+    }
+    double astar_time = elapsed(astar_start);
+    
+    GoalFieldSearch fields(grid);
+    int longer = 0;
+    int missing = 0;
+    auto field_start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < starts.size(); ++i) {
+        try {
+            fields.findPath(starts[i].first, starts[i].second, scenario.end_x, scenario.end_y);
+            // Поле дает кратчайший путь, поэтому длиннее A* оно быть не может
+            longer += fields.getPathLength() > astar_lengths[i] + 1e-6 && astar_lengths[i] >= 0.0 ? 1 : 0;
+        } catch (const std::exception&) {
+            ++missing;
+        }
+    }
+    double field_time = elapsed(field_start);
+    
+    auto warm_start = std::chrono::high_resolution_clock::now();
+    for (const auto& start : starts) {
+        fields.findPath(start.first, start.second, scenario.end_x, scenario.end_y);
+    }
+    double warm_time = elapsed(warm_start);
+    
+    std::cout << "\n=== Goal field vs A* on " << scenario.name << " (" << starts.size()
+              << " starts, one goal) ===" << std::endl;
+    std::cout << "  A*: " << astar_time << "ms total, goal field: " << field_time << "ms total (build "
+              << fields.getBuildTime() << "ms), warm cache: " << warm_time << "ms, field memory: "
+              << fields.getMemoryBytes() / 1024 << " KB" << std::endl;
+    if (longer != 0 || missing != 0) {
+        std::cout << "  Mismatch: " << longer << " longer paths, " << missing << " missing paths" << std::endl;
+    }
+}
+
+/**
+ * @brief Сравнить поиск к любой из K целей с K отдельными поисками
+ * @param scenario Сценарий; поиск идет из его начальной точки
+ * @param goal_count Количество целей
+ */
+void runMultiGoalBenchmark(const TestScenario& scenario, int goal_count) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    std::vector<std::pair<int, int>> goals;
+    for (int attempt = 0; attempt < 100000 && static_cast<int>(goals.size()) < goal_count; ++attempt) {
+        int x = random_x(rng);
+        int y = random_y(rng);
+        if ((x != scenario.start_x || y != scenario.start_y) &&
+            grid.isReachable(scenario.start_x, scenario.start_y, x, y)) {
+            goals.emplace_back(x, y);
+        }
+    }
+    
+    std::cout << "\n=== Nearest of " << goals.size() << " goals on " << scenario.name << " ===" << std::endl;
+    
+    auto compare = [&](const char* name, auto& algorithm) {
+        long long separate_expanded = 0;
+        double best_length = -1.0;
+        auto separate_start = std::chrono::high_resolution_clock::now();
+        for (const auto& goal : goals) {
+            try {
+                algorithm.findPath(scenario.start_x, scenario.start_y, goal.first, goal.second);
+                separate_expanded += algorithm.getNodesExpanded();
+                if (best_length < 0.0 || algorithm.getPathLength() < best_length) {
+                    best_length = algorithm.getPathLength();
+                }
+            } catch (const std::exception&) {
+            }
+        }
+        auto separate_end = std::chrono::high_resolution_clock::now();
+        
+        try {
+            algorithm.findPathToAny(scenario.start_x, scenario.start_y, goals);
+        } catch (const std::exception& e) {
+            std::cout << "  " << name << ": multi-goal search failed: " << e.what() << std::endl;
+            return;
+        }
+        auto multi_end = std::chrono::high_resolution_clock::now();
+        std::cout << "  " << name << ": K searches " << separate_expanded << " expanded, "
+                  << std::chrono::duration<double, std::milli>(separate_end - separate_start).count()
+                  << "ms, best length " << best_length << "; one search " << algorithm.getNodesExpanded()
+                  << " expanded, " << std::chrono::duration<double, std::milli>(multi_end - separate_end).count()
+                  << "ms, length " << algorithm.getPathLength() << " (goal " << algorithm.getReachedGoal() << ")"
+                  << std::endl;
+    };
+    
+    AStar astar(grid);
+    compare("AStar", astar);
+    ThetaStar thetastar(grid);
+    compare("ThetaStar", thetastar);
+}
+
+/**
+ * @brief Сравнить дерево Штейнера с отдельными путями от магистрали к каждому прибору
+ * @param scenario Сценарий; магистраль - его начальная точка
+ */
+void runSteinerBenchmark(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    std::vector<std::pair<int, int>> terminals{{scenario.start_x, scenario.start_y}};
+    for (int attempt = 0; attempt < 100000 && static_cast<int>(terminals.size()) <= config::STEINER_BENCHMARK_TERMINALS;
+         ++attempt) {
+        int x = random_x(rng);
+        int y = random_y(rng);
+        if (grid.isReachable(scenario.start_x, scenario.start_y, x, y)) {
+            terminals.emplace_back(x, y);
+        }
+    }
+    
+    AStar astar(grid);
+    double pairwise_length = 0.0;
+    auto pairwise_start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 1; i < terminals.size(); ++i) {
+        try {
+            astar.findPath(scenario.start_x, scenario.start_y, terminals[i].first, terminals[i].second);
+            pairwise_length += astar.getPathLength();
+        } catch (const std::exception&) {
+        }
+    }
+    auto pairwise_end = std::chrono::high_resolution_clock::now();
+    
+    SteinerTreeRouter router(grid);
+    try {
+        router.route(terminals);
+    } catch (const std::exception& e) {
+        std::cout << "\nSteiner benchmark on " << scenario.name << " skipped: " << e.what() << std::endl;
+        return;
+    }
+    
+    std::cout << "\n=== Steiner tree on " << scenario.name << " (" << terminals.size() - 1
+              << " fixtures) ===" << std::endl;
+    std::cout << "  Separate A* paths: total length " << pairwise_length << ", "
+              << std::chrono::duration<double, std::milli>(pairwise_end - pairwise_start).count() << "ms" << std::endl;
+    std::cout << "  Steiner tree: total length " << router.getTotalLength() << ", " << router.getSegments().size()
+              << " segments, " << router.getNodesExpanded() << " expanded, " << router.getRouteTime() << "ms"
+              << std::endl;
+}
+
+/**
+ * @brief Сравнить трассировку труб слоем зон с копированием и раздуванием сетки на каждую трубу
+ *
+ * Копирование не знает приоритетов: более приоритетная труба в слое
+ * вырывает мешающие, и проложенных труб может стать меньше. Поэтому слой
+ * сверяется с копированием по трубам на тех же трубах с равными
+ * приоритетами, где вырываний нет и результаты должны совпасть.
+ * Затем те же трубы прокладываются A* по RSR, разбиение которого
+ * обновляется слушателем слоя зон, и сверяется с построенным заново.
+ * @param scenario Сценарий
+ */
+void runPipeRoutingBenchmark(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    std::uniform_int_distribution<int> random_priority(0, 2);
+    std::vector<PipeRequest> pipes;
+    for (int attempt = 0; attempt < 100000 && static_cast<int>(pipes.size()) < config::PIPE_ROUTER_BENCHMARK_PIPES;
+         ++attempt) {
+        PipeRequest pipe{random_x(rng), random_y(rng), random_x(rng), random_y(rng), random_priority(rng)};
+        if (!grid.isObstacle(pipe.start_x, pipe.start_y) &&
+            grid.isReachable(pipe.start_x, pipe.start_y, pipe.end_x, pipe.end_y)) {
+            pipes.push_back(pipe);
+        }
+    }
+    
+    // Прежний способ: копия карты, прошлые трубы как препятствия, инфляция заново
+    int copied_routed = 0;
+    std::vector<bool> copied_status;
+    std::vector<std::vector<std::pair<int, int>>> copied_paths;
+    auto copied_start = std::chrono::high_resolution_clock::now();
+    for (const auto& pipe : pipes) {
+        Grid copy = scenario.grid;
+        for (const auto& path : copied_paths) {
+            for (const auto& cell : path) {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (std::sqrt(dx * dx + dy * dy) <= config::PIPE_ROUTER_CLEARANCE) {
+                            copy.setObstacle(cell.first + dx, cell.second + dy);
+                        }
+                    }
+                }
+            }
+        }
+        copy.inflateObstacles(config::AGENT_RADIUS);
+        AStar astar(copy);
+        try {
+            std::vector<std::pair<int, int>> path;
+            for (const Node* node : astar.findPath(pipe.start_x, pipe.start_y, pipe.end_x, pipe.end_y)) {
+                path.emplace_back(node->x, node->y);
+            }
+            copied_paths.push_back(std::move(path));
+            ++copied_routed;
+            copied_status.push_back(true);
+        } catch (const std::exception&) {
+            copied_status.push_back(false);
+        }
+    }
+    auto copied_end = std::chrono::high_resolution_clock::now();
+    
+    // Зоны труб - резерв клеток: версия карты и производные таблицы не меняются
+    const std::uint64_t map_version = grid.getVersion();
+    PipeRouter router(grid);
+    const auto& routes = router.route(pipes);
+    
+    std::cout << "\n=== Pipe routing on " << scenario.name << " (" << pipes.size() << " pipes) ===" << std::endl;
+    for (std::size_t i = 0; i < routes.size(); ++i) {
+        std::cout << "  Pipe " << i << " (priority " << pipes[i].priority << "): "
+                  << (routes[i].status == PipeStatus::Routed ? "routed" : "deadlocked") << ", length "
+                  << routes[i].length << ", " << routes[i].attempts << " searches, " << routes[i].reroutes
+                  << " reroutes, " << routes[i].time_ms << "ms" << std::endl;
+    }
+    std::cout << "  Grid copy per pipe: " << copied_routed << " routed, "
+              << std::chrono::duration<double, std::milli>(copied_end - copied_start).count() << "ms" << std::endl;
+    std::cout << "  Overlay router: " << router.getRoutedCount() << " routed, " << router.getDeadlockCount()
+              << " deadlocked, " << router.getRipUps() << " rip-ups, " << router.getNodesExpanded()
+              << " expanded, " << router.getUnreachableSkips() << " searches skipped as unreachable, "
+              << router.getTotalTime() << "ms" << std::endl;
+    if (grid.getVersion() != map_version) {
+        std::cout << "  Mismatch: routing changed the map version" << std::endl;
+    }
+    router.clear();
+    
+    std::vector<PipeRequest> equal_pipes = pipes;
+    for (auto& pipe : equal_pipes) {
+        pipe.priority = 0;
+    }
+    const auto& equal_routes = router.route(equal_pipes);
+    int differ_copied = 0;
+    for (std::size_t i = 0; i < equal_routes.size(); ++i) {
+        differ_copied += ((equal_routes[i].status == PipeStatus::Routed) != copied_status[i]) ? 1 : 0;
+    }
+    std::cout << "  Overlay router, equal priorities: " << router.getRoutedCount() << " routed, "
+              << router.getUnreachableSkips() << " searches skipped as unreachable, " << router.getTotalTime()
+              << "ms" << std::endl;
+    if (differ_copied > 0) {
+        std::cout << "  Mismatch: " << differ_copied << " pipes routed differently than with the grid copy"
+                  << std::endl;
+    }
+    router.clear();
+    
+    // Те же трубы через A* по RSR: слой зон обновляет разбиение по каждой смене резерва
+    Grid grid_rsr = scenario.grid;
+    grid_rsr.inflateObstacles(config::AGENT_RADIUS);
+    RectangularSymmetryReduction rectangles(grid_rsr);
+    rectangles.build();
+    long long updates = 0;
+    double update_time = 0.0;
+    PipeRouter rsr_router(grid_rsr);
+    rsr_router.setSuccessorFunction(rectangles.asSuccessorFunction());
+    rsr_router.setCellListener([&rectangles, &updates, &update_time](int x, int y) {
+        auto update_start = std::chrono::high_resolution_clock::now();
+        rectangles.update(x, y);
+        update_time += std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - update_start).count();
+        ++updates;
+    });
+    rsr_router.route(pipes);
+    std::cout << "  RSR router: " << rsr_router.getRoutedCount() << " routed, " << rsr_router.getDeadlockCount()
+              << " deadlocked, " << rsr_router.getNodesExpanded() << " expanded, " << rsr_router.getTotalTime()
+              << "ms; " << updates << " updates, " << update_time << "ms (full build "
+              << rectangles.getBuildTime() << "ms)" << std::endl;
+    
+    // Разбиение после обновлений должно давать те же длины, что построенное заново и обычный A*
+    RectangularSymmetryReduction rebuilt(grid_rsr);
+    rebuilt.build();
+    AStar astar_plain(grid_rsr);
+    AStar astar_updated(grid_rsr);
+    AStar astar_rebuilt(grid_rsr);
+    astar_updated.setSuccessorFunction(rectangles.asSuccessorFunction());
+    astar_rebuilt.setSuccessorFunction(rebuilt.asSuccessorFunction());
+    auto length = [](AStar& astar, int x0, int y0, int x1, int y1) {
+        try {
+            astar.findPath(x0, y0, x1, y1);
+            return astar.getPathLength();
+        } catch (const std::exception&) {
+            return -1.0;
+        }
+    };
+    int compared = 0;
+    int differ_rebuilt = 0;
+    int differ_plain = 0;
+    for (int attempt = 0; attempt < 100000 && compared < config::RSR_UPDATE_BENCHMARK_QUERIES; ++attempt) {
+        int x0 = random_x(rng);
+        int y0 = random_y(rng);
+        int x1 = random_x(rng);
+        int y1 = random_y(rng);
+        if (grid_rsr.isBlocked(x0, y0) || grid_rsr.isBlocked(x1, y1)) {
+            continue;
+        }
+        double plain = length(astar_plain, x0, y0, x1, y1);
+        double updated = length(astar_updated, x0, y0, x1, y1);
+        double fresh = length(astar_rebuilt, x0, y0, x1, y1);
+        ++compared;
+        differ_rebuilt += std::abs(updated - fresh) > 1e-6 ? 1 : 0;
+        differ_plain += std::abs(updated - plain) > 1e-6 ? 1 : 0;
+    }
+    std::cout << "  RSR updated vs rebuilt: " << compared << " queries, interior cells "
+              << rectangles.getInteriorCellCount() << " / " << rebuilt.getInteriorCellCount() << std::endl;
+    if (differ_rebuilt != 0 || differ_plain != 0) {
+        std::cout << "  Mismatch: updated decomposition differs from a full rebuild on " << differ_rebuilt
+                  << " queries, from plain A* on " << differ_plain << std::endl;
+    }
+    rsr_router.clear();
+}
+
 /**
  * @brief Основная функция
  */
@@ -116,6 +965,10 @@ int main() {
         scenarios::initializeScenarios(true);
         auto test_scenarios = scenarios::getScenarios();
         
+        // Большие карты генерируются в памяти и на диск не сохраняются
+        auto large_scenarios = scenarios::createLargeScenarios();
+        test_scenarios.insert(test_scenarios.end(), large_scenarios.begin(), large_scenarios.end());
+        
         CSVWriter csv_writer("results/csv");
 
         // Запускаем тесты для всех сценариев и собираем результаты
@@ -127,6 +980,35 @@ int main() {
 
         // Создаем сводную таблицу
         csv_writer.createSummaryTable(all_results);
+        
+        // Отсечение тупиков на сгенерированных пещерах и комнатах
+        TestScenario caves("caves", config::GRID_WIDTH, config::GRID_HEIGHT);
+        scenarios::createCaves(caves.grid, caves.start_x, caves.start_y, caves.end_x, caves.end_y);
+        runPruningReport(caves);
+        
+        TestScenario rooms("rooms", config::GRID_WIDTH, config::GRID_HEIGHT);
+        scenarios::createRooms(rooms.grid, rooms.start_x, rooms.start_y, rooms.end_x, rooms.end_y,
+                               config::ROOM_SIZE);
+        runPruningReport(rooms);
+        
+        for (const auto& scenario : test_scenarios) {
+            if (scenario.name == "large_obstacles") {
+                runLineOfSightBenchmark(scenario);
+            }
+            if (scenario.name == "large_maze" || scenario.name == "large_obstacles") {
+                runWavefrontBenchmark(scenario);
+            }
+            if (scenario.name == "maze" || scenario.name == "large_maze" || scenario.name == "large_obstacles") {
+                runSmoothingBenchmark(scenario);
+            }
+            if (scenario.name == "large_maze" || scenario.name == "large_obstacles") {
+                runGoalFieldBenchmark(scenario);
+                runMultiGoalBenchmark(scenario, config::MULTI_GOAL_BENCHMARK_GOALS);
+                runMultiGoalBenchmark(scenario, config::MULTI_GOAL_BENCHMARK_GOALS * 4);
+                runSteinerBenchmark(scenario);
+                runPipeRoutingBenchmark(scenario);
+            }
+        }
 
         std::cout << "\n=== All tests completed ===" << std::endl;
         std::cout << "Results saved to results/csv/" << std::endl;
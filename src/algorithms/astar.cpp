@@ -10,7 +10,7 @@
 #include <algorithm>
 
 AStar::AStar(Grid& grid) 
-    : grid_(grid), nodes_expanded_(0), path_length_(0.0) {}
+    : grid_(grid), nodes_expanded_(0), path_length_(0.0), reached_goal_(-1) {}
 
 std::vector<Node*> AStar::findPath(int start_x, int start_y, int end_x, int end_y) {
     
@@ -33,30 +33,91 @@ std::vector<Node*> AStar::findPath(int start_x, int start_y, int end_x, int end_
     if (!end_node.walkable) {
         throw std::runtime_error("End node is not walkable");
     }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
     
-    
+    return search(start_node,
+                  [end_x, end_y](const Node& node) { return node.x == end_x && node.y == end_y; },
+                  [this, &end_node](const Node& node) { return heuristic(node, end_node); },
+                  &end_node);
+}
+
+std::vector<Node*> AStar::findPathToAny(int start_x, int start_y, const std::vector<std::pair<int, int>>& goals) {
+    resetStatistics();
+    grid_.resetSearchData();
+
+    if (!grid_.isValidCoordinate(start_x, start_y)) {
+        throw std::runtime_error("Invalid start coordinates");
+    }
+    Node& start_node = grid_.getNode(start_x, start_y);
+    if (!start_node.walkable) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    // Старт уже среди целей: путь из одной клетки, поиск не нужен
+    for (std::size_t i = 0; i < goals.size(); ++i) {
+        if (goals[i].first == start_x && goals[i].second == start_y) {
+            reached_goal_ = static_cast<int>(i);
+            return {&start_node};
+        }
+    }
+
+    // Цели вне компоненты старта только ослабили бы эвристику
+    std::vector<std::pair<int, int>> reachable;
+    std::vector<int> origin;
+    for (std::size_t i = 0; i < goals.size(); ++i) {
+        if (grid_.isReachable(start_x, start_y, goals[i].first, goals[i].second)) {
+            reachable.push_back(goals[i]);
+            origin.push_back(static_cast<int>(i));
+        }
+    }
+    if (reachable.empty()) {
+        throw std::runtime_error("Path not found");
+    }
+
+    GoalSet goal_set(grid_, reachable);
+    auto path = search(start_node,
+                       [&goal_set](const Node& node) { return goal_set.find(node.x, node.y) != -1; },
+                       [&goal_set](const Node& node) { return goal_set.estimate(node); },
+                       nullptr);
+    reached_goal_ = origin[goal_set.find(path.back()->x, path.back()->y)];
+    return path;
+}
+
+template<typename GoalTest, typename Estimate>
+std::vector<Node*> AStar::search(Node& start_node, const GoalTest& is_goal, const Estimate& estimate, Node* target) {
     start_node.g_cost = 0.0;
-    start_node.h_cost = start_node.calculateHeuristic(end_node);
+    start_node.h_cost = estimate(start_node);
     start_node.f_cost = start_node.g_cost + start_node.h_cost;
     
     // Приоритетная очередь для открытых узлов
     PriorityQueue open_set;
-    open_set.push(&start_node);
+    open_set.push({start_node.f_cost, start_node.g_cost, &start_node});
     
     // Множества для отслеживания состояний узлов
     NodeSet open_set_members;
     NodeSet closed_set;
     
     open_set_members.insert(&start_node);
+    std::vector<Successor> successors;
     
     while (!open_set.empty()) {
         // Извлекаем узел с наименьшей f_cost
-        Node* current_node = open_set.top();
+        OpenEntry entry = open_set.top();
         open_set.pop();
+        Node* current_node = entry.node;
+        
+        // Устаревшие копии улучшенных узлов и уже закрытые узлы пропускаем
+        if (entry.g != current_node->g_cost || closed_set.find(current_node) != closed_set.end()) {
+            continue;
+        }
         open_set_members.erase(current_node);
         
         // Если достигли цели, восстанавливаем путь
-        if (current_node->x == end_x && current_node->y == end_y) {
+        if (is_goal(*current_node)) {
             auto path = reconstructPath(current_node);
             path_length_ = calculatePathLength(path);
             return path;
@@ -65,16 +126,32 @@ std::vector<Node*> AStar::findPath(int start_x, int start_y, int end_x, int end_
         closed_set.insert(current_node);
         nodes_expanded_++;
         
+        // Собираем преемников: соседей по сетке или из подключенного генератора
+        successors.clear();
+        if (successor_function_ && target != nullptr) {
+            successor_function_(*current_node, *target, successors);
+        } else {
+            for (Node* neighbor : grid_.getNeighbors(*current_node)) {
+                successors.push_back({neighbor->x, neighbor->y, current_node->calculateMoveCost(*neighbor)});
+            }
+        }
+        
         // Проверяем всех соседей
-        auto neighbors = grid_.getNeighbors(*current_node);
-        for (Node* neighbor : neighbors) {
+        for (const Successor& successor : successors) {
+            Node* neighbor = &grid_.getNode(successor.x, successor.y);
+            
             // Пропускаем уже обработанные узлы
             if (closed_set.find(neighbor) != closed_set.end()) {
                 continue;
             }
             
+            // Отсекаем ходы, не ведущие к цели оптимально
+            if (neighbor_filter_ && target != nullptr && !neighbor_filter_(*current_node, *neighbor, *target)) {
+                continue;
+            }
+            
             // Вычисляем новую стоимость пути до соседа
-            double tentative_g_cost = current_node->g_cost + current_node->calculateMoveCost(*neighbor);
+            double tentative_g_cost = current_node->g_cost + successor.cost;
             
             // Проверяем, является ли этот путь лучше
             bool is_better_path = false;
@@ -92,10 +169,10 @@ std::vector<Node*> AStar::findPath(int start_x, int start_y, int end_x, int end_
                 // Обновляем параметры соседа
                 neighbor->parent = current_node;
                 neighbor->g_cost = tentative_g_cost;
-                neighbor->h_cost = neighbor->calculateHeuristic(end_node);
+                neighbor->h_cost = estimate(*neighbor);
                 neighbor->f_cost = neighbor->g_cost + config::HEURISTIC_WEIGHT * neighbor->h_cost;
                 
-                open_set.push(neighbor);
+                open_set.push({neighbor->f_cost, neighbor->g_cost, neighbor});
             }
         }
         
@@ -119,7 +196,31 @@ std::vector<Node*> AStar::reconstructPath(Node* end_node) {
     
     // Переворачиваем путь, чтобы он шел от начала к концу
     std::reverse(path.begin(), path.end());
-    return path;
+    return successor_function_ ? expandMacroEdges(path) : path;
+}
+
+std::vector<Node*> AStar::expandMacroEdges(const std::vector<Node*>& path) {
+    std::vector<Node*> expanded;
+    for (Node* node : path) {
+        if (!expanded.empty()) {
+            // Октильный маршрут: диагональ, пока обе разности ненулевые, затем прямая
+            int x = expanded.back()->x;
+            int y = expanded.back()->y;
+            while (std::max(std::abs(node->x - x), std::abs(node->y - y)) > 1 ||
+                   (!config::ALLOW_DIAGONAL_MOVEMENT && node->x != x && node->y != y)) {
+                int step_x = (node->x > x) - (node->x < x);
+                int step_y = (node->y > y) - (node->y < y);
+                if (!config::ALLOW_DIAGONAL_MOVEMENT && step_x != 0) {
+                    step_y = 0;
+                }
+                x += step_x;
+                y += step_y;
+                expanded.push_back(&grid_.getNode(x, y));
+            }
+        }
+        expanded.push_back(node);
+    }
+    return expanded;
 }
 
 double AStar::calculatePathLength(const std::vector<Node*>& path) const {
@@ -137,4 +238,5 @@ double AStar::calculatePathLength(const std::vector<Node*>& path) const {
 void AStar::resetStatistics() {
     nodes_expanded_ = 0;
     path_length_ = 0.0;
+    reached_goal_ = -1;
 }
\ No newline at end of file
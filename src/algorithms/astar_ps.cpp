@@ -9,7 +9,13 @@
 #include <cmath>
 
 AStarPS::AStarPS(Grid& grid) 
-    : grid_(grid), astar_(grid), original_path_length_(0.0), smoothed_path_length_(0.0) {}
+    : grid_(grid), astar_(grid), original_path_length_(0.0), smoothed_path_length_(0.0),
+      smoother_(grid) {
+    // Жадное срезание без натягивания - прежнее сглаживание A*PS, по которому
+    // сняты базовые результаты; остальные режимы включаются через getSmoother()
+    smoother_.setShortcutMode(ShortcutMode::Greedy);
+    smoother_.setStringPulling(false);
+}
 
 std::vector<Node*> AStarPS::findPath(int start_x, int start_y, int end_x, int end_y) {
     // Сброс статистики
@@ -27,39 +33,7 @@ std::vector<Node*> AStarPS::findPath(int start_x, int start_y, int end_x, int en
 }
 
 std::vector<Node*> AStarPS::smoothPath(const std::vector<Node*>& original_path) {
-    if (original_path.size() < 3) {
-        return original_path;
-    }
-    
-    std::vector<Node*> smoothed_path;
-    smoothed_path.push_back(original_path[0]);
-    
-    size_t current_index = 0;
-    
-    while (current_index < original_path.size() - 1) {
-        size_t farthest_visible_index = current_index + 1;
-        
-        for (size_t test_index = current_index + 2; test_index < original_path.size(); ++test_index) {
-            Node* current_node = original_path[current_index];
-            Node* test_node = original_path[test_index];
-            
-            // ПРАВИЛЬНЫЙ ВЫЗОВ: передаем grid_ первым параметром
-            if (line_of_sight::hasLineOfSight(grid_, *current_node, *test_node)) {
-                farthest_visible_index = test_index;
-            } else {
-                break;
-            }
-        }
-        
-        smoothed_path.push_back(original_path[farthest_visible_index]);
-        current_index = farthest_visible_index;
-    }
-    
-    if (smoothed_path.back() != original_path.back()) {
-        smoothed_path.push_back(original_path.back());
-    }
-    
-    return smoothed_path;
+    return smoother_.smooth(original_path);
 }
 
 double AStarPS::calculateSmoothedPathLength(const std::vector<Node*>& path) const {
@@ -88,6 +62,7 @@ double AStarPS::calculateSmoothedPathLength(const std::vector<Node*>& path) cons
 
 void AStarPS::resetStatistics() {
     astar_.resetStatistics();
+    smoother_.resetStatistics();
     original_path_length_ = 0.0;
     smoothed_path_length_ = 0.0;
 }
\ No newline at end of file
@@ -0,0 +1,414 @@
+/**
+ * @file block_astar.cpp
+ * @brief Реализация алгоритма Block A*
+ */
+
+#include "algorithms/block_astar.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <functional>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double moveCost(int dx, int dy) {
+    return (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+}
+
+} // namespace
+
+BlockAStar::BlockAStar(Grid& grid, int block_size)
+    : grid_(grid), block_size_(block_size), lddb_(LocalDistanceDatabase::shared(block_size)),
+      nodes_expanded_(0), path_length_(0.0), blocks_x_(0), blocks_y_(0), search_id_(0) {}
+
+void BlockAStar::prepareState() {
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    std::size_t cell_count = static_cast<std::size_t>(width) * height;
+
+    blocks_x_ = (width + block_size_ - 1) / block_size_;
+    blocks_y_ = (height + block_size_ - 1) / block_size_;
+    std::size_t block_count = static_cast<std::size_t>(blocks_x_) * blocks_y_;
+
+    if (cell_stamp_.size() != cell_count || block_stamp_.size() != block_count) {
+        cell_stamp_.assign(cell_count, 0);
+        g_.assign(cell_count, kInfinity);
+        parent_.assign(cell_count, -1);
+        block_stamp_.assign(block_count, 0);
+        pattern_.assign(block_count, 0);
+        heap_value_.assign(block_count, kInfinity);
+        ingress_.assign(block_count, {});
+        search_id_ = 0;
+    }
+
+    if (++search_id_ == 0) {
+        std::fill(cell_stamp_.begin(), cell_stamp_.end(), 0);
+        std::fill(block_stamp_.begin(), block_stamp_.end(), 0);
+        search_id_ = 1;
+    }
+}
+
+void BlockAStar::touchBlock(int block) {
+    if (block_stamp_[block] == search_id_) {
+        return;
+    }
+    block_stamp_[block] = search_id_;
+    heap_value_[block] = kInfinity;
+    ingress_[block].clear();
+
+    // Шаблон вычисляется по текущему состоянию сетки; клетки за краем карты и
+    // отсеченные клетки закрыты, как и для canMove(), которым уточняются отрезки
+    int ox = (block % blocks_x_) * block_size_;
+    int oy = (block / blocks_x_) * block_size_;
+    std::uint64_t pattern = 0;
+    for (int ly = 0; ly < block_size_; ++ly) {
+        for (int lx = 0; lx < block_size_; ++lx) {
+            if (grid_.isBlocked(ox + lx, oy + ly)) {
+                pattern |= 1ULL << (ly * block_size_ + lx);
+            }
+        }
+    }
+    pattern_[block] = pattern;
+}
+
+double BlockAStar::cost(int cell) const {
+    return cell_stamp_[cell] == search_id_ ? g_[cell] : kInfinity;
+}
+
+std::vector<double> BlockAStar::localDistances(int block, int x, int y) const {
+    int ox = (block % blocks_x_) * block_size_;
+    int oy = (block / blocks_x_) * block_size_;
+    std::vector<double> dist(block_size_ * block_size_, kInfinity);
+
+    auto inside = [&](int cx, int cy) {
+        return cx >= ox && cy >= oy && cx < ox + block_size_ && cy < oy + block_size_;
+    };
+
+    MinQueue queue;
+    dist[(y - oy) * block_size_ + (x - ox)] = 0.0;
+    queue.push({0.0, (y - oy) * block_size_ + (x - ox)});
+
+    while (!queue.empty()) {
+        auto [d, local] = queue.top();
+        queue.pop();
+        if (d > dist[local]) {
+            continue;
+        }
+        int cx = ox + local % block_size_;
+        int cy = oy + local / block_size_;
+
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            if (!inside(cx + dx, cy + dy) || !grid_.canMove(cx, cy, dx, dy)) {
+                continue;
+            }
+            int next = (cy + dy - oy) * block_size_ + (cx + dx - ox);
+            double nd = d + moveCost(dx, dy);
+            if (nd < dist[next]) {
+                dist[next] = nd;
+                queue.push({nd, next});
+            }
+        }
+    }
+
+    return dist;
+}
+
+void BlockAStar::localPath(int block, int sx, int sy, int tx, int ty,
+                           std::vector<std::pair<int, int>>& cells) const {
+    if (sx == tx && sy == ty) {
+        return;
+    }
+
+    int ox = (block % blocks_x_) * block_size_;
+    int oy = (block / blocks_x_) * block_size_;
+
+    // Расстояния от цели позволяют пройти от старта жадно по убыванию
+    auto dist = localDistances(block, tx, ty);
+    int x = sx;
+    int y = sy;
+
+    while (x != tx || y != ty) {
+        double current = dist[(y - oy) * block_size_ + (x - ox)];
+        int best_dx = 0;
+        int best_dy = 0;
+        double best = kInfinity;
+
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            int nx = x + dx;
+            int ny = y + dy;
+            if (nx < ox || ny < oy || nx >= ox + block_size_ || ny >= oy + block_size_ ||
+                !grid_.canMove(x, y, dx, dy)) {
+                continue;
+            }
+            double candidate = dist[(ny - oy) * block_size_ + (nx - ox)] + moveCost(dx, dy);
+            if (candidate < best) {
+                best = candidate;
+                best_dx = dx;
+                best_dy = dy;
+            }
+        }
+
+        if (best == kInfinity || best > current + 1e-9) {
+            throw std::logic_error("Block A* failed to refine a block segment");
+        }
+
+        x += best_dx;
+        y += best_dy;
+        cells.emplace_back(x, y);
+    }
+}
+
+std::vector<Node*> BlockAStar::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    prepareState();
+
+    const int width = grid_.getWidth();
+    const int perimeter = lddb_->getPerimeterSize();
+    const int start_cell = start_y * width + start_x;
+
+    auto blockOf = [&](int x, int y) {
+        return (y / block_size_) * blocks_x_ + (x / block_size_);
+    };
+    const Node& target = grid_.getNode(end_x, end_y);
+    auto heuristic = [&](int x, int y) {
+        if (heuristic_) {
+            return config::HEURISTIC_WEIGHT * heuristic_(grid_.getNode(x, y), target);
+        }
+        double dx = static_cast<double>(x - end_x);
+        double dy = static_cast<double>(y - end_y);
+        return config::HEURISTIC_WEIGHT * std::sqrt(dx * dx + dy * dy);
+    };
+    auto setCost = [&](int cell, double g, int parent) {
+        cell_stamp_[cell] = search_id_;
+        g_[cell] = g;
+        parent_[cell] = parent;
+    };
+
+    MinQueue open_list;
+    auto enqueue = [&](int block, int cell) {
+        touchBlock(block);
+        ingress_[block].push_back(cell);
+        double value = g_[cell] + heuristic(cell % width, cell / width);
+        if (value < heap_value_[block]) {
+            heap_value_[block] = value;
+            open_list.push({value, block});
+        }
+    };
+
+    const int start_block = blockOf(start_x, start_y);
+    const int goal_block = blockOf(end_x, end_y);
+    touchBlock(start_block);
+    touchBlock(goal_block);
+
+    // Расстояния от цели внутри ее блока замыкают путь от клеток периметра
+    const std::vector<double> goal_distances = localDistances(goal_block, end_x, end_y);
+    const int goal_ox = (goal_block % blocks_x_) * block_size_;
+    const int goal_oy = (goal_block / blocks_x_) * block_size_;
+    auto goalDistance = [&](int cell) {
+        return goal_distances[(cell / width - goal_oy) * block_size_ + (cell % width - goal_ox)];
+    };
+
+    double best_goal = kInfinity;
+    int goal_parent = -1;
+
+    setCost(start_cell, 0.0, -1);
+    if (start_block == goal_block) {
+        best_goal = goalDistance(start_cell);
+        goal_parent = start_cell;
+    }
+
+    // Старт может лежать внутри блока: клетки периметра получают стоимости напрямую
+    {
+        int ox = (start_block % blocks_x_) * block_size_;
+        int oy = (start_block / blocks_x_) * block_size_;
+        auto dist = localDistances(start_block, start_x, start_y);
+        for (int p = 0; p < perimeter; ++p) {
+            auto [lx, ly] = lddb_->perimeterCell(p);
+            int x = ox + lx;
+            int y = oy + ly;
+            double d = dist[ly * block_size_ + lx];
+            if (!grid_.isValidCoordinate(x, y) || d == kInfinity) {
+                continue;
+            }
+            int cell = y * width + x;
+            if (cell != start_cell) {
+                setCost(cell, d, start_cell);
+            }
+            enqueue(start_block, cell);
+        }
+    }
+
+    while (!open_list.empty()) {
+        auto [value, block] = open_list.top();
+        open_list.pop();
+
+        if (value != heap_value_[block]) {
+            continue;
+        }
+        if (value >= best_goal) {
+            break;
+        }
+
+        heap_value_[block] = kInfinity;
+        nodes_expanded_++;
+        if (nodes_expanded_ > config::MAX_PATHFINDING_ITERATIONS) {
+            throw std::runtime_error("Pathfinding exceeded maximum iterations");
+        }
+
+        const int ox = (block % blocks_x_) * block_size_;
+        const int oy = (block / blocks_x_) * block_size_;
+        const std::uint16_t* table = lddb_->distances(pattern_[block]);
+
+        std::vector<int> ingress;
+        ingress.swap(ingress_[block]);
+        std::sort(ingress.begin(), ingress.end());
+        ingress.erase(std::unique(ingress.begin(), ingress.end()), ingress.end());
+
+        // Шаг 1: обновить все клетки периметра через LDDB от клеток входа
+        std::vector<int> updated = ingress;
+        for (int to = 0; to < perimeter; ++to) {
+            auto [tx, ty] = lddb_->perimeterCell(to);
+            if (!grid_.isValidCoordinate(ox + tx, oy + ty)) {
+                continue;
+            }
+            int target = (oy + ty) * width + (ox + tx);
+            double best = cost(target);
+            int best_parent = -1;
+
+            for (int source : ingress) {
+                int from = lddb_->perimeterIndex(source % width - ox, source / width - oy);
+                if (from < 0) {
+                    continue;
+                }
+                std::uint16_t d = table[from * perimeter + to];
+                if (d == LocalDistanceDatabase::kUnreachable) {
+                    continue;
+                }
+                double candidate = cost(source) + LocalDistanceDatabase::toCost(d);
+                if (candidate < best - 1e-9) {
+                    best = candidate;
+                    best_parent = source;
+                }
+            }
+
+            if (best_parent != -1) {
+                setCost(target, best, best_parent);
+                updated.push_back(target);
+            }
+        }
+
+        // Блок цели: замыкаем путь от обновленных клеток периметра
+        if (block == goal_block) {
+            for (int cell : updated) {
+                double candidate = cost(cell) + goalDistance(cell);
+                if (candidate < best_goal) {
+                    best_goal = candidate;
+                    goal_parent = cell;
+                }
+            }
+        }
+
+        // Шаг 2: перенести стоимости через границу в соседние блоки
+        for (int cell : updated) {
+            int x = cell % width;
+            int y = cell / width;
+            for (const auto& direction : kDirections) {
+                int dx = direction[0];
+                int dy = direction[1];
+                int nx = x + dx;
+                int ny = y + dy;
+                if (nx >= ox && ny >= oy && nx < ox + block_size_ && ny < oy + block_size_) {
+                    continue;
+                }
+                if (!grid_.canMove(x, y, dx, dy)) {
+                    continue;
+                }
+
+                int neighbor = ny * width + nx;
+                double candidate = cost(cell) + moveCost(dx, dy);
+                if (candidate < cost(neighbor) - 1e-9) {
+                    setCost(neighbor, candidate, cell);
+                    enqueue(blockOf(nx, ny), neighbor);
+                }
+            }
+        }
+    }
+
+    if (best_goal == kInfinity) {
+        throw std::runtime_error("Path not found");
+    }
+
+    // Опорные клетки: цель, затем цепочка родителей до старта
+    std::vector<int> waypoints;
+    waypoints.push_back(end_y * width + end_x);
+    for (int cell = goal_parent; cell != -1; cell = parent_[cell]) {
+        waypoints.push_back(cell);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // Соседние опорные клетки лежат в одном блоке (участок по LDDB) или рядом через границу
+    std::vector<std::pair<int, int>> cells;
+    cells.emplace_back(start_x, start_y);
+    for (std::size_t i = 1; i < waypoints.size(); ++i) {
+        int ax = waypoints[i - 1] % width;
+        int ay = waypoints[i - 1] / width;
+        int bx = waypoints[i] % width;
+        int by = waypoints[i] / width;
+        if (blockOf(ax, ay) == blockOf(bx, by)) {
+            localPath(blockOf(ax, ay), ax, ay, bx, by, cells);
+        } else {
+            cells.emplace_back(bx, by);
+        }
+    }
+
+    std::vector<Node*> path;
+    path.reserve(cells.size());
+    for (const auto& [x, y] : cells) {
+        if (!path.empty()) {
+            path_length_ += moveCost(x - path.back()->x, y - path.back()->y);
+        }
+        path.push_back(&grid_.getNode(x, y));
+    }
+
+    return path;
+}
+
+void BlockAStar::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
@@ -0,0 +1,397 @@
+/**
+ * @file compressed_path_database.cpp
+ * @brief Реализация сжатой базы путей (таблиц первых ходов)
+ */
+
+#include "algorithms/compressed_path_database.h"
+#include "utils/fixed_point_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+// Раскладка данных в 32-битных словах: заголовок, порядок клеток,
+// смещения строк, серии. Серия - (позиция начала << 4) | ход
+const std::uint32_t kMagic = 0x42445043; // "CPDB"
+const std::uint32_t kFormatVersion = 1;
+const std::size_t kHeaderWords = 8;
+const std::uint32_t kNoMove = 8;         ///< Цель недостижима
+const std::uint16_t kAnyMove = 0x1FF;    ///< Маска "любой ход" (цель совпадает с источником)
+
+enum HeaderField { kFieldMagic, kFieldVersion, kFieldWidth, kFieldHeight,
+                   kFieldCells, kFieldRuns, kFieldHashLow, kFieldHashHigh };
+
+std::uint32_t lowestMove(std::uint16_t moves) {
+    std::uint32_t move = 0;
+    while (!(moves & (1u << move))) {
+        ++move;
+    }
+    return move;
+}
+
+std::uint64_t hilbertIndex(int x, int y, int size) {
+    int side = 1;
+    while (side < size) {
+        side <<= 1;
+    }
+
+    std::uint64_t index = 0;
+    for (int s = side / 2; s > 0; s /= 2) {
+        int rx = (x & s) ? 1 : 0;
+        int ry = (y & s) ? 1 : 0;
+        index += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - x;
+                y = s - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+double moveCost(int dx, int dy) {
+    return (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+}
+
+} // namespace
+
+CompressedPathDatabase::CompressedPathDatabase(Grid& grid, unsigned threads)
+    : grid_(grid), threads_(threads), nodes_expanded_(0), path_length_(0.0), build_time_(0.0),
+      mapped_(nullptr), mapped_bytes_(0), data_(nullptr), word_count_(0), grid_version_(0) {
+    if (threads_ == 0) {
+        threads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+CompressedPathDatabase::~CompressedPathDatabase() {
+    unmap();
+}
+
+void CompressedPathDatabase::unmap() {
+    if (mapped_) {
+        munmap(mapped_, mapped_bytes_);
+        mapped_ = nullptr;
+        mapped_bytes_ = 0;
+    }
+}
+
+void CompressedPathDatabase::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+
+    // Порядок целей - кривая Гильберта: соседние позиции близки на карте,
+    // поэтому области с одинаковым первым ходом дают длинные серии
+    std::vector<int> order;
+    for (int cell = 0; cell < width * height; ++cell) {
+        if (!grid_.isObstacle(cell % width, cell / width)) {
+            order.push_back(cell);
+        }
+    }
+    std::vector<std::uint64_t> curve(static_cast<std::size_t>(width) * height);
+    for (int cell : order) {
+        curve[cell] = hilbertIndex(cell % width, cell / width, std::max(width, height));
+    }
+    std::sort(order.begin(), order.end(), [&curve](int a, int b) { return curve[a] < curve[b]; });
+
+    std::vector<int> rank(static_cast<std::size_t>(width) * height, -1);
+    for (std::size_t r = 0; r < order.size(); ++r) {
+        rank[order[r]] = static_cast<int>(r);
+    }
+
+    const int cells = static_cast<int>(order.size());
+    if (cells > config::CPD_MAX_CELLS) {
+        throw std::runtime_error("Path database exceeds cell limit (" + std::to_string(cells) + " free cells)");
+    }
+
+    // Соседи в позициях порядка: neighbors[r * 8 + d], -1 если хода нет
+    std::vector<int> neighbors(static_cast<std::size_t>(cells) * 8, -1);
+    for (int r = 0; r < cells; ++r) {
+        int x = order[r] % width;
+        int y = order[r] / width;
+        for (int d = 0; d < 8; ++d) {
+            if (grid_.canMove(x, y, kDirections[d][0], kDirections[d][1])) {
+                neighbors[r * 8 + d] = rank[(y + kDirections[d][1]) * width + (x + kDirections[d][0])];
+            }
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> rows(cells);
+
+    // Стоимости в фиксированной точке: равные по длине пути сравниваются точно
+    std::uint64_t step_cost[8];
+    for (int d = 0; d < 8; ++d) {
+        step_cost[d] = fixed_point::stepCost(kDirections[d][0], kDirections[d][1]);
+    }
+
+    auto worker = [&](unsigned index, unsigned workers) {
+        std::vector<std::uint64_t> dist(cells);
+        std::vector<std::uint16_t> first(cells);
+
+        for (int source = static_cast<int>(index); source < cells; source += static_cast<int>(workers)) {
+            std::fill(first.begin(), first.end(), static_cast<std::uint16_t>(1u << kNoMove));
+            fixed_point::firstMoveDijkstra(neighbors, step_cost, source, dist, first);
+
+            // Кодирование длин серий: серия продолжается, пока у ее целей есть
+            // общий оптимальный ход; источник совместим с любым ходом
+            std::vector<std::uint32_t>& row = rows[source];
+            std::uint32_t run_start = 0;
+            std::uint16_t common = kAnyMove;
+            for (int target = 0; target < cells; ++target) {
+                std::uint16_t moves = target == source ? kAnyMove : first[target];
+                if (common & moves) {
+                    common &= moves;
+                    continue;
+                }
+                row.push_back((run_start << 4) | lowestMove(common));
+                run_start = static_cast<std::uint32_t>(target);
+                common = moves;
+            }
+            row.push_back((run_start << 4) | lowestMove(common));
+            row.shrink_to_fit();
+        }
+    };
+
+    const unsigned workers = std::min<unsigned>(threads_, std::max(1, cells));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < workers; ++t) {
+        pool.emplace_back(worker, t, workers);
+    }
+    worker(0, workers);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    std::size_t runs = 0;
+    for (const auto& row : rows) {
+        runs += row.size();
+    }
+
+    unmap();
+    buffer_.assign(kHeaderWords + cells + (cells + 1) + runs, 0);
+    std::uint64_t hash = fixed_point::mapHash(grid_);
+    buffer_[kFieldMagic] = kMagic;
+    buffer_[kFieldVersion] = kFormatVersion;
+    buffer_[kFieldWidth] = static_cast<std::uint32_t>(width);
+    buffer_[kFieldHeight] = static_cast<std::uint32_t>(height);
+    buffer_[kFieldCells] = static_cast<std::uint32_t>(cells);
+    buffer_[kFieldRuns] = static_cast<std::uint32_t>(runs);
+    buffer_[kFieldHashLow] = static_cast<std::uint32_t>(hash);
+    buffer_[kFieldHashHigh] = static_cast<std::uint32_t>(hash >> 32);
+
+    std::uint32_t* order_out = buffer_.data() + kHeaderWords;
+    std::uint32_t* offsets = order_out + cells;
+    std::uint32_t* run_out = offsets + cells + 1;
+    std::uint32_t offset = 0;
+    for (int r = 0; r < cells; ++r) {
+        order_out[r] = static_cast<std::uint32_t>(order[r]);
+        offsets[r] = offset;
+        std::copy(rows[r].begin(), rows[r].end(), run_out + offset);
+        offset += static_cast<std::uint32_t>(rows[r].size());
+    }
+    offsets[cells] = offset;
+
+    attach(buffer_.data(), buffer_.size());
+
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+bool CompressedPathDatabase::attach(const std::uint32_t* data, std::size_t words) {
+    if (words < kHeaderWords || data[kFieldMagic] != kMagic || data[kFieldVersion] != kFormatVersion ||
+        static_cast<int>(data[kFieldWidth]) != grid_.getWidth() ||
+        static_cast<int>(data[kFieldHeight]) != grid_.getHeight()) {
+        return false;
+    }
+
+    std::uint64_t hash = (static_cast<std::uint64_t>(data[kFieldHashHigh]) << 32) | data[kFieldHashLow];
+    std::size_t cells = data[kFieldCells];
+    std::size_t runs = data[kFieldRuns];
+    if (hash != fixed_point::mapHash(grid_) || words != kHeaderWords + cells + (cells + 1) + runs) {
+        return false;
+    }
+
+    rank_.assign(static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight(), -1);
+    for (std::size_t r = 0; r < cells; ++r) {
+        std::uint32_t cell = data[kHeaderWords + r];
+        if (cell >= rank_.size()) {
+            return false;
+        }
+        rank_[cell] = static_cast<int>(r);
+    }
+
+    data_ = data;
+    word_count_ = words;
+    grid_version_ = grid_.getVersion();
+    return true;
+}
+
+bool CompressedPathDatabase::save(const std::string& filename) const {
+    if (!data_) {
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data_),
+               static_cast<std::streamsize>(word_count_ * sizeof(std::uint32_t)));
+    return file.good();
+}
+
+bool CompressedPathDatabase::open(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0 ||
+        info.st_size % static_cast<off_t>(sizeof(std::uint32_t)) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t bytes = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    if (!attach(static_cast<const std::uint32_t*>(mapping), bytes / sizeof(std::uint32_t))) {
+        munmap(mapping, bytes);
+        return false;
+    }
+
+    unmap();
+    mapped_ = mapping;
+    mapped_bytes_ = bytes;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    build_time_ = 0.0;
+    return true;
+}
+
+void CompressedPathDatabase::buildOrOpen(const std::string& filename) {
+    if (open(filename)) {
+        return;
+    }
+
+    build();
+    double build_time = build_time_;
+
+    // После сохранения база читается через mmap, копия в памяти освобождается
+    if (save(filename) && open(filename)) {
+        build_time_ = build_time;
+    }
+}
+
+std::size_t CompressedPathDatabase::getRunCount() const {
+    return data_ ? data_[kFieldRuns] : 0;
+}
+
+int CompressedPathDatabase::firstMove(int source, int target) const {
+    const std::uint32_t cells = data_[kFieldCells];
+    const std::uint32_t* offsets = data_ + kHeaderWords + cells;
+    const std::uint32_t* runs = offsets + cells + 1;
+
+    // Последняя серия, начинающаяся не позже цели
+    const std::uint32_t* begin = runs + offsets[source];
+    const std::uint32_t* end = runs + offsets[source + 1];
+    const std::uint32_t key = (static_cast<std::uint32_t>(target) << 4) | 0xF;
+    const std::uint32_t* run = std::upper_bound(begin, end, key) - 1;
+    return static_cast<int>(*run & 0xF);
+}
+
+std::vector<Node*> CompressedPathDatabase::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    if (!data_) {
+        build();
+    } else if (grid_version_ != grid_.getVersion()) {
+        // Карта менялась после построения: таблицы годятся, только если она вернулась к прежнему виду
+        std::uint64_t hash = (static_cast<std::uint64_t>(data_[kFieldHashHigh]) << 32) | data_[kFieldHashLow];
+        if (hash == fixed_point::mapHash(grid_)) {
+            grid_version_ = grid_.getVersion();
+        } else {
+            build();
+        }
+    }
+
+    const int width = grid_.getWidth();
+    const int target = rank_[end_y * width + end_x];
+    const int max_steps = static_cast<int>(data_[kFieldCells]);
+
+    std::vector<Node*> path;
+    path.push_back(&grid_.getNode(start_x, start_y));
+
+    int x = start_x;
+    int y = start_y;
+    while (x != end_x || y != end_y) {
+        int move = firstMove(rank_[y * width + x], target);
+        nodes_expanded_++;
+
+        if (move == static_cast<int>(kNoMove)) {
+            throw std::runtime_error("Path not found");
+        }
+        if (nodes_expanded_ > max_steps) {
+            throw std::runtime_error("Pathfinding exceeded maximum iterations");
+        }
+
+        int dx = kDirections[move][0];
+        int dy = kDirections[move][1];
+        // Отсечение и резерв версию карты не меняют: таблица может вести в закрытую клетку
+        if (!grid_.canMove(x, y, dx, dy)) {
+            throw std::runtime_error("Path blocked by pruned or reserved cells");
+        }
+        x += dx;
+        y += dy;
+        path_length_ += moveCost(dx, dy);
+        path.push_back(&grid_.getNode(x, y));
+    }
+
+    return path;
+}
+
+void CompressedPathDatabase::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
@@ -0,0 +1,343 @@
+/**
+ * @file focal_search.cpp
+ * @brief Реализация фокального поиска (A*ε)
+ */
+
+#include "algorithms/focal_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+/// Номер направления хода между соседними клетками (или -1 для старта)
+int directionIndex(int dx, int dy) {
+    for (int d = 0; d < 8; ++d) {
+        if (kDirections[d][0] == dx && kDirections[d][1] == dy) {
+            return d;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+FocalSearch::FocalSearch(Grid& grid, FocalKey key, double epsilon)
+    : grid_(grid), key_(key), default_epsilon_(epsilon), nodes_expanded_(0),
+      path_length_(0.0), suboptimality_bound_(0.0), lower_bound_(0.0), search_id_(0) {}
+
+void FocalSearch::prepareState() {
+    std::size_t cell_count = static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight();
+
+    if (stamp_.size() != cell_count) {
+        stamp_.assign(cell_count, 0);
+        g_.assign(cell_count, 0.0);
+        f_.assign(cell_count, 0.0);
+        secondary_.assign(cell_count, 0.0);
+        parent_.assign(cell_count, -1);
+        turns_.assign(cell_count, 0);
+        closed_.assign(cell_count, 0);
+        search_id_ = 0;
+    }
+
+    if (++search_id_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        search_id_ = 1;
+    }
+}
+
+void FocalSearch::computeClearance() {
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int unknown = std::numeric_limits<int>::max();
+
+    // Волна от всех препятствий (и границ карты) по 8-связности
+    clearance_.assign(static_cast<std::size_t>(width) * height, unknown);
+    std::queue<int> frontier;
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (grid_.isObstacle(x, y)) {
+                clearance_[y * width + x] = 0;
+                frontier.push(y * width + x);
+            } else if (x == 0 || y == 0 || x == width - 1 || y == height - 1) {
+                clearance_[y * width + x] = 1;
+                frontier.push(y * width + x);
+            }
+        }
+    }
+
+    while (!frontier.empty()) {
+        int index = frontier.front();
+        frontier.pop();
+        int x = index % width;
+        int y = index / width;
+
+        for (const auto& direction : kDirections) {
+            int nx = x + direction[0];
+            int ny = y + direction[1];
+            if (!grid_.isValidCoordinate(nx, ny)) {
+                continue;
+            }
+            int neighbor = ny * width + nx;
+            if (clearance_[neighbor] == unknown) {
+                clearance_[neighbor] = clearance_[index] + 1;
+                frontier.push(neighbor);
+            }
+        }
+    }
+}
+
+std::vector<Node*> FocalSearch::findPath(int start_x, int start_y, int end_x, int end_y) {
+    return findPath(start_x, start_y, end_x, end_y, default_epsilon_);
+}
+
+std::vector<Node*> FocalSearch::findPath(int start_x, int start_y, int end_x, int end_y,
+                                         double epsilon) {
+    resetStatistics();
+
+    if (epsilon < 0.0) {
+        throw std::invalid_argument("Focal search epsilon must be non-negative");
+    }
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    prepareState();
+    if (key_ == FocalKey::Clearance) {
+        computeClearance();
+    }
+
+    const int width = grid_.getWidth();
+    const int start_index = start_y * width + start_x;
+    const int end_index = end_y * width + end_x;
+    const double focal_factor = 1.0 + epsilon;
+
+    const Node& target = grid_.getNode(end_x, end_y);
+    auto heuristic = [&](int index) {
+        int x = index % width;
+        int y = index / width;
+        if (heuristic_) {
+            return heuristic_(grid_.getNode(x, y), target);
+        }
+        if (config::ALLOW_DIAGONAL_MOVEMENT) {
+            double dx = static_cast<double>(x - end_x);
+            double dy = static_cast<double>(y - end_y);
+            return std::sqrt(dx * dx + dy * dy);
+        }
+        return static_cast<double>(std::abs(x - end_x) + std::abs(y - end_y));
+    };
+
+    auto secondaryKey = [&](int index, double h) {
+        switch (key_) {
+            case FocalKey::FewestTurns:
+                return static_cast<double>(turns_[index]) + h * 1e-6;
+            case FocalKey::Clearance:
+                return -static_cast<double>(clearance_[index]) + h * 1e-6;
+            case FocalKey::GoalDistance:
+            default:
+                return h;
+        }
+    };
+
+    std::set<OpenEntry> open_list;
+    std::set<FocalEntry> focal_list;
+
+    // Закрытые узлы, стоимость которых улучшилась после раскрытия (список
+    // INCONS, как в ARA*), и наименьшее f среди них: значения узлов только
+    // убывают, поэтому до переноса списка в OPEN достаточно текущего минимума
+    std::vector<int> incons;
+    double incons_min_f = std::numeric_limits<double>::infinity();
+
+    // FOCAL - узлы OPEN с f <= (1 + ε) * нижней оценки оптимума, где оценка -
+    // наименьшее f по OPEN и INCONS. Выбранная из FOCAL цель поэтому всегда
+    // укладывается в границу 1 + ε
+    double focal_bound = 0.0;
+
+    auto insertNode = [&](int index) {
+        open_list.insert({f_[index], index});
+        if (f_[index] <= focal_bound) {
+            focal_list.insert({{secondary_[index], f_[index]}, index});
+        }
+    };
+
+    auto eraseNode = [&](int index) {
+        open_list.erase({f_[index], index});
+        focal_list.erase({{secondary_[index], f_[index]}, index});
+    };
+
+    // Сдвинуть границу FOCAL к текущей нижней оценке в обе стороны
+    auto updateFocal = [&]() {
+        double open_min = open_list.empty() ? std::numeric_limits<double>::infinity() : open_list.begin()->first;
+        double new_bound = focal_factor * std::min(open_min, incons_min_f);
+        if (new_bound > focal_bound) {
+            for (auto it = open_list.upper_bound({focal_bound, std::numeric_limits<int>::max()});
+                 it != open_list.end() && it->first <= new_bound; ++it) {
+                focal_list.insert({{secondary_[it->second], f_[it->second]}, it->second});
+            }
+        } else if (new_bound < focal_bound) {
+            for (auto it = open_list.upper_bound({new_bound, std::numeric_limits<int>::max()});
+                 it != open_list.end() && it->first <= focal_bound; ++it) {
+                focal_list.erase({{secondary_[it->second], f_[it->second]}, it->second});
+            }
+        }
+        focal_bound = new_bound;
+    };
+
+    stamp_[start_index] = search_id_;
+    closed_[start_index] = 0;
+    g_[start_index] = 0.0;
+    parent_[start_index] = -1;
+    turns_[start_index] = 0;
+    double start_h = heuristic(start_index);
+    f_[start_index] = start_h;
+    secondary_[start_index] = secondaryKey(start_index, start_h);
+
+    focal_bound = focal_factor * f_[start_index];
+    insertNode(start_index);
+
+    // Проход исправления: узлы раскрываются по f, улучшенные закрытые узлы
+    // сразу переоткрываются, пока минимум OPEN не превысит (1 + ε) уровня
+    // фронта: тогда улучшения не возвращаются в FOCAL следующим же шагом
+    bool repairing = false;
+    double repair_until = 0.0;
+
+    while (!open_list.empty() || !incons.empty()) {
+        if (repairing && (open_list.empty() || open_list.begin()->first >= repair_until)) {
+            repairing = false;
+        }
+
+        if (!repairing && focal_list.empty()) {
+            // Оценку держат узлы INCONS: они возвращаются в OPEN с улучшенной
+            // стоимостью, и улучшения расходятся от них в порядке f, как в A*
+            repair_until = open_list.empty() ? std::numeric_limits<double>::infinity() :
+                focal_factor * open_list.begin()->first;
+            for (int index : incons) {
+                if (closed_[index]) {
+                    closed_[index] = 0;
+                    insertNode(index);
+                }
+            }
+            incons.clear();
+            incons_min_f = std::numeric_limits<double>::infinity();
+            updateFocal();
+            repairing = true;
+            continue;
+        }
+
+        int current = repairing ? open_list.begin()->second : focal_list.begin()->second;
+
+        if (current == end_index && f_[end_index] <= focal_bound) {
+            std::vector<Node*> path = reconstructPath(end_index);
+            lower_bound_ = std::min(open_list.begin()->first, incons_min_f);
+            for (std::size_t i = 1; i < path.size(); ++i) {
+                path_length_ += path[i - 1]->calculateMoveCost(*path[i]);
+            }
+            suboptimality_bound_ = (lower_bound_ > 0.0) ? path_length_ / lower_bound_ : 1.0;
+            return path;
+        }
+
+        eraseNode(current);
+        closed_[current] = 1;
+        nodes_expanded_++;
+
+        if (nodes_expanded_ > config::MAX_PATHFINDING_ITERATIONS) {
+            resetStatistics();
+            throw std::runtime_error("Pathfinding exceeded maximum iterations");
+        }
+
+        int x = current % width;
+        int y = current / width;
+        int incoming = (parent_[current] == -1) ? -1 :
+            directionIndex(x - parent_[current] % width, y - parent_[current] / width);
+
+        for (int d = 0; d < 8; ++d) {
+            int dx = kDirections[d][0];
+            int dy = kDirections[d][1];
+            if (!grid_.canMove(x, y, dx, dy)) {
+                continue;
+            }
+
+            int neighbor = current + dy * width + dx;
+            double move_cost = (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+            double tentative_g = g_[current] + move_cost;
+            bool seen = stamp_[neighbor] == search_id_;
+
+            if (seen && tentative_g >= g_[neighbor]) {
+                continue;
+            }
+
+            if (seen && !closed_[neighbor]) {
+                eraseNode(neighbor);
+            }
+
+            stamp_[neighbor] = search_id_;
+            g_[neighbor] = tentative_g;
+            parent_[neighbor] = current;
+            turns_[neighbor] = turns_[current] + ((incoming != -1 && incoming != d) ? 1 : 0);
+
+            double h = heuristic(neighbor);
+            f_[neighbor] = tentative_g + config::HEURISTIC_WEIGHT * h;
+            secondary_[neighbor] = secondaryKey(neighbor, h);
+
+            if (seen && closed_[neighbor] && !repairing) {
+                // Закрытый узел сразу не переоткрывается: из-за порядка FOCAL
+                // не по f переоткрытия иначе идут почти на каждом шаге.
+                // Его f ограничивает оптимум снизу, пока узел в INCONS
+                incons.push_back(neighbor);
+                incons_min_f = std::min(incons_min_f, f_[neighbor]);
+                continue;
+            }
+
+            // Узел открывается впервые или с лучшей стоимостью
+            closed_[neighbor] = 0;
+            insertNode(neighbor);
+        }
+
+        updateFocal();
+    }
+
+    resetStatistics();
+    throw std::runtime_error("Path not found");
+}
+
+std::vector<Node*> FocalSearch::reconstructPath(int end_index) {
+    const int width = grid_.getWidth();
+    std::vector<Node*> path;
+
+    for (int index = end_index; index != -1; index = parent_[index]) {
+        path.push_back(&grid_.getNode(index % width, index / width));
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void FocalSearch::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+    suboptimality_bound_ = 0.0;
+    lower_bound_ = 0.0;
+}
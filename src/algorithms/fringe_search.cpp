@@ -0,0 +1,218 @@
+/**
+ * @file fringe_search.cpp
+ * @brief Реализация алгоритма Fringe Search
+ */
+
+#include "algorithms/fringe_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// Порядок обхода соседей совпадает с Grid::getNeighbors()
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+} // namespace
+
+FringeSearch::FringeSearch(Grid& grid)
+    : grid_(grid), nodes_expanded_(0), path_length_(0.0), iterations_(0), search_id_(0) {}
+
+void FringeSearch::prepareState() {
+    std::size_t cell_count = static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight();
+
+    if (stamp_.size() != cell_count) {
+        stamp_.assign(cell_count, 0);
+        g_.assign(cell_count, 0.0);
+        h_.assign(cell_count, 0.0);
+        parent_.assign(cell_count, -1);
+        prev_.assign(cell_count, -1);
+        next_.assign(cell_count, -1);
+        in_list_.assign(cell_count, 0);
+        search_id_ = 0;
+    }
+
+    // При переполнении счетчика поисков очищаем метки полностью
+    if (++search_id_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        search_id_ = 1;
+    }
+}
+
+void FringeSearch::insertAfter(int after, int index) {
+    int following = next_[after];
+    prev_[index] = after;
+    next_[index] = following;
+    next_[after] = index;
+    if (following != -1) {
+        prev_[following] = index;
+    }
+    in_list_[index] = 1;
+}
+
+void FringeSearch::unlink(int index, int& head) {
+    int before = prev_[index];
+    int after = next_[index];
+    if (before != -1) {
+        next_[before] = after;
+    } else {
+        head = after;
+    }
+    if (after != -1) {
+        prev_[after] = before;
+    }
+    prev_[index] = -1;
+    next_[index] = -1;
+    in_list_[index] = 0;
+}
+
+std::vector<Node*> FringeSearch::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    prepareState();
+
+    const int width = grid_.getWidth();
+    const int start_index = start_y * width + start_x;
+    const int end_index = end_y * width + end_x;
+
+    const Node& target = grid_.getNode(end_x, end_y);
+    auto heuristic = [&](int index) {
+        int x = index % width;
+        int y = index / width;
+        if (heuristic_) {
+            return heuristic_(grid_.getNode(x, y), target);
+        }
+        if (config::ALLOW_DIAGONAL_MOVEMENT) {
+            double dx = static_cast<double>(x - end_x);
+            double dy = static_cast<double>(y - end_y);
+            return std::sqrt(dx * dx + dy * dy);
+        }
+        return static_cast<double>(std::abs(x - end_x) + std::abs(y - end_y));
+    };
+
+    auto visit = [&](int index, double g, int parent) {
+        if (stamp_[index] != search_id_) {
+            stamp_[index] = search_id_;
+            h_[index] = heuristic(index);
+            in_list_[index] = 0;
+            prev_[index] = -1;
+            next_[index] = -1;
+        }
+        g_[index] = g;
+        parent_[index] = parent;
+    };
+
+    visit(start_index, 0.0, -1);
+    int head = start_index;
+    in_list_[start_index] = 1;
+
+    double f_limit = config::HEURISTIC_WEIGHT * h_[start_index];
+
+    while (head != -1) {
+        iterations_++;
+        double f_min = std::numeric_limits<double>::infinity();
+        int current = head;
+
+        while (current != -1) {
+            double f = g_[current] + config::HEURISTIC_WEIGHT * h_[current];
+
+            // Узел остается в списке "потом" до следующей итерации
+            if (f > f_limit) {
+                f_min = std::min(f_min, f);
+                current = next_[current];
+                continue;
+            }
+
+            if (current == end_index) {
+                auto path = reconstructPath(end_index);
+                path_length_ = g_[end_index];
+                return path;
+            }
+
+            nodes_expanded_++;
+            if (nodes_expanded_ > config::MAX_PATHFINDING_ITERATIONS) {
+                throw std::runtime_error("Pathfinding exceeded maximum iterations");
+            }
+
+            int x = current % width;
+            int y = current / width;
+
+            // Обходим соседей в обратном порядке, чтобы после вставки
+            // они шли в списке в прямом порядке сразу за текущим узлом
+            for (int d = 7; d >= 0; --d) {
+                int dx = kDirections[d][0];
+                int dy = kDirections[d][1];
+                if (!grid_.canMove(x, y, dx, dy)) {
+                    continue;
+                }
+
+                int neighbor = current + dy * width + dx;
+                double move_cost = (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+                double tentative_g = g_[current] + move_cost;
+
+                if (stamp_[neighbor] == search_id_ && tentative_g >= g_[neighbor]) {
+                    continue;
+                }
+
+                if (stamp_[neighbor] == search_id_ && in_list_[neighbor]) {
+                    unlink(neighbor, head);
+                }
+
+                visit(neighbor, tentative_g, current);
+                insertAfter(current, neighbor);
+            }
+
+            // Раскрытый узел покидает список; обход продолжается с его детей
+            int following = next_[current];
+            unlink(current, head);
+            current = following;
+        }
+
+        if (f_min == std::numeric_limits<double>::infinity()) {
+            break;
+        }
+        f_limit = f_min;
+    }
+
+    throw std::runtime_error("Path not found");
+}
+
+std::vector<Node*> FringeSearch::reconstructPath(int end_index) {
+    const int width = grid_.getWidth();
+    std::vector<Node*> path;
+
+    for (int index = end_index; index != -1; index = parent_[index]) {
+        path.push_back(&grid_.getNode(index % width, index / width));
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void FringeSearch::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+    iterations_ = 0;
+}
@@ -0,0 +1,419 @@
+/**
+ * @file goal_field_search.cpp
+ * @brief Реализация поиска пути по полям расстояний до цели
+ */
+
+#include "algorithms/goal_field_search.h"
+#include "utils/fixed_point_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+const std::uint8_t kNoMove = 8;            ///< Хода нет (цель или недостижимая клетка)
+const int kBucketShift = fixed_point::kCostShift; ///< Корзина - единица стоимости
+const int kBucketRing = 3;                 ///< Корзин впереди текущей: ход стоит меньше двух единиц
+
+/**
+ * @brief Потоки, ожидающие задач на время построения одного поля
+ *
+ * Корзин много, и большинство из них мало, поэтому потоки создаются один
+ * раз на построение, а между параллельными шагами ждут на условной
+ * переменной, а не создаются заново.
+ */
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned workers) : workers_(workers), generation_(0), pending_(0), stop_(false) {
+        for (unsigned t = 1; t < workers_; ++t) {
+            threads_.emplace_back([this, t] { loop(t); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    unsigned size() const { return workers_; }
+
+    /// Выполнить task(t) для всех t из [0, size()) и дождаться завершения
+    void run(const std::function<void(unsigned)>& task) {
+        if (workers_ == 1) {
+            task(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pending_ = workers_ - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+    }
+
+private:
+    unsigned workers_;
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(unsigned)>* task_ = nullptr;
+    std::uint64_t generation_;
+    unsigned pending_;
+    bool stop_;
+
+    void loop(unsigned index) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(unsigned)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) {
+                    return;
+                }
+                seen = generation_;
+                task = task_;
+            }
+            (*task)(index);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--pending_ == 0) {
+                    done_.notify_one();
+                }
+            }
+        }
+    }
+};
+
+/// Разбить [0, count) на части по числу потоков и выполнить body(t, begin, end)
+template<typename Body>
+void parallelFor(WorkerPool& pool, int count, const Body& body) {
+    int workers = static_cast<int>(pool.size());
+    int chunk = (count + workers - 1) / workers;
+    pool.run([&](unsigned t) {
+        int begin = static_cast<int>(t) * chunk;
+        int end = std::min(count, begin + chunk);
+        if (begin < end) {
+            body(t, begin, end);
+        }
+    });
+}
+
+} // namespace
+
+GoalFieldSearch::GoalFieldSearch(Grid& grid, std::size_t cache_capacity, unsigned threads)
+    : grid_(grid), cache_capacity_(cache_capacity), threads_(threads), nodes_expanded_(0),
+      path_length_(0.0), build_time_(0.0), field_builds_(0), cache_hits_(0), cache_version_(0),
+      cache_pruning_version_(0), moves_version_(0), moves_pruning_version_(0) {
+    if (cache_capacity_ == 0) {
+        throw std::invalid_argument("Goal field cache capacity must be positive");
+    }
+    if (threads_ == 0) {
+        threads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+std::shared_ptr<const GoalFieldSearch::GoalField> GoalFieldSearch::getField(int goal_x, int goal_y) {
+    if (!grid_.isValidCoordinate(goal_x, goal_y)) {
+        throw std::runtime_error("Invalid goal coordinates");
+    }
+    if (grid_.isObstacle(goal_x, goal_y)) {
+        throw std::runtime_error("Goal node is not walkable");
+    }
+
+    // Поля прежней версии карты или отсечения больше не описывают ее
+    if (cache_version_ != grid_.getVersion() || cache_pruning_version_ != grid_.getPruningVersion()) {
+        clear();
+        cache_version_ = grid_.getVersion();
+        cache_pruning_version_ = grid_.getPruningVersion();
+    }
+
+    int goal = goal_y * grid_.getWidth() + goal_x;
+    auto found = index_.find(goal);
+    if (found != index_.end()) {
+        ++cache_hits_;
+        lru_.splice(lru_.begin(), lru_, found->second);
+        return *found->second;
+    }
+
+    auto field = buildField(goal_x, goal_y);
+    lru_.push_front(field);
+    index_[goal] = lru_.begin();
+    if (lru_.size() > cache_capacity_) {
+        const GoalField& oldest = *lru_.back();
+        index_.erase(oldest.goal_y * grid_.getWidth() + oldest.goal_x);
+        lru_.pop_back();
+    }
+    return field;
+}
+
+std::vector<Node*> GoalFieldSearch::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    auto field = getField(end_x, end_y);
+    const int width = grid_.getWidth();
+    int cell = start_y * width + start_x;
+    if (std::isinf(field->distance[cell])) {
+        throw std::runtime_error("Path not found");
+    }
+
+    // Спуск: каждый лучший ход строго уменьшает расстояние до цели
+    std::vector<Node*> path;
+    int x = start_x;
+    int y = start_y;
+    path.push_back(&grid_.getNode(x, y));
+    while (x != end_x || y != end_y) {
+        std::uint8_t move = field->next_move[cell];
+        if (move == kNoMove) {
+            throw std::runtime_error("Path not found");
+        }
+        x += kDirections[move][0];
+        y += kDirections[move][1];
+        cell = y * width + x;
+        path.push_back(&grid_.getNode(x, y));
+        ++nodes_expanded_;
+    }
+
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        path_length_ += path[i - 1]->calculateMoveCost(*path[i]);
+    }
+    return path;
+}
+
+void GoalFieldSearch::updateMoves() {
+    if (moves_version_ == grid_.getVersion() && moves_pruning_version_ == grid_.getPruningVersion()) {
+        return;
+    }
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const std::size_t cells = static_cast<std::size_t>(width) * height;
+
+    // Те же правила, что у Grid::canMove, но по плотному массиву флагов:
+    // бит 1 - клетка свободна, бит 2 - в нее можно войти (не отсечена и не зарезервирована)
+    std::vector<std::uint8_t> state(cells, 0);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!grid_.isObstacle(x, y)) {
+                state[static_cast<std::size_t>(y) * width + x] = grid_.isPruned(x, y) || grid_.isReserved(x, y) ? 1 : 3;
+            }
+        }
+    }
+
+    moves_.assign(cells, 0);
+    entries_.assign(cells, 0);
+    const int directions = config::ALLOW_DIAGONAL_MOVEMENT ? 8 : 4;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            std::size_t cell = static_cast<std::size_t>(y) * width + x;
+            if (!state[cell]) {
+                continue;
+            }
+            for (int d = 0; d < directions; ++d) {
+                int dx = kDirections[d][0];
+                int dy = kDirections[d][1];
+                int nx = x + dx;
+                int ny = y + dy;
+                if (nx < 0 || ny < 0 || nx >= width || ny >= height ||
+                    !(state[static_cast<std::size_t>(ny) * width + nx] & 2)) {
+                    continue;
+                }
+                if (dx != 0 && dy != 0 && config::AGENT_RADIUS > 0.5 &&
+                    (!state[static_cast<std::size_t>(ny) * width + x] || !state[cell + dx])) {
+                    continue;
+                }
+                moves_[cell] |= static_cast<std::uint8_t>(1u << d);
+                entries_[static_cast<std::size_t>(ny) * width + nx] |= static_cast<std::uint8_t>(1u << d);
+            }
+        }
+    }
+    moves_version_ = grid_.getVersion();
+    moves_pruning_version_ = grid_.getPruningVersion();
+}
+
+std::shared_ptr<const GoalFieldSearch::GoalField> GoalFieldSearch::buildField(int goal_x, int goal_y) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    updateMoves();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int cells = width * height;
+
+    // Стоимости в фиксированной точке, как в сжатой базе путей: сравнение
+    // сумм a + b * sqrt(2) точное, а номер корзины - целая часть стоимости
+    std::uint64_t step_cost[8];
+    for (int d = 0; d < 8; ++d) {
+        step_cost[d] = fixed_point::stepCost(kDirections[d][0], kDirections[d][1]);
+    }
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> dist(new std::atomic<std::uint64_t>[cells]);
+    for (int cell = 0; cell < cells; ++cell) {
+        dist[cell].store(fixed_point::kUnreached, std::memory_order_relaxed);
+    }
+
+    WorkerPool pool(threads_);
+    const unsigned workers = pool.size();
+
+    // Корзины впереди текущей ведет каждый поток отдельно: bucket[t * ring + k % ring]
+    std::vector<std::vector<int>> buckets(static_cast<std::size_t>(workers) * kBucketRing);
+    std::vector<std::uint8_t> settled(cells, 0);
+    std::vector<int> current;
+
+    int offset[8];
+    for (int d = 0; d < 8; ++d) {
+        offset[d] = kDirections[d][1] * width + kDirections[d][0];
+    }
+
+    // Обратное ребро: клетка from ходом d попадает в окончательную клетку to
+    auto relax = [&](unsigned t, int to) {
+        const std::uint64_t base = dist[to].load(std::memory_order_relaxed);
+        const unsigned entries = entries_[to];
+        for (int d = 0; d < 8; ++d) {
+            if (!(entries & (1u << d))) {
+                continue;
+            }
+            int from = to - offset[d];
+            std::uint64_t candidate = base + step_cost[d];
+            std::uint64_t known = dist[from].load(std::memory_order_relaxed);
+            while (candidate < known) {
+                if (dist[from].compare_exchange_weak(known, candidate, std::memory_order_relaxed)) {
+                    buckets[t * kBucketRing + (candidate >> kBucketShift) % kBucketRing].push_back(from);
+                    break;
+                }
+            }
+        }
+    };
+
+    const int goal = goal_y * width + goal_x;
+    dist[goal].store(0, std::memory_order_relaxed);
+    buckets[0].push_back(goal);
+
+    std::size_t queued = 1;
+    for (std::uint64_t bucket = 0; queued > 0; ++bucket) {
+        // Клетки корзины окончательны: ход стоит не меньше ее ширины, поэтому
+        // они не улучшают друг друга. Устаревшие и повторные записи отбрасываются
+        current.clear();
+        for (unsigned t = 0; t < workers; ++t) {
+            std::vector<int>& list = buckets[t * kBucketRing + bucket % kBucketRing];
+            for (int cell : list) {
+                if (!settled[cell] && (dist[cell].load(std::memory_order_relaxed) >> kBucketShift) == bucket) {
+                    settled[cell] = 1;
+                    current.push_back(cell);
+                }
+            }
+            list.clear();
+        }
+
+        if (workers > 1 && current.size() >= static_cast<std::size_t>(config::GOAL_FIELD_PARALLEL_BUCKET)) {
+            parallelFor(pool, static_cast<int>(current.size()), [&](unsigned t, int begin, int end) {
+                for (int i = begin; i < end; ++i) {
+                    relax(t, current[i]);
+                }
+            });
+        } else {
+            for (int cell : current) {
+                relax(0, cell);
+            }
+        }
+
+        // Ходы ведут только в две следующие корзины, и списки текущей уже пусты
+        queued = 0;
+        for (const auto& list : buckets) {
+            queued += list.size();
+        }
+    }
+
+    auto field = std::make_shared<GoalField>();
+    field->goal_x = goal_x;
+    field->goal_y = goal_y;
+    field->version = grid_.getVersion();
+    field->pruning_version = grid_.getPruningVersion();
+    field->distance.assign(cells, std::numeric_limits<float>::infinity());
+    field->next_move.assign(cells, kNoMove);
+
+    // Лучший ход выбирается по точным расстояниям, независимо от того,
+    // какой поток и в каком порядке улучшал клетку
+    parallelFor(pool, height, [&](unsigned, int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int cell = y * width + x;
+                std::uint64_t own = dist[cell].load(std::memory_order_relaxed);
+                if (own == fixed_point::kUnreached) {
+                    continue;
+                }
+                field->distance[cell] = static_cast<float>(fixed_point::toCost(own));
+                if (cell == goal) {
+                    continue;
+                }
+                std::uint64_t best = fixed_point::kUnreached;
+                for (int d = 0; d < 8; ++d) {
+                    if (!(moves_[cell] & (1u << d))) {
+                        continue;
+                    }
+                    std::uint64_t through = dist[cell + offset[d]].load(std::memory_order_relaxed);
+                    if (through != fixed_point::kUnreached && through + step_cost[d] < best) {
+                        best = through + step_cost[d];
+                        field->next_move[cell] = static_cast<std::uint8_t>(d);
+                    }
+                }
+            }
+        }
+    });
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    field->build_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    build_time_ = field->build_time;
+    ++field_builds_;
+    return field;
+}
+
+void GoalFieldSearch::clear() {
+    lru_.clear();
+    index_.clear();
+}
+
+std::size_t GoalFieldSearch::getMemoryBytes() const {
+    std::size_t bytes = moves_.size() + entries_.size();
+    for (const auto& field : lru_) {
+        bytes += field->distance.size() * sizeof(float) + field->next_move.size();
+    }
+    return bytes;
+}
+
+void GoalFieldSearch::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
@@ -0,0 +1,771 @@
+/**
+ * @file hpa_star.cpp
+ * @brief Реализация иерархического поиска HPA*
+ */
+
+#include "algorithms/hpa_star.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <chrono>
+#include <functional>
+#include <tuple>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double moveCost(int dx, int dy) {
+    return (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+}
+
+double euclidean(int x0, int y0, int x1, int y1) {
+    double dx = static_cast<double>(x1 - x0);
+    double dy = static_cast<double>(y1 - y0);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace
+
+HPAStar::HPAStar(Grid& grid, int cluster_size, int levels)
+    : grid_(grid), cluster_size_(cluster_size), levels_(levels), built_(false),
+      nodes_expanded_(0), path_length_(0.0), build_time_(0.0) {
+    if (cluster_size_ < 2 || levels_ < 1) {
+        throw std::invalid_argument("Invalid HPA* cluster size or level count");
+    }
+}
+
+int HPAStar::clusterSize(int level) const {
+    int size = cluster_size_;
+    for (int l = 1; l < level; ++l) {
+        size *= config::HPA_LEVEL_FACTOR;
+    }
+    return size;
+}
+
+HPAStar::Rect HPAStar::clusterRect(int x, int y, int level) const {
+    int size = clusterSize(level);
+    Rect rect;
+    rect.x0 = (x / size) * size;
+    rect.y0 = (y / size) * size;
+    rect.x1 = std::min(rect.x0 + size, grid_.getWidth()) - 1;
+    rect.y1 = std::min(rect.y0 + size, grid_.getHeight()) - 1;
+    return rect;
+}
+
+int HPAStar::borderLevel(int coord) const {
+    for (int level = levels_; level > 1; --level) {
+        if (coord % clusterSize(level) == 0) {
+            return level;
+        }
+    }
+    return 1;
+}
+
+int HPAStar::transitionLevel(int x0, int y0, int x1, int y1) const {
+    int level = 1;
+    if (x0 / cluster_size_ != x1 / cluster_size_) {
+        level = std::max(level, borderLevel(std::max(x0, x1)));
+    }
+    if (y0 / cluster_size_ != y1 / cluster_size_) {
+        level = std::max(level, borderLevel(std::max(y0, y1)));
+    }
+    return level;
+}
+
+long long HPAStar::borderKey(int cx, int cy, bool vertical) const {
+    return (static_cast<long long>(cy) * (grid_.getWidth() + 1) + cx) * 2 + (vertical ? 1 : 0);
+}
+
+int HPAStar::createNode(int x, int y, int level, bool temporary) {
+    int id;
+    if (!free_nodes_.empty()) {
+        id = free_nodes_.back();
+        free_nodes_.pop_back();
+    } else {
+        id = static_cast<int>(nodes_.size());
+        nodes_.emplace_back();
+    }
+
+    AbstractNode& node = nodes_[id];
+    node.x = x;
+    node.y = y;
+    node.level = level;
+    node.alive = true;
+    node.temporary = temporary;
+    node.border_levels.clear();
+    node.edges.clear();
+    return id;
+}
+
+int HPAStar::acquireBorderNode(int x, int y, int border_level) {
+    int cell = y * grid_.getWidth() + x;
+    auto it = node_at_cell_.find(cell);
+
+    int id;
+    if (it != node_at_cell_.end()) {
+        id = it->second;
+    } else {
+        id = createNode(x, y, border_level, false);
+        node_at_cell_[cell] = id;
+    }
+
+    AbstractNode& node = nodes_[id];
+    node.border_levels.push_back(border_level);
+    node.level = std::max(node.level, border_level);
+    return id;
+}
+
+void HPAStar::releaseBorderNode(int id, int border_level) {
+    AbstractNode& node = nodes_[id];
+    auto it = std::find(node.border_levels.begin(), node.border_levels.end(), border_level);
+    if (it != node.border_levels.end()) {
+        node.border_levels.erase(it);
+    }
+
+    if (node.border_levels.empty()) {
+        deleteNode(id);
+        return;
+    }
+
+    int new_level = *std::max_element(node.border_levels.begin(), node.border_levels.end());
+    if (new_level < node.level) {
+        // Узел больше не лежит на границе верхнего уровня: убираем его ребра там
+        std::vector<AbstractEdge> stale;
+        for (const auto& edge : node.edges) {
+            if (!edge.inter && edge.level > new_level) {
+                stale.push_back(edge);
+            }
+        }
+        for (const auto& edge : stale) {
+            removeEdge(id, edge.to, edge.level, false);
+        }
+        node.level = new_level;
+    }
+}
+
+void HPAStar::deleteNode(int id) {
+    AbstractNode& node = nodes_[id];
+    for (const auto& edge : node.edges) {
+        auto& reverse = nodes_[edge.to].edges;
+        reverse.erase(std::remove_if(reverse.begin(), reverse.end(),
+                                     [id](const AbstractEdge& e) { return e.to == id; }),
+                      reverse.end());
+    }
+
+    if (!node.temporary) {
+        node_at_cell_.erase(node.y * grid_.getWidth() + node.x);
+    }
+
+    node.edges.clear();
+    node.border_levels.clear();
+    node.alive = false;
+    free_nodes_.push_back(id);
+}
+
+void HPAStar::addEdge(int a, int b, double cost, int level, bool inter) {
+    nodes_[a].edges.push_back({b, cost, level, inter});
+    nodes_[b].edges.push_back({a, cost, level, inter});
+}
+
+void HPAStar::removeEdge(int a, int b, int level, bool inter) {
+    auto erase = [&](int from, int to) {
+        auto& edges = nodes_[from].edges;
+        edges.erase(std::remove_if(edges.begin(), edges.end(),
+                                   [&](const AbstractEdge& e) {
+                                       return e.to == to && e.level == level && e.inter == inter;
+                                   }),
+                    edges.end());
+    };
+    erase(a, b);
+    erase(b, a);
+}
+
+void HPAStar::buildBorder(int cx, int cy, bool vertical) {
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+
+    int border = vertical ? cx * cluster_size_ : cy * cluster_size_;
+    int level = borderLevel(border);
+    int from = vertical ? cy * cluster_size_ : cx * cluster_size_;
+    int along = vertical ? height : width;
+    int to = std::min(from + cluster_size_, vertical ? height : width) - 1;
+
+    auto& transitions = border_transitions_[borderKey(cx, cy, vertical)];
+    transitions.clear();
+
+    // Клетки по обе стороны границы для позиции t вдоль нее
+    auto sides = [&](int t) {
+        return vertical ? std::make_pair(std::make_pair(border - 1, t), std::make_pair(border, t))
+                        : std::make_pair(std::make_pair(t, border - 1), std::make_pair(t, border));
+    };
+    auto open = [&](int t) {
+        auto [a, b] = sides(t);
+        return !grid_.isBlocked(a.first, a.second) && !grid_.isBlocked(b.first, b.second);
+    };
+
+    int t = from;
+    while (t <= to) {
+        if (!open(t)) {
+            ++t;
+            continue;
+        }
+
+        int segment_start = t;
+        while (t <= to && open(t)) {
+            ++t;
+        }
+        int segment_end = t - 1;
+        int length = segment_end - segment_start + 1;
+
+        // Короткий вход - один переход по центру, длинный - два по краям
+        std::vector<int> positions;
+        if (length < config::HPA_ENTRANCE_SPLIT) {
+            positions.push_back(segment_start + length / 2);
+        } else {
+            positions.push_back(segment_start);
+            positions.push_back(segment_end);
+        }
+
+        for (int position : positions) {
+            auto [a, b] = sides(position);
+            int id_a = acquireBorderNode(a.first, a.second, level);
+            int id_b = acquireBorderNode(b.first, b.second, level);
+            addEdge(id_a, id_b, 1.0, level, true);
+            transitions.emplace_back(id_a, id_b);
+        }
+    }
+
+    // Клетки, соседние только по углу, если две другие клетки у этого угла
+    // закрыты: прямых входов рядом нет, и граница проходима лишь по диагонали.
+    // Угол четырех кластеров обрабатывает вертикальная граница
+    int last = (vertical && to + 1 < along) ? to : to - 1;
+    for (int t = from; t <= last; ++t) {
+        auto [a0, b0] = sides(t);
+        auto [a1, b1] = sides(t + 1);
+        const std::pair<int, int> diagonals[2][4] = {{a0, b1, a1, b0}, {a1, b0, a0, b1}};
+
+        for (const auto& cells : diagonals) {
+            const auto& p = cells[0];
+            const auto& q = cells[1];
+            if (grid_.isBlocked(p.first, p.second) || grid_.isBlocked(q.first, q.second) ||
+                !grid_.isBlocked(cells[2].first, cells[2].second) ||
+                !grid_.isBlocked(cells[3].first, cells[3].second) ||
+                !grid_.canMove(p.first, p.second, q.first - p.first, q.second - p.second)) {
+                continue;
+            }
+
+            int diagonal_level = transitionLevel(p.first, p.second, q.first, q.second);
+            int id_p = acquireBorderNode(p.first, p.second, diagonal_level);
+            int id_q = acquireBorderNode(q.first, q.second, diagonal_level);
+            addEdge(id_p, id_q, config::DIAGONAL_COST, diagonal_level, true);
+            transitions.emplace_back(id_p, id_q);
+        }
+    }
+}
+
+void HPAStar::clearBorder(int cx, int cy, bool vertical) {
+    auto it = border_transitions_.find(borderKey(cx, cy, vertical));
+    if (it == border_transitions_.end()) {
+        return;
+    }
+
+    for (const auto& [a, b] : it->second) {
+        // Диагональный переход через угол кластеров может быть уровнем выше границы
+        int level = transitionLevel(nodes_[a].x, nodes_[a].y, nodes_[b].x, nodes_[b].y);
+        removeEdge(a, b, level, true);
+        releaseBorderNode(a, level);
+        releaseBorderNode(b, level);
+    }
+    border_transitions_.erase(it);
+}
+
+std::vector<int> HPAStar::perimeterNodes(const Rect& rect, int level) const {
+    const int width = grid_.getWidth();
+    std::vector<int> result;
+
+    auto collect = [&](int x, int y) {
+        auto it = node_at_cell_.find(y * width + x);
+        if (it != node_at_cell_.end() && nodes_[it->second].level >= level) {
+            result.push_back(it->second);
+        }
+    };
+
+    for (int x = rect.x0; x <= rect.x1; ++x) {
+        collect(x, rect.y0);
+        collect(x, rect.y1);
+    }
+    for (int y = rect.y0 + 1; y < rect.y1; ++y) {
+        collect(rect.x0, y);
+        collect(rect.x1, y);
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void HPAStar::buildIntraEdges(const Rect& rect, int level) {
+    std::vector<int> ids = perimeterNodes(rect, level);
+
+    for (int id : ids) {
+        std::vector<int> stale;
+        for (const auto& edge : nodes_[id].edges) {
+            if (!edge.inter && edge.level == level) {
+                stale.push_back(edge.to);
+            }
+        }
+        for (int to : stale) {
+            removeEdge(id, to, level, false);
+        }
+    }
+
+    const int local_width = rect.x1 - rect.x0 + 1;
+
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        const AbstractNode& source = nodes_[ids[i]];
+
+        if (level == 1) {
+            auto dist = gridDistances(rect, source.x, source.y);
+            for (std::size_t j = i + 1; j < ids.size(); ++j) {
+                const AbstractNode& target = nodes_[ids[j]];
+                double d = dist[(target.y - rect.y0) * local_width + (target.x - rect.x0)];
+                if (d < kInfinity) {
+                    addEdge(ids[i], ids[j], d, level, false);
+                }
+            }
+        } else {
+            auto dist = abstractSearch(ids[i], -1, level - 1, &rect, nullptr);
+            for (std::size_t j = i + 1; j < ids.size(); ++j) {
+                auto it = dist.find(ids[j]);
+                if (it != dist.end()) {
+                    addEdge(ids[i], ids[j], it->second, level, false);
+                }
+            }
+        }
+    }
+}
+
+void HPAStar::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    nodes_.clear();
+    free_nodes_.clear();
+    node_at_cell_.clear();
+    border_transitions_.clear();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int clusters_x = (width + cluster_size_ - 1) / cluster_size_;
+    const int clusters_y = (height + cluster_size_ - 1) / cluster_size_;
+
+    for (int cy = 0; cy < clusters_y; ++cy) {
+        for (int cx = 0; cx < clusters_x; ++cx) {
+            if (cx > 0) buildBorder(cx, cy, true);
+            if (cy > 0) buildBorder(cx, cy, false);
+        }
+    }
+
+    for (int level = 1; level <= levels_; ++level) {
+        int size = clusterSize(level);
+        for (int y = 0; y < height; y += size) {
+            for (int x = 0; x < width; x += size) {
+                buildIntraEdges(clusterRect(x, y, level), level);
+            }
+        }
+    }
+
+    built_ = true;
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void HPAStar::updateRegion(int x0, int y0, int x1, int y1) {
+    if (!built_) {
+        build();
+        return;
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int clusters_x = (width + cluster_size_ - 1) / cluster_size_;
+    const int clusters_y = (height + cluster_size_ - 1) / cluster_size_;
+
+    // Клетка на границе влияет на входы соседнего кластера, поэтому расширяем область
+    int left = std::max(0, std::min(x0, x1) - 1);
+    int top = std::max(0, std::min(y0, y1) - 1);
+    int right = std::min(width - 1, std::max(x0, x1) + 1);
+    int bottom = std::min(height - 1, std::max(y0, y1) + 1);
+
+    int cx0 = left / cluster_size_;
+    int cy0 = top / cluster_size_;
+    int cx1 = right / cluster_size_;
+    int cy1 = bottom / cluster_size_;
+
+    // Перестраиваем все границы затронутых кластеров
+    std::vector<std::tuple<int, int, bool>> borders;
+    for (int cy = cy0; cy <= cy1; ++cy) {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            if (cx > 0) borders.emplace_back(cx, cy, true);
+            if (cx + 1 < clusters_x) borders.emplace_back(cx + 1, cy, true);
+            if (cy > 0) borders.emplace_back(cx, cy, false);
+            if (cy + 1 < clusters_y) borders.emplace_back(cx, cy + 1, false);
+        }
+    }
+    std::sort(borders.begin(), borders.end());
+    borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+
+    for (const auto& [cx, cy, vertical] : borders) {
+        clearBorder(cx, cy, vertical);
+    }
+    for (const auto& [cx, cy, vertical] : borders) {
+        buildBorder(cx, cy, vertical);
+    }
+
+    // Внутренние ребра: затронутые кластеры и их соседи по перестроенным границам
+    int ax0 = std::max(0, cx0 - 1) * cluster_size_;
+    int ay0 = std::max(0, cy0 - 1) * cluster_size_;
+    int ax1 = std::min(width - 1, (std::min(clusters_x - 1, cx1 + 1) + 1) * cluster_size_ - 1);
+    int ay1 = std::min(height - 1, (std::min(clusters_y - 1, cy1 + 1) + 1) * cluster_size_ - 1);
+
+    for (int level = 1; level <= levels_; ++level) {
+        int size = clusterSize(level);
+        for (int y = (ay0 / size) * size; y <= ay1; y += size) {
+            for (int x = (ax0 / size) * size; x <= ax1; x += size) {
+                buildIntraEdges(clusterRect(x, y, level), level);
+            }
+        }
+    }
+
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+std::vector<double> HPAStar::gridDistances(const Rect& rect, int sx, int sy) {
+    const int local_width = rect.x1 - rect.x0 + 1;
+    const int local_height = rect.y1 - rect.y0 + 1;
+    std::vector<double> dist(static_cast<std::size_t>(local_width) * local_height, kInfinity);
+
+    MinQueue queue;
+    int source = (sy - rect.y0) * local_width + (sx - rect.x0);
+    dist[source] = 0.0;
+    queue.push({0.0, source});
+
+    while (!queue.empty()) {
+        auto [d, index] = queue.top();
+        queue.pop();
+        if (d > dist[index]) {
+            continue;
+        }
+
+        int x = rect.x0 + index % local_width;
+        int y = rect.y0 + index / local_width;
+
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            if (!rect.contains(x + dx, y + dy) || !grid_.canMove(x, y, dx, dy)) {
+                continue;
+            }
+            int neighbor = index + dy * local_width + dx;
+            double nd = d + moveCost(dx, dy);
+            if (nd < dist[neighbor]) {
+                dist[neighbor] = nd;
+                queue.push({nd, neighbor});
+            }
+        }
+    }
+
+    return dist;
+}
+
+bool HPAStar::gridPath(const Rect& rect, int sx, int sy, int tx, int ty,
+                       std::vector<std::pair<int, int>>& cells) {
+    if (sx == tx && sy == ty) {
+        return true;
+    }
+
+    const int local_width = rect.x1 - rect.x0 + 1;
+    const int local_height = rect.y1 - rect.y0 + 1;
+    std::size_t count = static_cast<std::size_t>(local_width) * local_height;
+    std::vector<double> g(count, kInfinity);
+    std::vector<int> parent(count, -1);
+    std::vector<char> closed(count, 0);
+
+    MinQueue queue;
+    int source = (sy - rect.y0) * local_width + (sx - rect.x0);
+    int target = (ty - rect.y0) * local_width + (tx - rect.x0);
+    g[source] = 0.0;
+    queue.push({euclidean(sx, sy, tx, ty), source});
+
+    while (!queue.empty()) {
+        int index = queue.top().second;
+        queue.pop();
+        if (closed[index]) {
+            continue;
+        }
+        closed[index] = 1;
+        nodes_expanded_++;
+
+        if (index == target) {
+            std::vector<std::pair<int, int>> segment;
+            for (int i = target; i != source; i = parent[i]) {
+                segment.emplace_back(rect.x0 + i % local_width, rect.y0 + i / local_width);
+            }
+            cells.insert(cells.end(), segment.rbegin(), segment.rend());
+            return true;
+        }
+
+        int x = rect.x0 + index % local_width;
+        int y = rect.y0 + index / local_width;
+
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            if (!rect.contains(x + dx, y + dy) || !grid_.canMove(x, y, dx, dy)) {
+                continue;
+            }
+            int neighbor = index + dy * local_width + dx;
+            double ng = g[index] + moveCost(dx, dy);
+            if (ng < g[neighbor]) {
+                g[neighbor] = ng;
+                parent[neighbor] = index;
+                queue.push({ng + euclidean(x + dx, y + dy, tx, ty), neighbor});
+            }
+        }
+    }
+
+    return false;
+}
+
+bool HPAStar::edgeUsable(const AbstractEdge& edge, int level) const {
+    return edge.inter ? edge.level >= level : edge.level == level;
+}
+
+std::unordered_map<int, double> HPAStar::abstractSearch(int source, int target, int level,
+                                                        const Rect* rect,
+                                                        std::vector<int>* path) {
+    std::unordered_map<int, double> dist;
+    std::unordered_map<int, int> parent;
+    std::unordered_map<int, char> closed;
+
+    auto heuristic = [&](int id) {
+        if (target < 0) return 0.0;
+        return euclidean(nodes_[id].x, nodes_[id].y, nodes_[target].x, nodes_[target].y);
+    };
+
+    MinQueue queue;
+    dist[source] = 0.0;
+    parent[source] = -1;
+    queue.push({heuristic(source), source});
+
+    while (!queue.empty()) {
+        int id = queue.top().second;
+        queue.pop();
+        if (closed[id]) {
+            continue;
+        }
+        closed[id] = 1;
+        nodes_expanded_++;
+
+        if (id == target) {
+            if (path != nullptr) {
+                path->clear();
+                for (int v = target; v != -1; v = parent[v]) {
+                    path->push_back(v);
+                }
+                std::reverse(path->begin(), path->end());
+            }
+            break;
+        }
+
+        for (const auto& edge : nodes_[id].edges) {
+            const AbstractNode& next = nodes_[edge.to];
+            if (!edgeUsable(edge, level) || !next.alive || next.level < level) {
+                continue;
+            }
+            if (rect != nullptr && !rect->contains(next.x, next.y)) {
+                continue;
+            }
+
+            double nd = dist[id] + edge.cost;
+            auto it = dist.find(edge.to);
+            if (it == dist.end() || nd < it->second) {
+                dist[edge.to] = nd;
+                parent[edge.to] = id;
+                queue.push({nd + heuristic(edge.to), edge.to});
+            }
+        }
+    }
+
+    return dist;
+}
+
+void HPAStar::connectTemporary(int id, const std::vector<int>& other_temporary) {
+    const int x = nodes_[id].x;
+    const int y = nodes_[id].y;
+
+    for (int level = 1; level <= levels_; ++level) {
+        Rect rect = clusterRect(x, y, level);
+        std::vector<int> targets = perimeterNodes(rect, level);
+        for (int other : other_temporary) {
+            if (rect.contains(nodes_[other].x, nodes_[other].y)) {
+                targets.push_back(other);
+            }
+        }
+
+        if (level == 1) {
+            const int local_width = rect.x1 - rect.x0 + 1;
+            auto dist = gridDistances(rect, x, y);
+            for (int target : targets) {
+                double d = dist[(nodes_[target].y - rect.y0) * local_width + (nodes_[target].x - rect.x0)];
+                if (d < kInfinity) {
+                    addEdge(id, target, d, level, false);
+                }
+            }
+        } else {
+            auto dist = abstractSearch(id, -1, level - 1, &rect, nullptr);
+            for (int target : targets) {
+                auto it = dist.find(target);
+                if (it != dist.end() && target != id) {
+                    addEdge(id, target, it->second, level, false);
+                }
+            }
+        }
+    }
+}
+
+void HPAStar::refineEdge(int a, int b, int level, std::vector<std::pair<int, int>>& cells) {
+    const AbstractEdge* best = nullptr;
+    for (const auto& edge : nodes_[a].edges) {
+        if (edge.to == b && edgeUsable(edge, level) && (best == nullptr || edge.cost < best->cost)) {
+            best = &edge;
+        }
+    }
+
+    if (best == nullptr) {
+        throw std::logic_error("HPA* refinement lost an abstract edge");
+    }
+
+    const AbstractNode& from = nodes_[a];
+    const AbstractNode& to = nodes_[b];
+
+    if (best->inter) {
+        cells.emplace_back(to.x, to.y);
+        return;
+    }
+
+    Rect rect = clusterRect(from.x, from.y, level);
+
+    if (level == 1) {
+        if (!gridPath(rect, from.x, from.y, to.x, to.y, cells)) {
+            throw std::logic_error("HPA* refinement failed inside a cluster");
+        }
+        return;
+    }
+
+    // Ребро уровня level раскрывается в путь уровня level-1 внутри того же кластера
+    std::vector<int> sub_path;
+    abstractSearch(a, b, level - 1, &rect, &sub_path);
+    if (sub_path.empty()) {
+        throw std::logic_error("HPA* refinement failed inside a cluster");
+    }
+    for (std::size_t i = 1; i < sub_path.size(); ++i) {
+        refineEdge(sub_path[i - 1], sub_path[i], level - 1, cells);
+    }
+}
+
+std::vector<Node*> HPAStar::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    if (!built_) {
+        build();
+    }
+
+    if (start_x == end_x && start_y == end_y) {
+        return {&grid_.getNode(start_x, start_y)};
+    }
+
+    // Старт и цель временно вставляются в граф на всех уровнях
+    int goal_id = createNode(end_x, end_y, levels_, true);
+    int start_id = -1;
+    std::vector<std::pair<int, int>> cells;
+
+    try {
+        connectTemporary(goal_id, {});
+        start_id = createNode(start_x, start_y, levels_, true);
+        connectTemporary(start_id, {goal_id});
+
+        std::vector<int> abstract_path;
+        abstractSearch(start_id, goal_id, levels_, nullptr, &abstract_path);
+
+        if (abstract_path.empty()) {
+            throw std::runtime_error("Path not found");
+        }
+
+        cells.emplace_back(start_x, start_y);
+        for (std::size_t i = 1; i < abstract_path.size(); ++i) {
+            refineEdge(abstract_path[i - 1], abstract_path[i], levels_, cells);
+        }
+    } catch (...) {
+        if (start_id != -1) deleteNode(start_id);
+        deleteNode(goal_id);
+        throw;
+    }
+
+    deleteNode(start_id);
+    deleteNode(goal_id);
+
+    std::vector<Node*> path;
+    path.reserve(cells.size());
+    for (const auto& [x, y] : cells) {
+        if (!path.empty() && path.back()->x == x && path.back()->y == y) {
+            continue;
+        }
+        if (!path.empty()) {
+            path_length_ += moveCost(x - path.back()->x, y - path.back()->y);
+        }
+        path.push_back(&grid_.getNode(x, y));
+    }
+
+    return path;
+}
+
+int HPAStar::getAbstractNodeCount() const {
+    return static_cast<int>(nodes_.size() - free_nodes_.size());
+}
+
+void HPAStar::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
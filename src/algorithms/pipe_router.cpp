@@ -0,0 +1,243 @@
+/**
+ * @file pipe_router.cpp
+ * @brief Реализация трассировки труб с вырыванием и перекладкой
+ */
+
+#include "algorithms/pipe_router.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+
+namespace {
+
+/**
+ * @brief Связность волны, не более строгая, чем ходы A*
+ *
+ * Запрет срезания углов проверяет только препятствия карты, и диагональ
+ * между двумя клетками зон остается открытой, поэтому при разрешенных
+ * диагоналях волна идет по 8 соседям: проверка может пропустить
+ * недостижимую трубу к поиску, но не отбросит достижимую.
+ */
+Connectivity reachabilityConnectivity() {
+    return config::ALLOW_DIAGONAL_MOVEMENT ? Connectivity::Eight : Connectivity::Four;
+}
+
+} // namespace
+
+PipeRouter::PipeRouter(Grid& grid, double clearance, int max_reroutes)
+    : grid_(grid),
+      closed_rows_(static_cast<std::size_t>(grid.getHeight()) * grid.getOccupancyStride(), 0),
+      overlay_(grid, clearance),
+      reachability_(closed_rows_.data(), grid.getWidth(), grid.getHeight(), grid.getOccupancyStride(),
+                    reachabilityConnectivity()),
+      astar_(grid), max_reroutes_(max_reroutes),
+      rip_ups_(0), unreachable_skips_(0), nodes_expanded_(0), total_time_(0.0) {
+    overlay_.setCellListener([this](int x, int y) { onCellChanged(x, y); });
+    refreshClosedRows();
+}
+
+const std::vector<PipeRoute>& PipeRouter::route(const std::vector<PipeRequest>& pipes) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    clear();
+    pipes_ = pipes;
+    routes_.assign(pipes_.size(), PipeRoute());
+    footprint_.assign(static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight(), 0);
+    queued_.assign(pipes_.size(), 1);
+    rip_ups_ = 0;
+    unreachable_skips_ = 0;
+    nodes_expanded_ = 0;
+
+    // Сетка могла измениться между трассировками
+    refreshClosedRows();
+
+    std::deque<int> queue;
+    for (std::size_t i = 0; i < pipes_.size(); ++i) {
+        const PipeRequest& pipe = pipes_[i];
+        overlay_.setExempt(pipe.start_x, pipe.start_y, true);
+        overlay_.setExempt(pipe.end_x, pipe.end_y, true);
+        queue.push_back(static_cast<int>(i));
+    }
+
+    try {
+        routeQueue(queue);
+    } catch (...) {
+        // Не оставлять в сетке резерв недостроенной трассировки
+        clear();
+        throw;
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    total_time_ = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    return routes_;
+}
+
+void PipeRouter::routeQueue(std::deque<int>& queue) {
+    while (!queue.empty()) {
+        int index = queue.front();
+        queue.pop_front();
+        queued_[index] = 0;
+        PipeRoute& current = routes_[index];
+        auto pipe_start = std::chrono::high_resolution_clock::now();
+
+        std::vector<Node*> path = search(index);
+        if (path.empty()) {
+            // Повтор без зон труб меньшего приоритета: если путь есть, мешали они
+            std::vector<int> lower;
+            for (std::size_t i = 0; i < routes_.size(); ++i) {
+                if (pipes_[i].priority < pipes_[index].priority) {
+                    lower.push_back(static_cast<int>(i));
+                }
+            }
+            if (!lower.empty()) {
+                for (int other : lower) {
+                    overlay_.erasePath(routes_[other].path);
+                }
+                path = search(index);
+                std::vector<int> victims;
+                if (!path.empty()) {
+                    victims = findConflicts(path, lower);
+                }
+                // Трубы вне новой зоны возвращаются на место, остальные встают в очередь
+                for (int other : lower) {
+                    PipeRoute& victim = routes_[other];
+                    if (std::find(victims.begin(), victims.end(), other) == victims.end()) {
+                        overlay_.stampPath(victim.path);
+                        continue;
+                    }
+                    victim.path.clear();
+                    victim.length = 0.0;
+                    victim.status = PipeStatus::Deadlocked;
+                    ++victim.reroutes;
+                    ++rip_ups_;
+                    if (victim.reroutes <= max_reroutes_) {
+                        queue.push_back(other);
+                        queued_[other] = 1;
+                    }
+                }
+                // Вырванные трубы освободили место: заблокированные раньше пробуют снова
+                if (!victims.empty()) {
+                    for (std::size_t i = 0; i < routes_.size(); ++i) {
+                        if (!queued_[i] && static_cast<int>(i) != index &&
+                            routes_[i].status == PipeStatus::Deadlocked && routes_[i].reroutes <= max_reroutes_) {
+                            queue.push_back(static_cast<int>(i));
+                            queued_[i] = 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!path.empty()) {
+            overlay_.stampPath(path);
+            current.path = std::move(path);
+            current.status = PipeStatus::Routed;
+        }
+
+        auto pipe_end = std::chrono::high_resolution_clock::now();
+        current.time_ms += std::chrono::duration<double, std::milli>(pipe_end - pipe_start).count();
+    }
+}
+
+void PipeRouter::clear() {
+    overlay_.clear();
+    pipes_.clear();
+    routes_.clear();
+}
+
+void PipeRouter::refreshClosedRows() {
+    const int stride = grid_.getOccupancyStride();
+    for (int y = 0; y < grid_.getHeight(); ++y) {
+        std::uint64_t* row = &closed_rows_[static_cast<std::size_t>(y) * stride];
+        const std::uint64_t* occupancy = grid_.getOccupancyRow(y);
+        std::copy(occupancy, occupancy + stride, row);
+        for (int x = 0; x < grid_.getWidth(); ++x) {
+            if (grid_.isBlocked(x, y)) {
+                row[x / 64] |= std::uint64_t{1} << (x % 64);
+            }
+        }
+    }
+}
+
+void PipeRouter::onCellChanged(int x, int y) {
+    std::uint64_t& word = closed_rows_[static_cast<std::size_t>(y) * grid_.getOccupancyStride() + x / 64];
+    const std::uint64_t bit = std::uint64_t{1} << (x % 64);
+    word = grid_.isBlocked(x, y) ? (word | bit) : (word & ~bit);
+    if (listener_) {
+        listener_(x, y);
+    }
+}
+
+int PipeRouter::getRoutedCount() const {
+    return static_cast<int>(std::count_if(routes_.begin(), routes_.end(),
+                                          [](const PipeRoute& route) { return route.status == PipeStatus::Routed; }));
+}
+
+int PipeRouter::getDeadlockCount() const {
+    return static_cast<int>(routes_.size()) - getRoutedCount();
+}
+
+std::vector<Node*> PipeRouter::search(int index) {
+    const PipeRequest& pipe = pipes_[index];
+    PipeRoute& route = routes_[index];
+    ++route.attempts;
+
+    // A* проверяет связность по карте без резерва: зоны и занятые концы учитывает волна
+    std::vector<Node*> path;
+    if (reachability_.flood(pipe.start_x, pipe.start_y) == 0 || !reachability_.isReached(pipe.end_x, pipe.end_y)) {
+        ++unreachable_skips_;
+    } else {
+        try {
+            path = astar_.findPath(pipe.start_x, pipe.start_y, pipe.end_x, pipe.end_y);
+            route.length = astar_.getPathLength();
+        } catch (const std::runtime_error&) {
+            // Занятый конец, недостижимость и исчерпание лимита поиска - нет пути
+            path.clear();
+        }
+        nodes_expanded_ += astar_.getNodesExpanded();
+    }
+    return path;
+}
+
+std::vector<int> PipeRouter::findConflicts(const std::vector<Node*>& path, const std::vector<int>& candidates) {
+    const int width = grid_.getWidth();
+    const auto& offsets = overlay_.getOffsets();
+
+    // Зона симметрична: клетки пути и трубы конфликтуют, если лежат в
+    // зонах друг друга и хотя бы одна из них не освобождена от штампов.
+    // Отметка 2 - рядом неосвобожденная клетка пути, 1 - только освобожденная
+    std::vector<std::size_t> marked;
+    for (const Node* node : path) {
+        std::uint8_t mark = overlay_.isExempt(node->x, node->y) ? 1 : 2;
+        for (const auto& offset : offsets) {
+            int x = node->x + offset.first;
+            int y = node->y + offset.second;
+            if (!grid_.isValidCoordinate(x, y)) {
+                continue;
+            }
+            std::size_t cell = static_cast<std::size_t>(y) * width + x;
+            if (!footprint_[cell]) {
+                marked.push_back(cell);
+            }
+            footprint_[cell] = std::max(footprint_[cell], mark);
+        }
+    }
+
+    std::vector<int> conflicts;
+    for (int other : candidates) {
+        for (const Node* node : routes_[other].path) {
+            std::uint8_t mark = footprint_[static_cast<std::size_t>(node->y) * width + node->x];
+            if (mark == 2 || (mark == 1 && !overlay_.isExempt(node->x, node->y))) {
+                conflicts.push_back(other);
+                break;
+            }
+        }
+    }
+
+    for (std::size_t cell : marked) {
+        footprint_[cell] = 0;
+    }
+    return conflicts;
+}
@@ -0,0 +1,355 @@
+/**
+ * @file quadtree_search.cpp
+ * @brief Реализация поиска по листьям квадродерева
+ */
+
+#include "algorithms/quadtree_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <chrono>
+#include <functional>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double euclidean(double x0, double y0, double x1, double y1) {
+    double dx = x1 - x0;
+    double dy = y1 - y0;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+double octile(int x0, int y0, int x1, int y1) {
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    if (!config::ALLOW_DIAGONAL_MOVEMENT) {
+        return dx + dy;
+    }
+    return std::max(dx, dy) + (config::DIAGONAL_COST - 1.0) * std::min(dx, dy);
+}
+
+// Октильный маршрут внутри свободного квадрата: диагональ, затем прямая
+void appendRoute(std::vector<std::pair<int, int>>& cells, int to_x, int to_y) {
+    int x = cells.back().first;
+    int y = cells.back().second;
+    while (x != to_x || y != to_y) {
+        int step_x = (to_x > x) - (to_x < x);
+        int step_y = (to_y > y) - (to_y < y);
+        if (!config::ALLOW_DIAGONAL_MOVEMENT && step_x != 0) {
+            step_y = 0;
+        }
+        x += step_x;
+        y += step_y;
+        cells.emplace_back(x, y);
+    }
+}
+
+} // namespace
+
+QuadtreeSearch::QuadtreeSearch(Grid& grid, int max_leaf_size)
+    : grid_(grid), max_leaf_size_(max_leaf_size), built_(false), nodes_expanded_(0),
+      path_length_(0.0), build_time_(0.0), root_size_(1) {
+    if (max_leaf_size_ < 1 || (max_leaf_size_ & (max_leaf_size_ - 1)) != 0) {
+        throw std::invalid_argument("Quadtree leaf size must be a power of two");
+    }
+}
+
+void QuadtreeSearch::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    root_size_ = 1;
+    while (root_size_ < width || root_size_ < height) {
+        root_size_ *= 2;
+    }
+
+    tree_.assign(1, {-1, -1});
+    leaves_.clear();
+    buildNode(0, 0, 0, root_size_);
+
+    // Смежность: листья за каждой стороной и за каждым углом
+    adjacency_offset_.assign(leaves_.size() + 1, 0);
+    adjacency_.clear();
+    std::vector<int> neighbors;
+    for (std::size_t id = 0; id < leaves_.size(); ++id) {
+        const Leaf leaf = leaves_[id];
+        neighbors.clear();
+
+        auto scanColumn = [&](int cx) {
+            if (cx < 0 || cx >= width) {
+                return;
+            }
+            for (int cy = leaf.y; cy < leaf.y + leaf.size;) {
+                Location location = locate(cx, cy);
+                if (location.leaf != -1) {
+                    neighbors.push_back(location.leaf);
+                }
+                cy = location.y + location.size;
+            }
+        };
+        auto scanRow = [&](int cy) {
+            if (cy < 0 || cy >= height) {
+                return;
+            }
+            for (int cx = leaf.x; cx < leaf.x + leaf.size;) {
+                Location location = locate(cx, cy);
+                if (location.leaf != -1) {
+                    neighbors.push_back(location.leaf);
+                }
+                cx = location.x + location.size;
+            }
+        };
+        scanColumn(leaf.x - 1);
+        scanColumn(leaf.x + leaf.size);
+        scanRow(leaf.y - 1);
+        scanRow(leaf.y + leaf.size);
+
+        const int corners[4][2] = {{-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+        for (const auto& corner : corners) {
+            int cx = corner[0] < 0 ? leaf.x : leaf.x + leaf.size - 1;
+            int cy = corner[1] < 0 ? leaf.y : leaf.y + leaf.size - 1;
+            if (grid_.canMove(cx, cy, corner[0], corner[1])) {
+                Location location = locate(cx + corner[0], cy + corner[1]);
+                if (location.leaf != -1) {
+                    neighbors.push_back(location.leaf);
+                }
+            }
+        }
+
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        adjacency_.insert(adjacency_.end(), neighbors.begin(), neighbors.end());
+        adjacency_offset_[id + 1] = static_cast<int>(adjacency_.size());
+    }
+
+    built_ = true;
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void QuadtreeSearch::buildNode(int node, int x, int y, int size) {
+    // Клетки вне карты считаются занятыми
+    int occupied = grid_.countObstacles(x, y, x + size - 1, y + size - 1);
+
+    if (occupied == size * size) {
+        return;
+    }
+    if (occupied == 0 && size <= max_leaf_size_) {
+        tree_[node].leaf = static_cast<int>(leaves_.size());
+        leaves_.push_back({x, y, size});
+        return;
+    }
+
+    int half = size / 2;
+    int first = static_cast<int>(tree_.size());
+    tree_.resize(tree_.size() + 4, {-1, -1});
+    tree_[node].first_child = first;
+    for (int i = 0; i < 4; ++i) {
+        buildNode(first + i, x + (i & 1) * half, y + (i >> 1) * half, half);
+    }
+}
+
+QuadtreeSearch::Location QuadtreeSearch::locate(int x, int y) const {
+    if (!grid_.isValidCoordinate(x, y)) {
+        return {-1, x, y, 1};
+    }
+
+    int node = 0;
+    int node_x = 0;
+    int node_y = 0;
+    int size = root_size_;
+    while (tree_[node].first_child != -1) {
+        size /= 2;
+        int quadrant = (x >= node_x + size ? 1 : 0) + (y >= node_y + size ? 2 : 0);
+        node_x += (quadrant & 1) * size;
+        node_y += (quadrant >> 1) * size;
+        node = tree_[node].first_child + quadrant;
+    }
+    return {tree_[node].leaf, node_x, node_y, size};
+}
+
+std::pair<double, double> QuadtreeSearch::anchor(int leaf, int start_leaf, int start_x, int start_y,
+                                                 int end_leaf, int end_x, int end_y) const {
+    if (leaf == start_leaf) {
+        return {start_x, start_y};
+    }
+    if (leaf == end_leaf) {
+        return {end_x, end_y};
+    }
+    const Leaf& square = leaves_[leaf];
+    return {square.x + (square.size - 1) / 2.0, square.y + (square.size - 1) / 2.0};
+}
+
+std::vector<Node*> QuadtreeSearch::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+    if (!grid_.getNode(start_x, start_y).walkable) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+    if (!grid_.getNode(end_x, end_y).walkable) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    if (!built_) {
+        build();
+    }
+
+    const int start_leaf = locate(start_x, start_y).leaf;
+    const int end_leaf = locate(end_x, end_y).leaf;
+    if (start_leaf == -1 || end_leaf == -1) {
+        throw std::runtime_error("Path not found");
+    }
+
+    std::vector<double> g_cost(leaves_.size(), kInfinity);
+    std::vector<int> parent(leaves_.size(), -1);
+    std::vector<char> closed(leaves_.size(), 0);
+
+    MinQueue open_list;
+    g_cost[start_leaf] = 0.0;
+    open_list.push({euclidean(start_x, start_y, end_x, end_y), start_leaf});
+
+    bool found = false;
+    while (!open_list.empty()) {
+        int current = open_list.top().second;
+        open_list.pop();
+        if (closed[current]) {
+            continue;
+        }
+        if (current == end_leaf) {
+            found = true;
+            break;
+        }
+        closed[current] = 1;
+        nodes_expanded_++;
+
+        auto current_anchor = anchor(current, start_leaf, start_x, start_y, end_leaf, end_x, end_y);
+        for (int i = adjacency_offset_[current]; i < adjacency_offset_[current + 1]; ++i) {
+            int next = adjacency_[i];
+            if (closed[next]) {
+                continue;
+            }
+            auto next_anchor = anchor(next, start_leaf, start_x, start_y, end_leaf, end_x, end_y);
+            double tentative = g_cost[current] + euclidean(current_anchor.first, current_anchor.second,
+                                                           next_anchor.first, next_anchor.second);
+            if (tentative < g_cost[next]) {
+                g_cost[next] = tentative;
+                parent[next] = current;
+                open_list.push({tentative + euclidean(next_anchor.first, next_anchor.second, end_x, end_y),
+                                next});
+            }
+        }
+
+        // Защита от бесконечного цикла
+        if (nodes_expanded_ > config::MAX_PATHFINDING_ITERATIONS) {
+            throw std::runtime_error("Pathfinding exceeded maximum iterations");
+        }
+    }
+
+    if (!found) {
+        throw std::runtime_error("Path not found");
+    }
+
+    std::vector<int> chain;
+    for (int leaf = end_leaf; leaf != -1; leaf = parent[leaf]) {
+        chain.push_back(leaf);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    std::vector<Node*> path;
+    for (const auto& cell : refine(chain, start_x, start_y, end_x, end_y)) {
+        path.push_back(&grid_.getNode(cell.first, cell.second));
+    }
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        path_length_ += path[i - 1]->calculateMoveCost(*path[i]);
+    }
+    return path;
+}
+
+std::vector<std::pair<int, int>> QuadtreeSearch::refine(const std::vector<int>& leaves, int start_x, int start_y,
+                                                        int end_x, int end_y) const {
+    std::vector<std::pair<int, int>> cells = {{start_x, start_y}};
+
+    for (std::size_t i = 0; i + 1 < leaves.size(); ++i) {
+        const Leaf& from = leaves_[leaves[i]];
+        const Leaf& to = leaves_[leaves[i + 1]];
+
+        // Ориентир за следующим листом: центр листа после него или цель
+        double target_x = end_x;
+        double target_y = end_y;
+        if (i + 2 < leaves.size()) {
+            const Leaf& after = leaves_[leaves[i + 2]];
+            target_x = after.x + (after.size - 1) / 2.0;
+            target_y = after.y + (after.size - 1) / 2.0;
+        }
+
+        int px = cells.back().first;
+        int py = cells.back().second;
+        double best = kInfinity;
+        std::pair<int, int> exit_cell = {px, py};
+        std::pair<int, int> entry_cell = {px, py};
+        auto consider = [&](int ax, int ay, int bx, int by) {
+            double cost = octile(px, py, ax, ay) + octile(ax, ay, bx, by) + euclidean(bx, by, target_x, target_y);
+            if (cost < best) {
+                best = cost;
+                exit_cell = {ax, ay};
+                entry_cell = {bx, by};
+            }
+        };
+
+        // Переход через общую сторону - по любой паре клеток напротив друг друга
+        int overlap_y0 = std::max(from.y, to.y);
+        int overlap_y1 = std::min(from.y + from.size, to.y + to.size) - 1;
+        int overlap_x0 = std::max(from.x, to.x);
+        int overlap_x1 = std::min(from.x + from.size, to.x + to.size) - 1;
+        if (overlap_y0 <= overlap_y1 && (to.x == from.x + from.size || to.x + to.size == from.x)) {
+            int ax = to.x > from.x ? from.x + from.size - 1 : from.x;
+            int bx = to.x > from.x ? to.x : to.x + to.size - 1;
+            for (int y = overlap_y0; y <= overlap_y1; ++y) {
+                consider(ax, y, bx, y);
+            }
+        } else if (overlap_x0 <= overlap_x1 && (to.y == from.y + from.size || to.y + to.size == from.y)) {
+            int ay = to.y > from.y ? from.y + from.size - 1 : from.y;
+            int by = to.y > from.y ? to.y : to.y + to.size - 1;
+            for (int x = overlap_x0; x <= overlap_x1; ++x) {
+                consider(x, ay, x, by);
+            }
+        } else {
+            // Соседство только углами: единственный диагональный переход
+            int ax = to.x > from.x ? from.x + from.size - 1 : from.x;
+            int ay = to.y > from.y ? from.y + from.size - 1 : from.y;
+            consider(ax, ay, to.x > from.x ? to.x : to.x + to.size - 1, to.y > from.y ? to.y : to.y + to.size - 1);
+        }
+
+        appendRoute(cells, exit_cell.first, exit_cell.second);
+        cells.push_back(entry_cell);
+    }
+
+    appendRoute(cells, end_x, end_y);
+    return cells;
+}
+
+std::size_t QuadtreeSearch::getMemoryBytes() const {
+    return tree_.size() * sizeof(TreeNode) + leaves_.size() * sizeof(Leaf) +
+           (adjacency_offset_.size() + adjacency_.size()) * sizeof(int);
+}
+
+void QuadtreeSearch::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
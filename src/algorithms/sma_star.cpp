@@ -0,0 +1,289 @@
+/**
+ * @file sma_star.cpp
+ * @brief Реализация алгоритма SMA*
+ */
+
+#include "algorithms/sma_star.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Веса эвристики для последовательных попыток при нехватке памяти
+const double kFallbackWeights[] = {1.0, 1.5, 2.0, 4.0};
+
+} // namespace
+
+SMAStar::SMAStar(Grid& grid, std::size_t memory_budget_bytes)
+    : grid_(grid), memory_budget_(memory_budget_bytes),
+      max_nodes_(memory_budget_bytes / kBytesPerNode),
+      nodes_expanded_(0), nodes_forgotten_(0), peak_nodes_(0), path_length_(0.0),
+      suboptimality_bound_(1.0), expanding_index_(-1) {
+    if (max_nodes_ < 2) {
+        throw std::invalid_argument("Memory budget is too small for SMA*");
+    }
+}
+
+void SMAStar::pushOpen(int index, Record& record) {
+    open_.insert({record.f, record.depth, index});
+    record.in_open = true;
+}
+
+void SMAStar::eraseOpen(int index, Record& record) {
+    open_.erase({record.f, record.depth, index});
+    record.in_open = false;
+}
+
+void SMAStar::detachChild(int parent_index, double child_f) {
+    auto it = records_.find(parent_index);
+    if (it == records_.end()) {
+        return;
+    }
+
+    Record& parent = it->second;
+    parent.children--;
+    parent.forgotten_f = std::min(parent.forgotten_f, child_f);
+
+    if (parent.in_open) {
+        return;
+    }
+
+    if (parent.forgotten_f < kInfinity) {
+        // Родитель снова становится кандидатом на раскрытие с перенесенной оценкой
+        parent.f = std::max(parent.g + parent.h, parent.forgotten_f);
+        pushOpen(parent_index, parent);
+    } else if (parent.children == 0 && parent.parent >= 0 && parent_index != expanding_index_) {
+        // Ветка без потомков и без забытых оценок больше не нужна
+        int grandparent = parent.parent;
+        records_.erase(parent_index);
+        detachChild(grandparent, kInfinity);
+    }
+}
+
+bool SMAStar::forgetWorstLeaf(int protected_index) {
+    for (auto it = open_.rbegin(); it != open_.rend(); ++it) {
+        int index = it->index;
+        if (index == protected_index) {
+            continue;
+        }
+
+        Record& record = records_.at(index);
+        if (record.children > 0 || record.parent == -1) {
+            continue;
+        }
+
+        int parent_index = record.parent;
+        double leaf_f = record.f;
+
+        open_.erase(std::next(it).base());
+        records_.erase(index);
+        nodes_forgotten_++;
+
+        detachChild(parent_index, leaf_f);
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<Node*> SMAStar::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    // При нехватке памяти поиск перезапускается с более "жадной" эвристикой:
+    // путь становится не длиннее weight * оптимальный, но требует меньше узлов
+    for (double weight : kFallbackWeights) {
+        suboptimality_bound_ = weight;
+        std::vector<Node*> path;
+
+        switch (search(start_x, start_y, end_x, end_y, weight, path)) {
+            case SearchOutcome::Found:
+                return path;
+            case SearchOutcome::NotFound:
+                throw std::runtime_error("Path not found");
+            case SearchOutcome::MemoryExhausted:
+                break;
+        }
+    }
+
+    throw std::runtime_error("Path does not fit into memory budget");
+}
+
+SMAStar::SearchOutcome SMAStar::search(int start_x, int start_y, int end_x, int end_y,
+                                      double weight, std::vector<Node*>& path) {
+    records_.clear();
+    open_.clear();
+    expanding_index_ = -1;
+    int attempt_expansions = 0;
+    bool budget_reached = false;
+
+    const int width = grid_.getWidth();
+    const int start_index = start_y * width + start_x;
+    const int end_index = end_y * width + end_x;
+
+    const Node& target = grid_.getNode(end_x, end_y);
+    auto heuristic = [&](int x, int y) {
+        if (heuristic_) {
+            return weight * heuristic_(grid_.getNode(x, y), target);
+        }
+        if (config::ALLOW_DIAGONAL_MOVEMENT) {
+            double dx = static_cast<double>(x - end_x);
+            double dy = static_cast<double>(y - end_y);
+            return weight * std::sqrt(dx * dx + dy * dy);
+        }
+        return weight * (std::abs(x - end_x) + std::abs(y - end_y));
+    };
+
+    Record& start = records_[start_index];
+    start = {0.0, heuristic(start_x, start_y), 0.0, kInfinity, -1, 0, 0, false};
+    start.f = start.h;
+    pushOpen(start_index, start);
+    peak_nodes_ = std::max<std::size_t>(peak_nodes_, 1);
+
+    while (!open_.empty()) {
+        OpenKey best_key = *open_.begin();
+        int best_index = best_key.index;
+
+        if (best_key.f == kInfinity) {
+            // Бесконечные оценки без упора в бюджет - только тупики: фронт исчерпан
+            return budget_reached ? SearchOutcome::MemoryExhausted : SearchOutcome::NotFound;
+        }
+
+        if (best_index == end_index) {
+            path = reconstructPath(end_index);
+            path_length_ = records_.at(end_index).g;
+            return SearchOutcome::Found;
+        }
+
+        Record& best = records_.at(best_index);
+        expanding_index_ = best_index;
+        eraseOpen(best_index, best);
+        best.forgotten_f = kInfinity;
+
+        nodes_expanded_++;
+        if (++attempt_expansions > config::MAX_PATHFINDING_ITERATIONS) {
+            // Повторные раскрытия забытых ветвей не дают продвинуться
+            return SearchOutcome::MemoryExhausted;
+        }
+
+        int x = best_index % width;
+        int y = best_index / width;
+        bool memory_blocked = false;
+
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            if (!grid_.canMove(x, y, dx, dy)) {
+                continue;
+            }
+
+            int neighbor_index = best_index + dy * width + dx;
+            double move_cost = (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+            double tentative_g = best.g + move_cost;
+
+            auto it = records_.find(neighbor_index);
+            if (it != records_.end()) {
+                Record& neighbor = it->second;
+                if (tentative_g >= neighbor.g) {
+                    continue;
+                }
+
+                // Нашли более короткий путь: переподвешиваем узел к текущему
+                if (neighbor.in_open) {
+                    eraseOpen(neighbor_index, neighbor);
+                }
+                int old_parent = neighbor.parent;
+                neighbor.parent = -2;
+                if (old_parent >= 0) {
+                    detachChild(old_parent, kInfinity);
+                }
+            } else {
+                double child_f = std::max(tentative_g + heuristic(x + dx, y + dy), best.f);
+
+                budget_reached = budget_reached || records_.size() >= max_nodes_;
+                if (records_.size() >= max_nodes_ && !forgetWorstLeaf(best_index)) {
+                    // Памяти не хватает даже после удаления листьев
+                    best.forgotten_f = std::min(best.forgotten_f, child_f);
+                    memory_blocked = true;
+                    continue;
+                }
+
+                it = records_.emplace(neighbor_index,
+                    Record{0.0, heuristic(x + dx, y + dy), 0.0, kInfinity, -2, 0, 0, false}).first;
+                peak_nodes_ = std::max(peak_nodes_, records_.size());
+            }
+
+            Record& neighbor = it->second;
+            neighbor.g = tentative_g;
+            neighbor.parent = best_index;
+            neighbor.depth = best.depth + 1;
+            neighbor.f = std::max(neighbor.g + neighbor.h, best.f);
+            best.children++;
+            pushOpen(neighbor_index, neighbor);
+        }
+
+        if (best.children == 0 && memory_blocked) {
+            // Узел на максимальной глубине: путь через него не помещается в память
+            best.f = kInfinity;
+            pushOpen(best_index, best);
+        } else if (best.forgotten_f < kInfinity) {
+            best.f = std::max(best.g + best.h, best.forgotten_f);
+            pushOpen(best_index, best);
+        } else if (best.children == 0 && best.parent >= 0) {
+            // Тупиковый узел: все соседи достижимы лучшими путями. Запись
+            // остается в памяти, чтобы соседи не порождали узел заново, но
+            // с бесконечной оценкой она забывается первой
+            best.f = kInfinity;
+            pushOpen(best_index, best);
+        }
+        expanding_index_ = -1;
+    }
+
+    return SearchOutcome::NotFound;
+}
+
+std::vector<Node*> SMAStar::reconstructPath(int end_index) {
+    const int width = grid_.getWidth();
+    std::vector<Node*> path;
+
+    for (int index = end_index; index >= 0; index = records_.at(index).parent) {
+        path.push_back(&grid_.getNode(index % width, index / width));
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void SMAStar::resetStatistics() {
+    nodes_expanded_ = 0;
+    nodes_forgotten_ = 0;
+    peak_nodes_ = 0;
+    path_length_ = 0.0;
+    suboptimality_bound_ = 1.0;
+}
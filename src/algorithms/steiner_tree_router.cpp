@@ -0,0 +1,241 @@
+/**
+ * @file steiner_tree_router.cpp
+ * @brief Реализация трассировки сети деревом Такахаши - Мацуямы
+ */
+
+#include "algorithms/steiner_tree_router.h"
+#include "utils/fixed_point_search.h"
+
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+} // namespace
+
+SteinerTreeRouter::SteinerTreeRouter(Grid& grid)
+    : grid_(grid), version_(0), pruning_version_(0), nodes_expanded_(0), total_length_(0.0), route_time_(0.0),
+      terminal_count_(0) {
+    if (static_cast<long long>(grid_.getWidth()) * grid_.getHeight() > (1LL << fixed_point::kNodeBits)) {
+        throw std::invalid_argument("Grid is too large for Steiner tree routing");
+    }
+}
+
+void SteinerTreeRouter::route(const std::vector<std::pair<int, int>>& terminals) {
+    if (terminals.empty()) {
+        throw std::runtime_error("No terminals to route");
+    }
+    reset(terminals[0].first, terminals[0].second);
+    addTerminals(std::vector<std::pair<int, int>>(terminals.begin() + 1, terminals.end()));
+}
+
+void SteinerTreeRouter::reset(int root_x, int root_y) {
+    if (grid_.isObstacle(root_x, root_y)) {
+        throw std::runtime_error("Root terminal is not walkable");
+    }
+    resetStatistics();
+
+    const std::size_t cells = static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight();
+    dist_.assign(cells, fixed_point::kUnreached);
+    parent_.assign(cells, -1);
+    settled_.assign(cells, 0);
+    terminal_.assign(cells, -1);
+    junction_.assign(cells, 0);
+    queue_ = fixed_point::Queue();
+    tree_cells_.clear();
+    tree_edges_.clear();
+    pending_.clear();
+    segments_.clear();
+    connection_order_.assign(1, 0);
+    total_length_ = 0.0;
+    terminal_count_ = 1;
+    version_ = grid_.getVersion();
+    pruning_version_ = grid_.getPruningVersion();
+
+    int root = root_y * grid_.getWidth() + root_x;
+    junction_[root] = 1;
+    addTreeCell(root);
+}
+
+void SteinerTreeRouter::addTerminals(const std::vector<std::pair<int, int>>& terminals) {
+    if (version_ == 0) {
+        throw std::runtime_error("Steiner tree is not started");
+    }
+    // Расстояния в очереди описывают карту и отсечение, при которых начато дерево
+    if (version_ != grid_.getVersion() || pruning_version_ != grid_.getPruningVersion()) {
+        throw std::runtime_error("Map changed since the Steiner tree was started");
+    }
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const int width = grid_.getWidth();
+    for (const auto& terminal : terminals) {
+        int index = terminal_count_++;
+        if (grid_.isObstacle(terminal.first, terminal.second)) {
+            throw std::runtime_error("Terminal is not walkable");
+        }
+        int cell = terminal.second * width + terminal.first;
+        junction_[cell] = 1;
+        if (dist_[cell] == 0) {
+            // Вывод уже лежит на дереве
+            connection_order_.push_back(index);
+        } else if (terminal_[cell] == -1) {
+            terminal_[cell] = index;
+            pending_.push_back(cell);
+        }
+    }
+
+    while (!pending_.empty()) {
+        connectNearest();
+    }
+    buildSegments();
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    route_time_ += std::chrono::duration<double, std::milli>(end_time - start_time).count();
+}
+
+void SteinerTreeRouter::addTreeCell(int cell) {
+    dist_[cell] = 0;
+    parent_[cell] = -1;
+    settled_[cell] = 0;
+    tree_cells_.push_back(cell);
+    queue_.push(static_cast<std::uint64_t>(cell));
+}
+
+void SteinerTreeRouter::connectNearest() {
+    const int width = grid_.getWidth();
+
+    // Вывод, раскрытый прежними шагами, имеет окончательное расстояние,
+    // пока новый путь не приблизил его (тогда выбор повторяется)
+    int best = -1;
+    auto selectSettled = [&]() {
+        best = -1;
+        for (int cell : pending_) {
+            if (settled_[cell] && (best == -1 || dist_[cell] < dist_[best])) {
+                best = cell;
+            }
+        }
+    };
+    selectSettled();
+
+    // Продолжение поиска: раскрытие идет, пока в очереди есть клетки ближе
+    // лучшего найденного вывода. Записи с расстоянием больше текущего устарели
+    while (!queue_.empty()) {
+        if (best != -1 && !settled_[best]) {
+            selectSettled();
+        }
+        std::uint64_t entry = queue_.top();
+        std::uint64_t cost = fixed_point::entryCost(entry);
+        if (best != -1 && dist_[best] <= cost) {
+            break;
+        }
+        queue_.pop();
+        int current = fixed_point::entryCell(entry);
+        if (cost != dist_[current] || settled_[current]) {
+            continue;
+        }
+        settled_[current] = 1;
+        ++nodes_expanded_;
+        if (terminal_[current] != -1) {
+            best = current;
+        }
+
+        int x = current % width;
+        int y = current / width;
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            if (!grid_.canMove(x, y, dx, dy)) {
+                continue;
+            }
+            int next = (y + dy) * width + (x + dx);
+            std::uint64_t candidate = cost + fixed_point::stepCost(dx, dy);
+            if (candidate < dist_[next]) {
+                dist_[next] = candidate;
+                parent_[next] = current;
+                settled_[next] = 0;
+                queue_.push(fixed_point::packEntry(candidate, next));
+            }
+        }
+    }
+
+    if (best == -1) {
+        throw std::runtime_error("Terminal is not reachable from the tree");
+    }
+
+    // Путь от вывода до дерева становится частью дерева; выводы на нем
+    // присоединяются попутно
+    std::vector<int> path;
+    for (int cell = best; dist_[cell] != 0; cell = parent_[cell]) {
+        path.push_back(cell);
+    }
+    int attach = parent_[path.back()];
+    for (std::size_t i = 0; i < path.size(); ++i) {
+        int cell = path[i];
+        int next = i + 1 < path.size() ? path[i + 1] : attach;
+        tree_edges_.emplace_back(cell, next);
+        total_length_ += Node(cell % width, cell / width).calculateMoveCost(Node(next % width, next / width));
+        if (terminal_[cell] != -1) {
+            connection_order_.push_back(terminal_[cell]);
+            terminal_[cell] = -1;
+        }
+        addTreeCell(cell);
+    }
+    pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+                                  [this](int cell) { return dist_[cell] == 0; }),
+                   pending_.end());
+}
+
+void SteinerTreeRouter::buildSegments() {
+    const int width = grid_.getWidth();
+    segments_.clear();
+
+    std::unordered_map<int, std::vector<int>> adjacent;
+    for (const auto& edge : tree_edges_) {
+        adjacent[edge.first].push_back(edge.second);
+        adjacent[edge.second].push_back(edge.first);
+    }
+    auto isEnd = [&](int cell) { return junction_[cell] || adjacent.at(cell).size() != 2; };
+
+    // Каждый отрезок проходится от одного конца: ребро из конца помечается
+    // по соседу, чтобы не пройти тот же отрезок с другой стороны
+    std::unordered_map<int, std::vector<int>> walked;
+    for (const auto& entry : adjacent) {
+        int start = entry.first;
+        if (!isEnd(start)) {
+            continue;
+        }
+        for (int first : entry.second) {
+            auto& done = walked[start];
+            if (std::find(done.begin(), done.end(), first) != done.end()) {
+                continue;
+            }
+            std::vector<Node*> segment{&grid_.getNode(start % width, start / width)};
+            int previous = start;
+            int cell = first;
+            for (;;) {
+                segment.push_back(&grid_.getNode(cell % width, cell / width));
+                if (isEnd(cell)) {
+                    break;
+                }
+                const auto& neighbors = adjacent.at(cell);
+                int next = neighbors[0] == previous ? neighbors[1] : neighbors[0];
+                previous = cell;
+                cell = next;
+            }
+            walked[cell].push_back(previous);
+            segments_.push_back(std::move(segment));
+        }
+    }
+}
+
+void SteinerTreeRouter::resetStatistics() {
+    nodes_expanded_ = 0;
+    route_time_ = 0.0;
+}
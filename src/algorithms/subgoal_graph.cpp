@@ -0,0 +1,578 @@
+/**
+ * @file subgoal_graph.cpp
+ * @brief Реализация простых графов подцелей (SUB)
+ */
+
+#include "algorithms/subgoal_graph.h"
+#include "utils/fixed_point_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <chrono>
+#include <fstream>
+#include <functional>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+const char kMagic[4] = {'S', 'U', 'B', 'G'};
+const std::uint32_t kFormatVersion = 2;
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double moveCost(int dx, int dy) {
+    return (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+}
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(value));
+    return static_cast<bool>(file);
+}
+
+} // namespace
+
+SubgoalGraph::SubgoalGraph(Grid& grid)
+    : grid_(grid), built_(false), nodes_expanded_(0), path_length_(0.0),
+      build_time_(0.0), search_id_(0) {}
+
+double SubgoalGraph::octile(int x0, int y0, int x1, int y1) {
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    return std::abs(dx - dy) + config::DIAGONAL_COST * std::min(dx, dy);
+}
+
+bool SubgoalGraph::isSubgoalCell(int x, int y) const {
+    if (grid_.isBlocked(x, y)) {
+        return false;
+    }
+
+    for (int qy = -1; qy <= 1; qy += 2) {
+        for (int qx = -1; qx <= 1; qx += 2) {
+            if (config::AGENT_RADIUS > 0.5) {
+                // Углы срезать нельзя: подцель - диагональный сосед выпуклого угла
+                if (grid_.isBlocked(x - qx, y - qy) &&
+                    !grid_.isBlocked(x - qx, y) && !grid_.isBlocked(x, y - qy)) {
+                    return true;
+                }
+            } else {
+                // Углы срезать можно: путь огибает угол через ортогональных соседей
+                if (grid_.isBlocked(x - qx, y) && !grid_.isBlocked(x - qx, y + qy)) {
+                    return true;
+                }
+                if (grid_.isBlocked(x, y - qy) && !grid_.isBlocked(x + qx, y - qy)) {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+int SubgoalGraph::createSubgoal(int x, int y) {
+    Subgoal subgoal{x, y, true, x, y, x, y, {}};
+
+    int id;
+    if (!free_subgoals_.empty()) {
+        id = free_subgoals_.back();
+        free_subgoals_.pop_back();
+        subgoals_[id] = std::move(subgoal);
+    } else {
+        id = static_cast<int>(subgoals_.size());
+        subgoals_.push_back(std::move(subgoal));
+    }
+
+    subgoal_at_[y * grid_.getWidth() + x] = id;
+    return id;
+}
+
+void SubgoalGraph::clearEdges(int id) {
+    for (int other : subgoals_[id].edges) {
+        auto& edges = subgoals_[other].edges;
+        edges.erase(std::remove(edges.begin(), edges.end(), id), edges.end());
+    }
+    subgoals_[id].edges.clear();
+}
+
+std::vector<int> SubgoalGraph::directReachable(int x, int y, int target, bool* target_reached, int owner) {
+    const int width = grid_.getWidth();
+    std::vector<int> found;
+    std::vector<char> previous;
+    std::vector<char> current;
+
+    if (target_reached) {
+        *target_reached = false;
+    }
+
+    // Каждый октант просматривается отдельно: ход по основной оси и диагональ
+    // в ту же сторону дают пути ровно октильной длины
+    for (int octant = 0; octant < 8; ++octant) {
+        const int diag_x = (octant & 1) ? -1 : 1;
+        const int diag_y = (octant & 2) ? -1 : 1;
+        const bool x_major = octant < 4;
+        const int major_x = x_major ? diag_x : 0;
+        const int major_y = x_major ? 0 : diag_y;
+
+        auto cellX = [&](int i, int j) { return x + (i - j) * major_x + j * diag_x; };
+        auto cellY = [&](int i, int j) { return y + (i - j) * major_y + j * diag_y; };
+
+        previous.assign(1, 1);
+        for (int i = 1;; ++i) {
+            current.assign(i + 1, 0);
+            bool any = false;
+
+            for (int j = 0; j <= i; ++j) {
+                bool from_major = j < i && previous[j];
+                bool from_diag = j > 0 && previous[j - 1];
+                if (!from_major && !from_diag) {
+                    continue;
+                }
+
+                int px = cellX(i, j);
+                int py = cellY(i, j);
+                if (owner >= 0) {
+                    Subgoal& subgoal = subgoals_[owner];
+                    subgoal.min_x = std::min(subgoal.min_x, px);
+                    subgoal.min_y = std::min(subgoal.min_y, py);
+                    subgoal.max_x = std::max(subgoal.max_x, px);
+                    subgoal.max_y = std::max(subgoal.max_y, py);
+                }
+
+                bool reached = (from_major && grid_.canMove(cellX(i - 1, j), cellY(i - 1, j), major_x, major_y)) ||
+                               (from_diag && grid_.canMove(cellX(i - 1, j - 1), cellY(i - 1, j - 1), diag_x, diag_y));
+                if (!reached) {
+                    continue;
+                }
+
+                int cell = py * width + px;
+                if (cell == target && target_reached) {
+                    *target_reached = true;
+                }
+
+                // Поиск не продолжается сквозь подцели: такие пути покрываются ребрами через них
+                int id = subgoal_at_[cell];
+                if (id != -1) {
+                    found.push_back(id);
+                    continue;
+                }
+
+                current[j] = 1;
+                any = true;
+            }
+
+            if (!any) {
+                break;
+            }
+            previous.swap(current);
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+    return found;
+}
+
+void SubgoalGraph::connectSubgoal(int id, const std::vector<char>& rebuilt) {
+    const Subgoal& subgoal = subgoals_[id];
+    std::vector<int> reachable = directReachable(subgoal.x, subgoal.y, -1, nullptr, id);
+
+    // Отношение симметрично: перестраиваемые соседи добавят ребро сами
+    for (int other : reachable) {
+        if (!rebuilt[other]) {
+            subgoals_[other].edges.push_back(id);
+        }
+    }
+    subgoals_[id].edges = std::move(reachable);
+}
+
+void SubgoalGraph::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+
+    subgoals_.clear();
+    free_subgoals_.clear();
+    subgoal_at_.assign(static_cast<std::size_t>(width) * height, -1);
+
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (isSubgoalCell(x, y)) {
+                createSubgoal(x, y);
+            }
+        }
+    }
+
+    std::vector<char> rebuilt(subgoals_.size(), 1);
+    for (int id = 0; id < static_cast<int>(subgoals_.size()); ++id) {
+        connectSubgoal(id, rebuilt);
+    }
+
+    built_ = true;
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void SubgoalGraph::updateRegion(int x0, int y0, int x1, int y1) {
+    if (!built_) {
+        build();
+        return;
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Статус подцели зависит от соседей, поэтому область расширяется на клетку
+    int left = std::max(0, std::min(x0, x1) - 1);
+    int top = std::max(0, std::min(y0, y1) - 1);
+    int right = std::min(grid_.getWidth() - 1, std::max(x0, x1) + 1);
+    int bottom = std::min(grid_.getHeight() - 1, std::max(y0, y1) + 1);
+
+    for (int y = top; y <= bottom; ++y) {
+        for (int x = left; x <= right; ++x) {
+            int id = subgoal_at_[y * grid_.getWidth() + x];
+            bool should_be = isSubgoalCell(x, y);
+
+            if (id != -1 && !should_be) {
+                clearEdges(id);
+                subgoals_[id].alive = false;
+                subgoal_at_[y * grid_.getWidth() + x] = -1;
+                free_subgoals_.push_back(id);
+            } else if (id == -1 && should_be) {
+                createSubgoal(x, y);
+            }
+        }
+    }
+
+    // Ребра пересчитываются у подцелей, чей просмотренный участок задевает область
+    std::vector<int> affected;
+    std::vector<char> rebuilt(subgoals_.size(), 0);
+    for (int id = 0; id < static_cast<int>(subgoals_.size()); ++id) {
+        const Subgoal& subgoal = subgoals_[id];
+        if (subgoal.alive && subgoal.min_x <= right && subgoal.max_x >= left &&
+            subgoal.min_y <= bottom && subgoal.max_y >= top) {
+            affected.push_back(id);
+            rebuilt[id] = 1;
+        }
+    }
+
+    for (int id : affected) {
+        clearEdges(id);
+        Subgoal& subgoal = subgoals_[id];
+        subgoal.min_x = subgoal.max_x = subgoal.x;
+        subgoal.min_y = subgoal.max_y = subgoal.y;
+    }
+
+    for (int id : affected) {
+        connectSubgoal(id, rebuilt);
+    }
+
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+bool SubgoalGraph::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Индексы живых подцелей уплотняются
+    std::vector<int> compact(subgoals_.size(), -1);
+    std::uint32_t count = 0;
+    for (std::size_t id = 0; id < subgoals_.size(); ++id) {
+        if (subgoals_[id].alive) {
+            compact[id] = static_cast<int>(count++);
+        }
+    }
+
+    // Формат: сигнатура, версия, размеры сетки, хеш карты, число подцелей,
+    // затем для каждой подцели клетка, просмотренный участок и список ребер
+    file.write(kMagic, sizeof(kMagic));
+    writeValue(file, kFormatVersion);
+    writeValue(file, static_cast<std::int32_t>(grid_.getWidth()));
+    writeValue(file, static_cast<std::int32_t>(grid_.getHeight()));
+    writeValue(file, fixed_point::mapHash(grid_));
+    writeValue(file, count);
+
+    for (const Subgoal& subgoal : subgoals_) {
+        if (!subgoal.alive) {
+            continue;
+        }
+        std::int32_t header[6] = {subgoal.x, subgoal.y, subgoal.min_x, subgoal.min_y,
+                                  subgoal.max_x, subgoal.max_y};
+        file.write(reinterpret_cast<const char*>(header), sizeof(header));
+        writeValue(file, static_cast<std::uint32_t>(subgoal.edges.size()));
+        for (int other : subgoal.edges) {
+            writeValue(file, static_cast<std::uint32_t>(compact[other]));
+        }
+    }
+
+    return file.good();
+}
+
+bool SubgoalGraph::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::int32_t width = 0;
+    std::int32_t height = 0;
+    std::uint64_t hash = 0;
+    std::uint32_t count = 0;
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(magic, magic + 4, kMagic) || !readValue(file, version) ||
+        version != kFormatVersion || !readValue(file, width) || !readValue(file, height) ||
+        !readValue(file, hash) || !readValue(file, count) || width != grid_.getWidth() ||
+        height != grid_.getHeight() || hash != fixed_point::mapHash(grid_)) {
+        return false;
+    }
+
+    std::vector<Subgoal> subgoals(count);
+    std::vector<int> subgoal_at(static_cast<std::size_t>(width) * height, -1);
+
+    for (std::uint32_t id = 0; id < count; ++id) {
+        std::int32_t header[6];
+        std::uint32_t edge_count = 0;
+        file.read(reinterpret_cast<char*>(header), sizeof(header));
+        if (!file || !readValue(file, edge_count) || !grid_.isValidCoordinate(header[0], header[1]) ||
+            grid_.isObstacle(header[0], header[1])) {
+            return false;
+        }
+
+        Subgoal& subgoal = subgoals[id];
+        subgoal = Subgoal{header[0], header[1], true, header[2], header[3], header[4], header[5], {}};
+        subgoal.edges.resize(edge_count);
+        for (std::uint32_t e = 0; e < edge_count; ++e) {
+            std::uint32_t other = 0;
+            if (!readValue(file, other) || other >= count) {
+                return false;
+            }
+            subgoal.edges[e] = static_cast<int>(other);
+        }
+        subgoal_at[header[1] * width + header[0]] = static_cast<int>(id);
+    }
+
+    subgoals_ = std::move(subgoals);
+    subgoal_at_ = std::move(subgoal_at);
+    free_subgoals_.clear();
+    built_ = true;
+    return true;
+}
+
+int SubgoalGraph::getSubgoalCount() const {
+    return static_cast<int>(subgoals_.size() - free_subgoals_.size());
+}
+
+int SubgoalGraph::getEdgeCount() const {
+    std::size_t total = 0;
+    for (const Subgoal& subgoal : subgoals_) {
+        if (subgoal.alive) {
+            total += subgoal.edges.size();
+        }
+    }
+    return static_cast<int>(total / 2);
+}
+
+void SubgoalGraph::prepareSearch() {
+    if (stamp_.size() != subgoals_.size()) {
+        stamp_.assign(subgoals_.size(), 0);
+        g_.assign(subgoals_.size(), kInfinity);
+        parent_.assign(subgoals_.size(), -1);
+        goal_edge_.assign(subgoals_.size(), kInfinity);
+        goal_stamp_.assign(subgoals_.size(), 0);
+        search_id_ = 0;
+    }
+
+    if (++search_id_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        std::fill(goal_stamp_.begin(), goal_stamp_.end(), 0);
+        search_id_ = 1;
+    }
+}
+
+void SubgoalGraph::refineSegment(int sx, int sy, int tx, int ty,
+                                 std::vector<std::pair<int, int>>& cells) const {
+    const int diag_x = tx >= sx ? 1 : -1;
+    const int diag_y = ty >= sy ? 1 : -1;
+    const bool x_major = std::abs(tx - sx) >= std::abs(ty - sy);
+    const int major_x = x_major ? diag_x : 0;
+    const int major_y = x_major ? 0 : diag_y;
+    const int n = std::max(std::abs(tx - sx), std::abs(ty - sy));
+    const int m = std::min(std::abs(tx - sx), std::abs(ty - sy));
+
+    auto cellX = [&](int i, int j) { return sx + (i - j) * major_x + j * diag_x; };
+    auto cellY = [&](int i, int j) { return sy + (i - j) * major_y + j * diag_y; };
+
+    // how[i][j]: 0 - недостижимо, 1 - пришли ходом по оси, 2 - по диагонали
+    std::vector<char> how(static_cast<std::size_t>(n + 1) * (m + 1), 0);
+    auto at = [&](int i, int j) -> char& { return how[static_cast<std::size_t>(i) * (m + 1) + j]; };
+    at(0, 0) = 3;
+
+    for (int i = 1; i <= n; ++i) {
+        for (int j = std::max(0, m - (n - i)); j <= std::min(i, m); ++j) {
+            if (j < i && at(i - 1, j) && grid_.canMove(cellX(i - 1, j), cellY(i - 1, j), major_x, major_y)) {
+                at(i, j) = 1;
+            } else if (j > 0 && at(i - 1, j - 1) &&
+                       grid_.canMove(cellX(i - 1, j - 1), cellY(i - 1, j - 1), diag_x, diag_y)) {
+                at(i, j) = 2;
+            }
+        }
+    }
+
+    if (!at(n, m)) {
+        throw std::logic_error("Subgoal graph edge is not h-reachable");
+    }
+
+    std::vector<std::pair<int, int>> segment;
+    for (int i = n, j = m; i > 0;) {
+        segment.emplace_back(cellX(i, j), cellY(i, j));
+        if (at(i, j) == 2) {
+            --j;
+        }
+        --i;
+    }
+    cells.insert(cells.end(), segment.rbegin(), segment.rend());
+}
+
+std::vector<Node*> SubgoalGraph::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    if (!built_) {
+        build();
+    }
+
+    if (start_x == end_x && start_y == end_y) {
+        return {&grid_.getNode(start_x, start_y)};
+    }
+
+    prepareSearch();
+
+    const int width = grid_.getWidth();
+    auto heuristic = [&](int id) {
+        return octile(subgoals_[id].x, subgoals_[id].y, end_x, end_y);
+    };
+
+    // Цель подключается к напрямую h-достижимым подцелям
+    bool direct = false;
+    std::vector<int> goal_neighbors = directReachable(end_x, end_y, start_y * width + start_x, &direct, -1);
+    for (int id : goal_neighbors) {
+        goal_stamp_[id] = search_id_;
+        goal_edge_[id] = octile(subgoals_[id].x, subgoals_[id].y, end_x, end_y);
+    }
+    int goal_subgoal = subgoal_at_[end_y * width + end_x];
+    if (goal_subgoal != -1) {
+        goal_stamp_[goal_subgoal] = search_id_;
+        goal_edge_[goal_subgoal] = 0.0;
+    }
+
+    double best_goal = direct ? octile(start_x, start_y, end_x, end_y) : kInfinity;
+    int goal_parent = -1;
+
+    MinQueue open_list;
+    for (int id : directReachable(start_x, start_y, -1, nullptr, -1)) {
+        stamp_[id] = search_id_;
+        g_[id] = octile(start_x, start_y, subgoals_[id].x, subgoals_[id].y);
+        parent_[id] = -1;
+        open_list.push({g_[id] + heuristic(id), id});
+    }
+
+    while (!open_list.empty()) {
+        auto [f, id] = open_list.top();
+        open_list.pop();
+
+        if (f > g_[id] + heuristic(id) + 1e-9) {
+            continue;
+        }
+        if (f >= best_goal) {
+            break;
+        }
+
+        nodes_expanded_++;
+        if (nodes_expanded_ > config::MAX_PATHFINDING_ITERATIONS) {
+            throw std::runtime_error("Pathfinding exceeded maximum iterations");
+        }
+
+        if (goal_stamp_[id] == search_id_ && g_[id] + goal_edge_[id] < best_goal) {
+            best_goal = g_[id] + goal_edge_[id];
+            goal_parent = id;
+        }
+
+        const Subgoal& subgoal = subgoals_[id];
+        for (int other : subgoal.edges) {
+            double tentative = g_[id] + octile(subgoal.x, subgoal.y, subgoals_[other].x, subgoals_[other].y);
+            if (stamp_[other] != search_id_ || tentative < g_[other] - 1e-9) {
+                stamp_[other] = search_id_;
+                g_[other] = tentative;
+                parent_[other] = id;
+                open_list.push({tentative + heuristic(other), other});
+            }
+        }
+    }
+
+    if (best_goal == kInfinity) {
+        throw std::runtime_error("Path not found");
+    }
+
+    // Опорные точки: старт, подцели, цель; каждый отрезок h-достижим
+    std::vector<std::pair<int, int>> waypoints;
+    waypoints.emplace_back(end_x, end_y);
+    for (int id = goal_parent; id != -1; id = parent_[id]) {
+        waypoints.emplace_back(subgoals_[id].x, subgoals_[id].y);
+    }
+    waypoints.emplace_back(start_x, start_y);
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    std::vector<std::pair<int, int>> cells;
+    cells.emplace_back(start_x, start_y);
+    for (std::size_t i = 1; i < waypoints.size(); ++i) {
+        refineSegment(waypoints[i - 1].first, waypoints[i - 1].second,
+                      waypoints[i].first, waypoints[i].second, cells);
+    }
+
+    std::vector<Node*> path;
+    path.reserve(cells.size());
+    for (const auto& [x, y] : cells) {
+        if (!path.empty()) {
+            path_length_ += moveCost(x - path.back()->x, y - path.back()->y);
+        }
+        path.push_back(&grid_.getNode(x, y));
+    }
+
+    return path;
+}
+
+void SubgoalGraph::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
@@ -11,7 +11,7 @@
 #include <iostream>
 
 ThetaStar::ThetaStar(Grid& grid) 
-    : grid_(grid), nodes_expanded_(0), path_length_(0.0) {}
+    : grid_(grid), nodes_expanded_(0), path_length_(0.0), reached_goal_(-1), los_cache_(nullptr) {}
 
 std::vector<Node*> ThetaStar::findPath(int start_x, int start_y, int end_x, int end_y) {
     // Сброс статистики и данных поиска
@@ -34,10 +34,65 @@ std::vector<Node*> ThetaStar::findPath(int start_x, int start_y, int end_x, int
     if (!end_node.walkable) {
         throw std::runtime_error("End node is not walkable");
     }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+    
+    return search(start_node,
+                  [end_x, end_y](const Node& node) { return node.x == end_x && node.y == end_y; },
+                  [this, &end_node](const Node& node) { return heuristic(node, end_node); },
+                  &end_node);
+}
+
+std::vector<Node*> ThetaStar::findPathToAny(int start_x, int start_y, const std::vector<std::pair<int, int>>& goals) {
+    resetStatistics();
+    grid_.resetSearchData();
     
+    if (!grid_.isValidCoordinate(start_x, start_y)) {
+        throw std::runtime_error("Invalid start coordinates");
+    }
+    Node& start_node = grid_.getNode(start_x, start_y);
+    if (!start_node.walkable) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+    
+    // Старт уже среди целей: путь из одной клетки, поиск не нужен
+    for (std::size_t i = 0; i < goals.size(); ++i) {
+        if (goals[i].first == start_x && goals[i].second == start_y) {
+            reached_goal_ = static_cast<int>(i);
+            return {&start_node};
+        }
+    }
+
+    // Цели вне компоненты старта только ослабили бы эвристику
+    std::vector<std::pair<int, int>> reachable;
+    std::vector<int> origin;
+    for (std::size_t i = 0; i < goals.size(); ++i) {
+        if (grid_.isReachable(start_x, start_y, goals[i].first, goals[i].second)) {
+            reachable.push_back(goals[i]);
+            origin.push_back(static_cast<int>(i));
+        }
+    }
+    if (reachable.empty()) {
+        throw std::runtime_error("Path not found");
+    }
+    
+    GoalSet goal_set(grid_, reachable);
+    auto path = search(start_node,
+                       [&goal_set](const Node& node) { return goal_set.find(node.x, node.y) != -1; },
+                       [&goal_set](const Node& node) { return goal_set.estimateAnyAngle(node); },
+                       nullptr);
+    reached_goal_ = origin[goal_set.find(path.back()->x, path.back()->y)];
+    return path;
+}
+
+template<typename GoalTest, typename Estimate>
+std::vector<Node*> ThetaStar::search(Node& start_node, const GoalTest& is_goal, const Estimate& estimate, Node* target) {
     // Инициализация начального узла
     start_node.g_cost = 0.0;
-    start_node.h_cost = start_node.calculateHeuristic(end_node);
+    start_node.h_cost = estimate(start_node);
     start_node.f_cost = start_node.g_cost + start_node.h_cost;
     start_node.parent = nullptr; // Старт не имеет родителя
     
@@ -63,7 +118,7 @@ std::vector<Node*> ThetaStar::findPath(int start_x, int start_y, int end_x, int
         open_set_members.erase(current_node);
         
         // Если достигли цели, восстанавливаем путь
-        if (current_node->x == end_x && current_node->y == end_y) {
+        if (is_goal(*current_node)) {
             auto path = reconstructPath(current_node);
             if (path.empty() || path.size() < 2) {
                 throw std::runtime_error("Invalid path found");
@@ -84,12 +139,12 @@ std::vector<Node*> ThetaStar::findPath(int start_x, int start_y, int end_x, int
             }
             
             // Theta*: специальная процедура обновления вершины
-            updateVertex(current_node, neighbor, &end_node);
+            updateVertex(current_node, neighbor, target);
             
             // Если сосед не в открытом множестве, добавляем его
             if (open_set_members.find(neighbor) == open_set_members.end()) {
                 // Пересчитываем эвристику для точности
-                neighbor->h_cost = neighbor->calculateHeuristic(end_node);
+                neighbor->h_cost = estimate(*neighbor);
                 neighbor->f_cost = neighbor->g_cost + config::HEURISTIC_WEIGHT * neighbor->h_cost;
                 open_set_members.insert(neighbor);
                 open_set.push(neighbor);
@@ -109,7 +164,7 @@ void ThetaStar::updateVertex(Node* current, Node* neighbor, Node* end_node) {
     
     // Theta* должен сначала проверять прямую видимость от родителя
     if (current->parent != nullptr) {
-        if (line_of_sight::hasLineOfSight(grid_, *current->parent, *neighbor)) {
+        if (hasLineOfSight(*current->parent, *neighbor)) {
             double direct_cost = current->parent->g_cost + 
                                current->parent->calculateMoveCost(*neighbor);
             
@@ -189,4 +244,5 @@ double ThetaStar::calculatePathLength(const std::vector<Node*>& path) const {
 void ThetaStar::resetStatistics() {
     nodes_expanded_ = 0;
     path_length_ = 0.0;
+    reached_goal_ = -1;
 }
\ No newline at end of file
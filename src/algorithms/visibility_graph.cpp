@@ -0,0 +1,291 @@
+/**
+ * @file visibility_graph.cpp
+ * @brief Реализация графа видимости по углам препятствий
+ */
+
+#include "algorithms/visibility_graph.h"
+#include "utils/line_of_sight.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <string>
+
+namespace {
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+// Флаг маски углов: клетка у конца стены, касательность не проверяется
+const std::uint8_t kWallEnd = 1u << 4;
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double euclidean(int x0, int y0, int x1, int y1) {
+    double dx = static_cast<double>(x1 - x0);
+    double dy = static_cast<double>(y1 - y0);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace
+
+VisibilityGraph::VisibilityGraph(Grid& grid, unsigned threads)
+    : grid_(grid), threads_(threads), built_(false), nodes_expanded_(0), path_length_(0.0),
+      build_time_(0.0), edge_count_(0), search_id_(0) {
+    if (threads_ == 0) {
+        threads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+std::uint8_t VisibilityGraph::cornerMask(int x, int y) const {
+    if (grid_.isObstacle(x, y)) {
+        return 0;
+    }
+
+    std::uint8_t mask = 0;
+    for (int qy = -1; qy <= 1; qy += 2) {
+        for (int qx = -1; qx <= 1; qx += 2) {
+            // Препятствие в клетке (x - qx, y - qy), обе общие с ним соседние клетки свободны
+            if (grid_.isValidCoordinate(x - qx, y - qy) && grid_.isObstacle(x - qx, y - qy) &&
+                !grid_.isObstacle(x - qx, y) && !grid_.isObstacle(x, y - qy)) {
+                mask |= static_cast<std::uint8_t>(1u << ((qx > 0 ? 1 : 0) | (qy > 0 ? 2 : 0)));
+            }
+            // Конец стены рядом с клеткой: дискретная видимость и срезание углов
+            // требуют поворотов и у ортогональных соседей угла
+            if ((grid_.isValidCoordinate(x - qx, y) && grid_.isObstacle(x - qx, y) &&
+                 !grid_.isObstacle(x - qx, y + qy)) ||
+                (grid_.isValidCoordinate(x, y - qy) && grid_.isObstacle(x, y - qy) &&
+                 !grid_.isObstacle(x + qx, y - qy))) {
+                mask |= kWallEnd;
+            }
+        }
+    }
+    return mask;
+}
+
+bool VisibilityGraph::isTangent(const Vertex& vertex, int dx, int dy) const {
+    if (vertex.corners & kWallEnd) {
+        return true;
+    }
+
+    // Ребро, уходящее строго в квадрант от препятствия, огибает угол "наружу"
+    for (int bit = 0; bit < 4; ++bit) {
+        if (!(vertex.corners & (1u << bit))) {
+            continue;
+        }
+        int qx = (bit & 1) ? 1 : -1;
+        int qy = (bit & 2) ? 1 : -1;
+        if (!(dx * qx > 0 && dy * qy > 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool VisibilityGraph::isVisible(int x0, int y0, int x1, int y1) const {
+    // Соседние клетки соединяются обычным ходом сетки, как в ThetaStar
+    if (std::abs(x1 - x0) <= 1 && std::abs(y1 - y0) <= 1) {
+        return grid_.canMove(x0, y0, x1 - x0, y1 - y0);
+    }
+    return line_of_sight::isPathClear(grid_, x0, y0, x1, y1);
+}
+
+void VisibilityGraph::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    vertices_.clear();
+    edge_count_ = 0;
+    built_ = false;
+
+    for (int y = 0; y < grid_.getHeight(); ++y) {
+        for (int x = 0; x < grid_.getWidth(); ++x) {
+            std::uint8_t corners = cornerMask(x, y);
+            if (corners) {
+                vertices_.push_back({x, y, corners, {}});
+            }
+        }
+    }
+
+    if (static_cast<int>(vertices_.size()) > config::VISIBILITY_MAX_VERTICES) {
+        int count = static_cast<int>(vertices_.size());
+        vertices_.clear();
+        throw std::runtime_error("Visibility graph exceeds vertex limit (" + std::to_string(count) + " corners)");
+    }
+
+    // Пары (i, j > i) делятся между потоками через одну вершину, чтобы уравнять нагрузку
+    const int count = static_cast<int>(vertices_.size());
+    const unsigned workers = std::min<unsigned>(threads_, std::max(1, count));
+    std::vector<std::vector<std::pair<int, int>>> found(workers);
+
+    auto worker = [&](unsigned index) {
+        for (int i = static_cast<int>(index); i < count; i += static_cast<int>(workers)) {
+            const Vertex& a = vertices_[i];
+            for (int j = i + 1; j < count; ++j) {
+                const Vertex& b = vertices_[j];
+                if (!isTangent(a, b.x - a.x, b.y - a.y) || !isTangent(b, a.x - b.x, a.y - b.y)) {
+                    continue;
+                }
+                // isPathClear несимметрична, поэтому ребра хранятся по направлениям
+                if (isVisible(a.x, a.y, b.x, b.y)) {
+                    found[index].emplace_back(i, j);
+                }
+                if (isVisible(b.x, b.y, a.x, a.y)) {
+                    found[index].emplace_back(j, i);
+                }
+            }
+        }
+    };
+
+    // Проверки видимости читают таблицу сумм и длины свободных отрезков из всех потоков
+    grid_.refreshObstacleCounts();
+    grid_.refreshFreeRuns();
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < workers; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (const auto& edges : found) {
+        for (const auto& [a, b] : edges) {
+            double cost = euclidean(vertices_[a].x, vertices_[a].y, vertices_[b].x, vertices_[b].y);
+            vertices_[a].edges.push_back({b, cost});
+            edge_count_++;
+        }
+    }
+
+    stamp_.assign(vertices_.size(), 0);
+    g_.assign(vertices_.size(), kInfinity);
+    parent_.assign(vertices_.size(), -1);
+    goal_edge_.assign(vertices_.size(), kInfinity);
+    search_id_ = 0;
+
+    built_ = true;
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+std::vector<Node*> VisibilityGraph::findPath(int start_x, int start_y, int end_x, int end_y) {
+    resetStatistics();
+
+    if (!grid_.isValidCoordinate(start_x, start_y) || !grid_.isValidCoordinate(end_x, end_y)) {
+        throw std::runtime_error("Invalid start or end coordinates");
+    }
+
+    if (grid_.isObstacle(start_x, start_y)) {
+        throw std::runtime_error("Start node is not walkable");
+    }
+
+    if (grid_.isObstacle(end_x, end_y)) {
+        throw std::runtime_error("End node is not walkable");
+    }
+
+    // Клетки в разных компонентах связности: поиск заведомо безуспешен
+    if (!grid_.isReachable(start_x, start_y, end_x, end_y)) {
+        throw std::runtime_error("Path not found");
+    }
+
+    if (!built_) {
+        build();
+    }
+
+    Node* start_node = &grid_.getNode(start_x, start_y);
+    Node* end_node = &grid_.getNode(end_x, end_y);
+
+    if (start_x == end_x && start_y == end_y) {
+        return {start_node};
+    }
+
+    if (isVisible(start_x, start_y, end_x, end_y)) {
+        path_length_ = euclidean(start_x, start_y, end_x, end_y);
+        return {start_node, end_node};
+    }
+
+    if (++search_id_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        search_id_ = 1;
+    }
+
+    // Старт и цель подключаются временно: ребра к цели хранятся отдельно
+    MinQueue open_list;
+    const int count = static_cast<int>(vertices_.size());
+    for (int id = 0; id < count; ++id) {
+        const Vertex& vertex = vertices_[id];
+        goal_edge_[id] = isTangent(vertex, end_x - vertex.x, end_y - vertex.y) &&
+                                 isVisible(vertex.x, vertex.y, end_x, end_y)
+                             ? euclidean(vertex.x, vertex.y, end_x, end_y)
+                             : kInfinity;
+
+        if (isTangent(vertex, start_x - vertex.x, start_y - vertex.y) &&
+            isVisible(start_x, start_y, vertex.x, vertex.y)) {
+            stamp_[id] = search_id_;
+            g_[id] = euclidean(start_x, start_y, vertex.x, vertex.y);
+            parent_[id] = -1;
+            open_list.push({g_[id] + euclidean(vertex.x, vertex.y, end_x, end_y), id});
+        }
+    }
+
+    double best_goal = kInfinity;
+    int goal_parent = -1;
+
+    while (!open_list.empty()) {
+        auto [f, id] = open_list.top();
+        open_list.pop();
+
+        const Vertex& vertex = vertices_[id];
+        if (f > g_[id] + euclidean(vertex.x, vertex.y, end_x, end_y) + 1e-9) {
+            continue;
+        }
+        if (f >= best_goal) {
+            break;
+        }
+
+        nodes_expanded_++;
+        if (nodes_expanded_ > config::MAX_PATHFINDING_ITERATIONS) {
+            throw std::runtime_error("Pathfinding exceeded maximum iterations");
+        }
+
+        if (g_[id] + goal_edge_[id] < best_goal) {
+            best_goal = g_[id] + goal_edge_[id];
+            goal_parent = id;
+        }
+
+        for (const Edge& edge : vertex.edges) {
+            double tentative = g_[id] + edge.cost;
+            if (stamp_[edge.to] != search_id_ || tentative < g_[edge.to] - 1e-9) {
+                const Vertex& next = vertices_[edge.to];
+                stamp_[edge.to] = search_id_;
+                g_[edge.to] = tentative;
+                parent_[edge.to] = id;
+                open_list.push({tentative + euclidean(next.x, next.y, end_x, end_y), edge.to});
+            }
+        }
+    }
+
+    if (best_goal == kInfinity) {
+        throw std::runtime_error("Path not found");
+    }
+
+    std::vector<Node*> path;
+    path.push_back(end_node);
+    for (int id = goal_parent; id != -1; id = parent_[id]) {
+        path.push_back(&grid_.getNode(vertices_[id].x, vertices_[id].y));
+    }
+    path.push_back(start_node);
+    std::reverse(path.begin(), path.end());
+
+    path_length_ = best_goal;
+    return path;
+}
+
+void VisibilityGraph::resetStatistics() {
+    nodes_expanded_ = 0;
+    path_length_ = 0.0;
+}
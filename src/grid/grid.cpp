@@ -8,13 +8,27 @@
 
 #include <cmath>
 #include <algorithm>
+#include <numeric>
+#include <thread>
+#include <atomic>
+
+namespace {
+
+// Общий счетчик версий: разные сетки и состояния никогда не получают одну версию
+std::atomic<std::uint64_t> next_map_version{1};
+
+} // namespace
 
 Grid::Grid(int width, int height) 
-    : width_(width), height_(height) {
+    : width_(width), height_(height), components_valid_(false), sums_dirty_x_(0), sums_dirty_y_(0),
+      occupancy_stride_(0), version_(next_map_version.fetch_add(1, std::memory_order_relaxed)),
+      pruning_version_(0) {
     initializeGrid();
 }
 
 void Grid::initializeGrid() {
+    occupancy_stride_ = (width_ + 63) / 64;
+    occupancy_.assign(static_cast<std::size_t>(occupancy_stride_) * height_, 0);
     nodes_.resize(height_);
     for (int y = 0; y < height_; ++y) {
         nodes_[y].reserve(width_);
@@ -22,6 +36,12 @@ void Grid::initializeGrid() {
             nodes_[y].emplace_back(x, y, true);
         }
     }
+    
+    // Отрезки считаются при первом запросе
+    free_runs_.assign(static_cast<std::size_t>(width_) * height_ * 8, 0);
+    run_line_dirty_.assign(static_cast<std::size_t>(width_) + height_ + 2 * (width_ + height_ - 1), 1);
+    dirty_run_lines_.resize(run_line_dirty_.size());
+    std::iota(dirty_run_lines_.begin(), dirty_run_lines_.end(), 0);
 }
 
 Node& Grid::getNode(int x, int y) {
@@ -44,13 +64,48 @@ bool Grid::isValidCoordinate(int x, int y) const {
 
 void Grid::setObstacle(int x, int y) {
     if (isValidCoordinate(x, y)) {
+        bool was_walkable = nodes_[y][x].walkable;
         nodes_[y][x].walkable = false;
+        if (was_walkable) {
+            markObstacleChanged(x, y);
+        }
+        
+        // Препятствие, не разрезающее окрестность, не меняет остальные метки
+        if (was_walkable && components_valid_ && mayDisconnect(x, y)) {
+            components_valid_ = false;
+        }
     }
 }
 
 void Grid::clearObstacle(int x, int y) {
     if (isValidCoordinate(x, y)) {
+        bool was_walkable = nodes_[y][x].walkable;
         nodes_[y][x].walkable = true;
+        if (!was_walkable) {
+            markObstacleChanged(x, y);
+        }
+        
+        if (was_walkable || !components_valid_) {
+            return;
+        }
+        
+        // Освобожденная клетка получает новый элемент и сливается с соседями;
+        // старый элемент мог остаться корнем для других клеток
+        if (component_parent_.size() >= 2 * component_node_.size()) {
+            components_valid_ = false;
+            return;
+        }
+        int cell = y * width_ + x;
+        component_node_[cell] = static_cast<int>(component_parent_.size());
+        component_parent_.push_back(component_node_[cell]);
+        
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if ((dx != 0 || dy != 0) && isMoveOpen(x, y, dx, dy)) {
+                    uniteCells(cell, (y + dy) * width_ + (x + dx));
+                }
+            }
+        }
     }
 }
 
@@ -71,6 +126,8 @@ void Grid::inflateObstacles(double agent_radius) {
         }
     }
     
+    components_valid_ = false;
+    
     // Вычисляем радиус для инфляции в клетках
     int inflation_radius = static_cast<int>(std::ceil(agent_radius + config::SAFETY_MARGIN));
     
@@ -87,8 +144,10 @@ void Grid::inflateObstacles(double agent_radius) {
                         if (isValidCoordinate(new_x, new_y)) {
                             // Проверяем расстояние для круговой инфляции
                             double distance = std::sqrt(dx*dx + dy*dy);
-                            if (distance <= agent_radius + config::SAFETY_MARGIN) {
+                            if (distance <= agent_radius + config::SAFETY_MARGIN &&
+                                nodes_[new_y][new_x].walkable) {
                                 nodes_[new_y][new_x].walkable = false;
+                                markObstacleChanged(new_x, new_y);
                             }
                         }
                     }
@@ -106,6 +165,31 @@ void Grid::resetSearchData() {
     }
 }
 
+bool Grid::canMove(int x, int y, int dx, int dy) const {
+    return isMoveOpen(x, y, dx, dy) && !nodes_[y + dy][x + dx].pruned && !nodes_[y + dy][x + dx].reserved;
+}
+
+bool Grid::isMoveOpen(int x, int y, int dx, int dy) const {
+    int new_x = x + dx;
+    int new_y = y + dy;
+    
+    if (!isValidCoordinate(new_x, new_y) || !nodes_[new_y][new_x].walkable) {
+        return false;
+    }
+    
+    if (dx != 0 && dy != 0) {
+        if (!config::ALLOW_DIAGONAL_MOVEMENT) {
+            return false;
+        }
+        // Те же правила "срезания углов", что и в getNeighbors()
+        if (config::AGENT_RADIUS > 0.5) {
+            return nodes_[y + dy][x].walkable && nodes_[y][x + dx].walkable;
+        }
+    }
+    
+    return true;
+}
+
 std::vector<Node*> Grid::getNeighbors(const Node& node) {
     std::vector<Node*> neighbors;
     neighbors.reserve(8); // Максимум 8 соседей
@@ -130,7 +214,8 @@ std::vector<Node*> Grid::getNeighbors(const Node& node) {
         int new_x = node.x + dx;
         int new_y = node.y + dy;
         
-        if (isValidCoordinate(new_x, new_y) && nodes_[new_y][new_x].walkable) {
+        if (isValidCoordinate(new_x, new_y) && nodes_[new_y][new_x].walkable &&
+            !nodes_[new_y][new_x].pruned && !nodes_[new_y][new_x].reserved) {
             neighbors.push_back(&nodes_[new_y][new_x]);
         }
     }
@@ -143,7 +228,8 @@ std::vector<Node*> Grid::getNeighbors(const Node& node) {
             
             // Проверяем, что целевая клетка доступна
             // и соседние ортогональные клетки не блокируют диагональный проход
-            if (isValidCoordinate(new_x, new_y) && nodes_[new_y][new_x].walkable) {
+            if (isValidCoordinate(new_x, new_y) && nodes_[new_y][new_x].walkable &&
+                !nodes_[new_y][new_x].pruned && !nodes_[new_y][new_x].reserved) {
                 bool can_move_diagonal = true;
                 
                 // Проверяем соседние клетки, чтобы избежать "срезания углов"
@@ -160,4 +246,324 @@ std::vector<Node*> Grid::getNeighbors(const Node& node) {
     }
     
     return neighbors;
-}
\ No newline at end of file
+}
+
+bool Grid::mayDisconnect(int x, int y) const {
+    // Свободные клетки кольца вокруг (x, y) должны оставаться связными
+    // ходами внутри кольца; иначе компонента, возможно, распалась
+    static const int ring[8][2] = {
+        {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}
+    };
+    
+    int group[8];
+    int free_count = 0;
+    for (int i = 0; i < 8; ++i) {
+        group[i] = isObstacle(x + ring[i][0], y + ring[i][1]) ? -1 : i;
+        if (group[i] != -1) {
+            ++free_count;
+        }
+    }
+    if (free_count <= 1) {
+        return false;
+    }
+    
+    // Слияние групп по ходам между клетками кольца до стабилизации
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                if (group[i] == -1 || group[j] == -1 || group[i] == group[j]) {
+                    continue;
+                }
+                int dx = ring[j][0] - ring[i][0];
+                int dy = ring[j][1] - ring[i][1];
+                if (std::abs(dx) <= 1 && std::abs(dy) <= 1 &&
+                    isMoveOpen(x + ring[i][0], y + ring[i][1], dx, dy)) {
+                    int merged = std::min(group[i], group[j]);
+                    int replaced = std::max(group[i], group[j]);
+                    for (int k = 0; k < 8; ++k) {
+                        if (group[k] == replaced) {
+                            group[k] = merged;
+                        }
+                    }
+                    changed = true;
+                }
+            }
+        }
+    }
+    
+    int first = -1;
+    for (int i = 0; i < 8; ++i) {
+        if (group[i] == -1) {
+            continue;
+        }
+        if (first == -1) {
+            first = group[i];
+        } else if (group[i] != first) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Grid::rebuildComponents() const {
+    const int cells = width_ * height_;
+    component_node_.resize(cells);
+    component_parent_.resize(cells);
+    std::iota(component_node_.begin(), component_node_.end(), 0);
+    std::iota(component_parent_.begin(), component_parent_.end(), 0);
+    
+    // Достаточно ходов "вперед": обратные ходы дают те же пары
+    static const int forward[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            if (!nodes_[y][x].walkable) {
+                continue;
+            }
+            for (const auto& direction : forward) {
+                if (isMoveOpen(x, y, direction[0], direction[1])) {
+                    uniteCells(y * width_ + x, (y + direction[1]) * width_ + (x + direction[0]));
+                }
+            }
+        }
+    }
+    
+    // Сжатие: после пересчета корень находится за одно обращение
+    for (int cell = 0; cell < cells; ++cell) {
+        component_parent_[cell] = findComponent(cell);
+    }
+    components_valid_ = true;
+}
+
+int Grid::findComponent(int element) const {
+    while (component_parent_[element] != element) {
+        component_parent_[element] = component_parent_[component_parent_[element]];
+        element = component_parent_[element];
+    }
+    return element;
+}
+
+void Grid::uniteCells(int cell_a, int cell_b) const {
+    int root_a = findComponent(component_node_[cell_a]);
+    int root_b = findComponent(component_node_[cell_b]);
+    if (root_a != root_b) {
+        component_parent_[std::max(root_a, root_b)] = std::min(root_a, root_b);
+    }
+}
+
+int Grid::getComponent(int x, int y) const {
+    if (isObstacle(x, y)) {
+        return -1;
+    }
+    if (!components_valid_) {
+        rebuildComponents();
+    }
+    return findComponent(component_node_[y * width_ + x]);
+}
+
+bool Grid::isReachable(int start_x, int start_y, int end_x, int end_y) const {
+    int start_component = getComponent(start_x, start_y);
+    return start_component != -1 && start_component == getComponent(end_x, end_y);
+}
+
+void Grid::setPruned(int x, int y, bool pruned) {
+    if (isValidCoordinate(x, y) && nodes_[y][x].pruned != pruned) {
+        nodes_[y][x].pruned = pruned;
+        pruning_version_ = next_map_version.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Grid::isPruned(int x, int y) const {
+    return isValidCoordinate(x, y) && nodes_[y][x].pruned;
+}
+
+bool Grid::isBlocked(int x, int y) const {
+    if (!isValidCoordinate(x, y)) {
+        return true;
+    }
+    const Node& node = nodes_[y][x];
+    return !node.walkable || node.pruned || node.reserved;
+}
+
+void Grid::clearPruned() {
+    bool changed = false;
+    for (auto& row : nodes_) {
+        for (auto& node : row) {
+            changed = changed || node.pruned;
+            node.pruned = false;
+        }
+    }
+    if (changed) {
+        pruning_version_ = next_map_version.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Grid::setReserved(int x, int y, bool reserved) {
+    if (isValidCoordinate(x, y) && nodes_[y][x].reserved != reserved) {
+        nodes_[y][x].reserved = reserved;
+        pruning_version_ = next_map_version.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Grid::isReserved(int x, int y) const {
+    return isValidCoordinate(x, y) && nodes_[y][x].reserved;
+}
+
+void Grid::markObstacleChanged(int x, int y) {
+    std::uint64_t bit = std::uint64_t{1} << (x & 63);
+    std::uint64_t& word = occupancy_[static_cast<std::size_t>(y) * occupancy_stride_ + (x >> 6)];
+    word = nodes_[y][x].walkable ? (word & ~bit) : (word | bit);
+    version_ = next_map_version.fetch_add(1, std::memory_order_relaxed);
+    
+    sums_dirty_x_ = std::min(sums_dirty_x_, x);
+    sums_dirty_y_ = std::min(sums_dirty_y_, y);
+    
+    markFreeRunsDirty(x, y);
+}
+
+void Grid::markFreeRunsDirty(int x, int y) {
+    // Линии: строки, затем столбцы, диагонали (x - y) и антидиагонали (x + y)
+    const int lines[4] = {
+        y,
+        height_ + x,
+        height_ + width_ + (x - y + height_ - 1),
+        height_ + width_ + (width_ + height_ - 1) + (x + y)
+    };
+    for (int line : lines) {
+        if (!run_line_dirty_[line]) {
+            run_line_dirty_[line] = 1;
+            dirty_run_lines_.push_back(line);
+        }
+    }
+}
+
+void Grid::refreshFreeRuns() const {
+    const int diagonals = width_ + height_ - 1;
+    for (int line : dirty_run_lines_) {
+        if (line < height_) {
+            sweepFreeRuns(0, line, 1, 0);
+        } else if ((line -= height_) < width_) {
+            sweepFreeRuns(line, 0, 0, 1);
+        } else if ((line -= width_) < diagonals) {
+            int offset = line - (height_ - 1);
+            sweepFreeRuns(std::max(offset, 0), std::max(-offset, 0), 1, 1);
+        } else {
+            int sum = line - diagonals;
+            int y = std::max(0, sum - (width_ - 1));
+            sweepFreeRuns(sum - y, y, -1, 1);
+        }
+    }
+    std::fill(run_line_dirty_.begin(), run_line_dirty_.end(), 0);
+    dirty_run_lines_.clear();
+}
+
+void Grid::sweepFreeRuns(int x, int y, int dx, int dy) const {
+    int length = 0;
+    while (isValidCoordinate(x + dx * length, y + dy * length)) {
+        ++length;
+    }
+    
+    // Отрезок клетки продолжает отрезок следующей клетки линии: проход с конца
+    // дает направление (dx, dy), проход с начала - противоположное
+    const int forward = runDirection(dx, dy);
+    const int backward = runDirection(-dx, -dy);
+    auto cell = [&](int i) {
+        return &free_runs_[(static_cast<std::size_t>(y + dy * i) * width_ + (x + dx * i)) * 8];
+    };
+    int run = 0;
+    for (int i = length - 1; i >= 0; --i) {
+        run = nodes_[y + dy * i][x + dx * i].walkable ? std::min(kMaxFreeRun, run + 1) : 0;
+        cell(i)[forward] = static_cast<std::uint16_t>(run);
+    }
+    run = 0;
+    for (int i = 0; i < length; ++i) {
+        run = nodes_[y + dy * i][x + dx * i].walkable ? std::min(kMaxFreeRun, run + 1) : 0;
+        cell(i)[backward] = static_cast<std::uint16_t>(run);
+    }
+}
+
+void Grid::refreshObstacleCounts() const {
+    if (sums_dirty_x_ >= width_ || sums_dirty_y_ >= height_) {
+        return;
+    }
+    
+    const int stride = width_ + 1;
+    if (obstacle_sums_.empty()) {
+        obstacle_sums_.assign(static_cast<std::size_t>(stride) * (height_ + 1), 0);
+    }
+    const int x0 = sums_dirty_x_;
+    const int y0 = sums_dirty_y_;
+    
+    // Строки и столбцы устаревшей части обрабатываются независимо,
+    // поэтому большие таблицы пересчитываются полосами в нескольких потоках
+    unsigned workers = 1;
+    if (static_cast<long long>(width_ - x0) * (height_ - y0) >= config::OBSTACLE_SUMS_PARALLEL_CELLS) {
+        workers = config::OBSTACLE_SUMS_THREADS != 0 ? config::OBSTACLE_SUMS_THREADS
+                                                     : std::max(1u, std::thread::hardware_concurrency());
+    }
+    auto parallel = [workers](int begin, int end, const auto& body) {
+        int chunk = (end - begin + static_cast<int>(workers) - 1) / static_cast<int>(workers);
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < workers && begin + static_cast<int>(t) * chunk < end; ++t) {
+            int from = begin + static_cast<int>(t) * chunk;
+            pool.emplace_back(body, from, std::min(end, from + chunk));
+        }
+        body(begin, std::min(end, begin + chunk));
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    };
+    
+    // Проход по строкам: суммы строки, продолженные от неизменного столбца x0
+    parallel(y0, height_, [&](int from, int to) {
+        for (int y = from; y < to; ++y) {
+            int* row = &obstacle_sums_[static_cast<std::size_t>(y + 1) * stride];
+            const int* above = &obstacle_sums_[static_cast<std::size_t>(y) * stride];
+            int sum = row[x0] - above[x0];
+            for (int x = x0; x < width_; ++x) {
+                sum += nodes_[y][x].walkable ? 0 : 1;
+                row[x + 1] = sum;
+            }
+        }
+    });
+    
+    // Проход по столбцам: накопление сверху вниз от неизменной строки y0
+    parallel(x0, width_, [&](int from, int to) {
+        for (int y = y0; y < height_; ++y) {
+            int* row = &obstacle_sums_[static_cast<std::size_t>(y + 1) * stride];
+            const int* above = &obstacle_sums_[static_cast<std::size_t>(y) * stride];
+            for (int x = from; x < to; ++x) {
+                row[x + 1] += above[x + 1];
+            }
+        }
+    });
+    
+    sums_dirty_x_ = width_;
+    sums_dirty_y_ = height_;
+}
+
+int Grid::countObstacles(int x0, int y0, int x1, int y1) const {
+    if (x0 > x1) {
+        std::swap(x0, x1);
+    }
+    if (y0 > y1) {
+        std::swap(y0, y1);
+    }
+    
+    // Часть прямоугольника вне сетки целиком занята
+    int cx0 = std::max(x0, 0);
+    int cy0 = std::max(y0, 0);
+    int cx1 = std::min(x1, width_ - 1);
+    int cy1 = std::min(y1, height_ - 1);
+    int outside = (x1 - x0 + 1) * (y1 - y0 + 1);
+    if (cx0 > cx1 || cy0 > cy1) {
+        return outside;
+    }
+    outside -= (cx1 - cx0 + 1) * (cy1 - cy0 + 1);
+    
+    refreshObstacleCounts();
+    const int stride = width_ + 1;
+    return outside + obstacle_sums_[(cy1 + 1) * stride + cx1 + 1] - obstacle_sums_[cy0 * stride + cx1 + 1] -
+           obstacle_sums_[(cy1 + 1) * stride + cx0] + obstacle_sums_[cy0 * stride + cx0];
+}
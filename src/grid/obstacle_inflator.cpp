@@ -0,0 +1,137 @@
+/**
+ * @file obstacle_inflator.cpp
+ * @brief Реализация слоя временных препятствий
+ */
+
+#include "grid/obstacle_inflator.h"
+
+#include <cmath>
+#include <stdexcept>
+
+ObstacleInflator::ObstacleInflator(Grid& grid, double radius)
+    : grid_(grid), radius_(radius),
+      coverage_(static_cast<std::size_t>(grid.getWidth()) * grid.getHeight(), 0),
+      owned_(static_cast<std::size_t>(grid.getWidth()) * grid.getHeight(), 0),
+      exempt_(static_cast<std::size_t>(grid.getWidth()) * grid.getHeight(), 0),
+      toggled_cells_(0) {
+    if (radius < 0.0) {
+        throw std::invalid_argument("Inflation radius must be non-negative");
+    }
+    // Круг того же вида, что у Grid::inflateObstacles
+    int reach = static_cast<int>(std::floor(radius));
+    for (int dy = -reach; dy <= reach; ++dy) {
+        for (int dx = -reach; dx <= reach; ++dx) {
+            if (std::sqrt(dx * dx + dy * dy) <= radius) {
+                offsets_.emplace_back(dx, dy);
+            }
+        }
+    }
+}
+
+ObstacleInflator::~ObstacleInflator() {
+    clear();
+}
+
+void ObstacleInflator::updateCell(std::size_t cell) {
+    const int width = grid_.getWidth();
+    const int x = static_cast<int>(cell % width);
+    const int y = static_cast<int>(cell / width);
+    // Клетку, уже закрытую картой или чужим резервом, слой не присваивает
+    bool closed = coverage_[cell] > 0 && !exempt_[cell];
+    if (closed && !owned_[cell] && !grid_.isObstacle(x, y) && !grid_.isReserved(x, y)) {
+        owned_[cell] = 1;
+        toggleCell(x, y, true);
+    } else if (!closed && owned_[cell]) {
+        owned_[cell] = 0;
+        toggleCell(x, y, false);
+    }
+}
+
+void ObstacleInflator::toggleCell(int x, int y, bool reserved) {
+    grid_.setReserved(x, y, reserved);
+    ++toggled_cells_;
+    if (listener_) {
+        listener_(x, y);
+    }
+}
+
+void ObstacleInflator::stamp(int x, int y) {
+    const int width = grid_.getWidth();
+    for (const auto& offset : offsets_) {
+        int cx = x + offset.first;
+        int cy = y + offset.second;
+        if (!grid_.isValidCoordinate(cx, cy)) {
+            continue;
+        }
+        std::size_t cell = static_cast<std::size_t>(cy) * width + cx;
+        if (coverage_[cell]++ == 0) {
+            updateCell(cell);
+        }
+    }
+}
+
+void ObstacleInflator::erase(int x, int y) {
+    const int width = grid_.getWidth();
+    for (const auto& offset : offsets_) {
+        int cx = x + offset.first;
+        int cy = y + offset.second;
+        if (!grid_.isValidCoordinate(cx, cy)) {
+            continue;
+        }
+        std::size_t cell = static_cast<std::size_t>(cy) * width + cx;
+        if (coverage_[cell] == 0) {
+            continue;
+        }
+        if (--coverage_[cell] == 0) {
+            updateCell(cell);
+        }
+    }
+}
+
+void ObstacleInflator::stampPath(const std::vector<Node*>& path) {
+    for (const Node* node : path) {
+        stamp(node->x, node->y);
+    }
+}
+
+void ObstacleInflator::erasePath(const std::vector<Node*>& path) {
+    for (const Node* node : path) {
+        erase(node->x, node->y);
+    }
+}
+
+void ObstacleInflator::clear() {
+    const int width = grid_.getWidth();
+    for (std::size_t cell = 0; cell < coverage_.size(); ++cell) {
+        coverage_[cell] = 0;
+        if (owned_[cell]) {
+            owned_[cell] = 0;
+            toggleCell(static_cast<int>(cell % width), static_cast<int>(cell / width), false);
+        }
+        exempt_[cell] = 0;
+    }
+}
+
+void ObstacleInflator::setExempt(int x, int y, bool exempt) {
+    if (!grid_.isValidCoordinate(x, y)) {
+        return;
+    }
+    std::size_t cell = static_cast<std::size_t>(y) * grid_.getWidth() + x;
+    exempt_[cell] = exempt ? 1 : 0;
+    updateCell(cell);
+}
+
+bool ObstacleInflator::isExempt(int x, int y) const {
+    return grid_.isValidCoordinate(x, y) && exempt_[static_cast<std::size_t>(y) * grid_.getWidth() + x];
+}
+
+int ObstacleInflator::getCoverage(int x, int y) const {
+    if (!grid_.isValidCoordinate(x, y)) {
+        return 0;
+    }
+    return coverage_[static_cast<std::size_t>(y) * grid_.getWidth() + x];
+}
+
+bool ObstacleInflator::isOverlay(int x, int y) const {
+    return grid_.isValidCoordinate(x, y) && owned_[static_cast<std::size_t>(y) * grid_.getWidth() + x];
+}
@@ -0,0 +1,106 @@
+/**
+ * @file caves.cpp
+ * @brief Реализация сценария "Пещеры"
+ */
+
+#include "scenarios/caves.h"
+#include "config.h"
+
+#include <vector>
+#include <random>
+#include <map>
+#include <limits>
+
+namespace scenarios {
+
+void createCaves(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
+                 unsigned int seed) {
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, 99);
+    
+    // Случайное заполнение, граница карты - сплошная стена
+    std::vector<std::vector<bool>> wall(height, std::vector<bool>(width, true));
+    for (int y = 1; y < height - 1; ++y) {
+        for (int x = 1; x < width - 1; ++x) {
+            wall[y][x] = dist(rng) < config::CAVE_FILL_PERCENT;
+        }
+    }
+    
+    // Сглаживание: клетка становится стеной, если вокруг не меньше 5 стен
+    for (int step = 0; step < 5; ++step) {
+        std::vector<std::vector<bool>> next = wall;
+        for (int y = 1; y < height - 1; ++y) {
+            for (int x = 1; x < width - 1; ++x) {
+                int walls = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if ((dx != 0 || dy != 0) && wall[y + dy][x + dx]) {
+                            ++walls;
+                        }
+                    }
+                }
+                next[y][x] = walls >= 5 || (wall[y][x] && walls >= 4);
+            }
+        }
+        wall.swap(next);
+    }
+    
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (wall[y][x]) {
+                grid.setObstacle(x, y);
+            } else {
+                grid.clearObstacle(x, y);
+            }
+        }
+    }
+    
+    // Старт и финиш - ближайшие к углам клетки самой большой пещеры
+    std::map<int, int> sizes;
+    int largest = -1;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int component = grid.getComponent(x, y);
+            if (component != -1 && ++sizes[component] > (largest == -1 ? 0 : sizes[largest])) {
+                largest = component;
+            }
+        }
+    }
+    
+    if (largest == -1) {
+        start_x = 1;
+        start_y = 1;
+        end_x = width - 2;
+        end_y = height - 2;
+        grid.clearObstacle(start_x, start_y);
+        grid.clearObstacle(end_x, end_y);
+        return;
+    }
+    
+    int best_start = std::numeric_limits<int>::max();
+    int best_end = std::numeric_limits<int>::max();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (grid.getComponent(x, y) != largest) {
+                continue;
+            }
+            int to_start = x + y;
+            int to_end = (width - 1 - x) + (height - 1 - y);
+            if (to_start < best_start) {
+                best_start = to_start;
+                start_x = x;
+                start_y = y;
+            }
+            if (to_end < best_end) {
+                best_end = to_end;
+                end_x = x;
+                end_y = y;
+            }
+        }
+    }
+}
+
+} // namespace scenarios
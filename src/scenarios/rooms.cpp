@@ -0,0 +1,98 @@
+/**
+ * @file rooms.cpp
+ * @brief Реализация сценария "Комнаты"
+ */
+
+#include "scenarios/rooms.h"
+#include "config.h"
+
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+
+namespace scenarios {
+
+void createRooms(Grid& grid, int& start_x, int& start_y, int& end_x, int& end_y,
+                 int room_size, unsigned int seed) {
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    room_size = std::max(3, room_size);
+    
+    // Стены по линиям сетки комнат и по границе карты
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            bool is_wall = x % room_size == 0 || y % room_size == 0 ||
+                           x == width - 1 || y == height - 1;
+            if (is_wall) {
+                grid.setObstacle(x, y);
+            } else {
+                grid.clearObstacle(x, y);
+            }
+        }
+    }
+    
+    int rooms_x = (width - 2) / room_size + 1;
+    int rooms_y = (height - 2) / room_size + 1;
+    
+    // Стены между соседними комнатами: (комната, правый или нижний сосед)
+    struct Door {
+        int room;
+        bool horizontal;
+    };
+    std::vector<Door> doors;
+    for (int ry = 0; ry < rooms_y; ++ry) {
+        for (int rx = 0; rx < rooms_x; ++rx) {
+            if (rx + 1 < rooms_x && (rx + 1) * room_size < width - 1) {
+                doors.push_back({ry * rooms_x + rx, true});
+            }
+            if (ry + 1 < rooms_y && (ry + 1) * room_size < height - 1) {
+                doors.push_back({ry * rooms_x + rx, false});
+            }
+        }
+    }
+    
+    std::mt19937 rng(seed);
+    std::shuffle(doors.begin(), doors.end(), rng);
+    
+    std::vector<int> parent(rooms_x * rooms_y);
+    std::iota(parent.begin(), parent.end(), 0);
+    std::function<int(int)> find = [&](int room) {
+        return parent[room] == room ? room : parent[room] = find(parent[room]);
+    };
+    
+    // Двери по остовному дереву (алгоритм Краскала) и около 10% лишних
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (const Door& door : doors) {
+        int rx = door.room % rooms_x;
+        int ry = door.room / rooms_x;
+        int other = door.horizontal ? door.room + 1 : door.room + rooms_x;
+        int a = find(door.room);
+        int b = find(other);
+        if (a == b && percent(rng) >= 10) {
+            continue;
+        }
+        parent[a] = b;
+        
+        // Дверь шириной в клетку в случайном месте общей стены
+        int span_begin = (door.horizontal ? ry : rx) * room_size + 1;
+        int span_end = std::min(span_begin + room_size - 2, (door.horizontal ? height : width) - 2);
+        std::uniform_int_distribution<int> offset(span_begin, std::max(span_begin, span_end));
+        int along = offset(rng);
+        if (door.horizontal) {
+            grid.clearObstacle((rx + 1) * room_size, along);
+        } else {
+            grid.clearObstacle(along, (ry + 1) * room_size);
+        }
+    }
+    
+    start_x = 1;
+    start_y = 1;
+    end_x = width - 2;
+    end_y = height - 2;
+    grid.clearObstacle(start_x, start_y);
+    grid.clearObstacle(end_x, end_y);
+}
+
+} // namespace scenarios
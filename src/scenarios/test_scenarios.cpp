@@ -63,6 +63,22 @@ std::vector<TestScenario> createAllScenarios() {
     return scenarios;
 }
 
+std::vector<TestScenario> createLargeScenarios(int size) {
+    std::vector<TestScenario> scenarios;
+    
+    TestScenario large_maze("large_maze", size, size);
+    createComplexMaze(large_maze.grid, large_maze.start_x, large_maze.start_y,
+                     large_maze.end_x, large_maze.end_y);
+    scenarios.push_back(large_maze);
+    
+    TestScenario large_obstacles("large_obstacles", size, size);
+    createManyObstacles(large_obstacles.grid, large_obstacles.start_x, large_obstacles.start_y,
+                       large_obstacles.end_x, large_obstacles.end_y, config::OBSTACLE_DENSITY);
+    scenarios.push_back(large_obstacles);
+    
+    return scenarios;
+}
+
 void saveScenario(const TestScenario& scenario, const std::string& filename) {
     std::ofstream file(filename);
     if (!file.is_open()) {
@@ -213,14 +229,8 @@ void exportForPython(const TestScenario& scenario, const std::string& filename)
 
 
 bool isPathPossible(const Grid& grid, int start_x, int start_y, int end_x, int end_y) {
-    // Простая проверка - старт и финиш должны быть доступны
-    if (!grid.isValidCoordinate(start_x, start_y) || grid.isObstacle(start_x, start_y)) {
-        return false;
-    }
-    if (!grid.isValidCoordinate(end_x, end_y) || grid.isObstacle(end_x, end_y)) {
-        return false;
-    }
-    return true;
+    // Старт и финиш должны быть свободны и лежать в одной компоненте связности
+    return grid.isReachable(start_x, start_y, end_x, end_y);
 }
 
 std::string getScenarioName(int index) {
@@ -0,0 +1,325 @@
+/**
+ * @file bit_wavefront.cpp
+ * @brief Реализация битово-параллельной волны
+ */
+
+#include "utils/bit_wavefront.h"
+
+#include <stdexcept>
+#include <chrono>
+#include <utility>
+#include <algorithm>
+
+namespace {
+
+/// Заливка внутри слова в сторону старших битов, не выходя из маски свободных клеток
+std::uint64_t fillUp(std::uint64_t seeds, std::uint64_t free_cells) {
+    seeds |= free_cells & (seeds << 1);
+    free_cells &= free_cells << 1;
+    seeds |= free_cells & (seeds << 2);
+    free_cells &= free_cells << 2;
+    seeds |= free_cells & (seeds << 4);
+    free_cells &= free_cells << 4;
+    seeds |= free_cells & (seeds << 8);
+    free_cells &= free_cells << 8;
+    seeds |= free_cells & (seeds << 16);
+    free_cells &= free_cells << 16;
+    return seeds | (free_cells & (seeds << 32));
+}
+
+/// Заливка внутри слова в сторону младших битов, не выходя из маски свободных клеток
+std::uint64_t fillDown(std::uint64_t seeds, std::uint64_t free_cells) {
+    seeds |= free_cells & (seeds >> 1);
+    free_cells &= free_cells >> 1;
+    seeds |= free_cells & (seeds >> 2);
+    free_cells &= free_cells >> 2;
+    seeds |= free_cells & (seeds >> 4);
+    free_cells &= free_cells >> 4;
+    seeds |= free_cells & (seeds >> 8);
+    free_cells &= free_cells >> 8;
+    seeds |= free_cells & (seeds >> 16);
+    free_cells &= free_cells >> 16;
+    return seeds | (free_cells & (seeds >> 32));
+}
+
+long long countBits(const std::vector<std::uint64_t>& words) {
+    long long count = 0;
+    for (std::uint64_t word : words) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+} // namespace
+
+BitWavefront::BitWavefront(const Grid& grid, Connectivity connectivity)
+    : BitWavefront(grid.getOccupancyRow(0), grid.getWidth(), grid.getHeight(), grid.getOccupancyStride(),
+                   connectivity) {}
+
+BitWavefront::BitWavefront(const std::uint64_t* occupancy, int width, int height, int stride,
+                           Connectivity connectivity)
+    : occupancy_(occupancy), width_(width), height_(height), stride_(stride), words_((width + 63) / 64),
+      connectivity_(connectivity),
+      last_word_mask_(0), iterations_(0), last_time_(0.0) {
+    if (occupancy == nullptr || width <= 0 || height <= 0 || stride < (width + 63) / 64) {
+        throw std::invalid_argument("Invalid occupancy layout for wavefront");
+    }
+    last_word_mask_ = (width % 64 == 0) ? ~std::uint64_t{0} : (std::uint64_t{1} << (width % 64)) - 1;
+}
+
+Connectivity BitWavefront::defaultConnectivity() {
+    return (config::ALLOW_DIAGONAL_MOVEMENT && config::AGENT_RADIUS <= 0.5) ? Connectivity::Eight
+                                                                             : Connectivity::Four;
+}
+
+std::uint64_t BitWavefront::freeWord(int y, int w) const {
+    if (w >= words_) {
+        return 0;
+    }
+    std::uint64_t free_cells = ~occupancy_[static_cast<std::size_t>(y) * stride_ + w];
+    return w == words_ - 1 ? (free_cells & last_word_mask_) : free_cells;
+}
+
+std::uint64_t BitWavefront::spreadWord(const std::uint64_t* row, int w) const {
+    std::uint64_t word = row[w];
+    std::uint64_t from_left = w > 0 ? row[w - 1] >> 63 : 0;
+    std::uint64_t from_right = w + 1 < stride_ ? row[w + 1] << 63 : 0;
+    return word | (word << 1) | from_left | (word >> 1) | from_right;
+}
+
+long long BitWavefront::flood(int x, int y) {
+    return flood(std::vector<std::pair<int, int>>{{x, y}});
+}
+
+long long BitWavefront::flood(const std::vector<std::pair<int, int>>& sources) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    reached_.assign(static_cast<std::size_t>(height_) * stride_, 0);
+    distances_.clear();
+    iterations_ = 0;
+
+    std::vector<char> pending(height_, 0);
+    for (const auto& source : sources) {
+        int x = source.first;
+        int y = source.second;
+        if (x < 0 || x >= width_ || y < 0 || y >= height_ || ((freeWord(y, x >> 6) >> (x & 63)) & 1) == 0) {
+            continue;
+        }
+        reached_[static_cast<std::size_t>(y) * stride_ + (x >> 6)] |= std::uint64_t{1} << (x & 63);
+        for (int ny = std::max(0, y - 1); ny <= std::min(height_ - 1, y + 1); ++ny) {
+            pending[ny] = 1;
+        }
+    }
+
+    // Проходы вниз и вверх, пока какая-то строка ждет пересчета
+    std::vector<std::uint64_t> row(stride_);
+    for (bool active = true; active;) {
+        active = false;
+        for (int y = 0; y < height_; ++y) {
+            if (pending[y]) {
+                floodRow(y, pending, row);
+                active = true;
+            }
+        }
+        for (int y = height_ - 1; y >= 0; --y) {
+            if (pending[y]) {
+                floodRow(y, pending, row);
+                active = true;
+            }
+        }
+    }
+
+    last_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+    return countBits(reached_);
+}
+
+void BitWavefront::floodRow(int y, std::vector<char>& pending, std::vector<std::uint64_t>& row) {
+    pending[y] = 0;
+    ++iterations_;
+
+    std::uint64_t* current = &reached_[static_cast<std::size_t>(y) * stride_];
+    const std::uint64_t* above = y > 0 ? current - stride_ : nullptr;
+    const std::uint64_t* below = y + 1 < height_ ? current + stride_ : nullptr;
+    const bool eight = connectivity_ == Connectivity::Eight;
+
+    // Затравка: уже достигнутые клетки и соседи достигнутых клеток соседних строк
+    for (int w = 0; w < stride_; ++w) {
+        std::uint64_t seeds = current[w];
+        if (above != nullptr) {
+            seeds |= eight ? spreadWord(above, w) : above[w];
+        }
+        if (below != nullptr) {
+            seeds |= eight ? spreadWord(below, w) : below[w];
+        }
+        row[w] = seeds & freeWord(y, w);
+    }
+
+    // Заливка свободных отрезков в обе стороны с переносом между словами
+    std::uint64_t carry = 0;
+    for (int w = 0; w < stride_; ++w) {
+        std::uint64_t free_cells = freeWord(y, w);
+        row[w] = fillUp(row[w] | (carry & free_cells & 1), free_cells);
+        carry = row[w] >> 63;
+    }
+    carry = 0;
+    for (int w = stride_ - 1; w >= 0; --w) {
+        std::uint64_t free_cells = freeWord(y, w);
+        row[w] = fillDown(row[w] | ((carry << 63) & free_cells), free_cells);
+        carry = row[w] & 1;
+    }
+
+    // В буфере остаются только новые клетки строки
+    bool changed = false;
+    for (int w = 0; w < stride_; ++w) {
+        std::uint64_t added = row[w] & ~current[w];
+        current[w] = row[w];
+        row[w] = added;
+        changed |= added != 0;
+    }
+    if (!changed) {
+        return;
+    }
+
+    // Соседняя строка ждет пересчета, только если новые клетки дают ей затравку
+    for (int ny : {y - 1, y + 1}) {
+        if (ny < 0 || ny >= height_ || pending[ny]) {
+            continue;
+        }
+        const std::uint64_t* neighbor = &reached_[static_cast<std::size_t>(ny) * stride_];
+        for (int w = 0; w < stride_; ++w) {
+            std::uint64_t seeds = eight ? spreadWord(row.data(), w) : row[w];
+            if ((seeds & freeWord(ny, w) & ~neighbor[w]) != 0) {
+                pending[ny] = 1;
+                break;
+            }
+        }
+    }
+}
+
+int BitWavefront::computeDistances(int x, int y, int max_distance) {
+    return computeDistances(std::vector<std::pair<int, int>>{{x, y}}, max_distance);
+}
+
+int BitWavefront::computeDistances(const std::vector<std::pair<int, int>>& sources, int max_distance) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    const std::size_t word_count = static_cast<std::size_t>(height_) * stride_;
+    reached_.assign(word_count, 0);
+    distances_.assign(static_cast<std::size_t>(width_) * height_, -1);
+    iterations_ = 0;
+
+    std::vector<std::uint64_t> frontier(word_count, 0);
+    std::vector<std::uint64_t> next(word_count, 0);
+    std::vector<std::uint32_t> stamp(word_count, 0);
+    std::uint32_t tag = 0;
+    std::vector<int> words;
+    std::vector<int> next_words;
+    std::vector<int> candidates;
+
+    for (const auto& source : sources) {
+        int x = source.first;
+        int y = source.second;
+        if (x < 0 || x >= width_ || y < 0 || y >= height_ || ((freeWord(y, x >> 6) >> (x & 63)) & 1) == 0) {
+            continue;
+        }
+        int index = y * stride_ + (x >> 6);
+        if (frontier[index] == 0) {
+            words.push_back(index);
+        }
+        frontier[index] |= std::uint64_t{1} << (x & 63);
+        reached_[index] |= std::uint64_t{1} << (x & 63);
+        distances_[static_cast<std::size_t>(y) * width_ + x] = 0;
+    }
+    if (words.empty()) {
+        last_time_ = 0.0;
+        return -1;
+    }
+
+    // Слово фронта по строке y и столбцу слов w (0 вне карты)
+    auto frontierWord = [&](int y, int w) -> std::uint64_t {
+        if (y < 0 || y >= height_ || w < 0 || w >= stride_) {
+            return 0;
+        }
+        return frontier[static_cast<std::size_t>(y) * stride_ + w];
+    };
+
+    int distance = 0;
+    while (!words.empty() && (max_distance < 0 || distance < max_distance)) {
+        ++iterations_;
+
+        // Кандидаты - слова фронта и их соседи; соседнее слово строки нужно,
+        // только если крайний бит фронта может перейти в него
+        ++tag;
+        candidates.clear();
+        for (int index : words) {
+            int y = index / stride_;
+            int w = index % stride_;
+            int first_word = (frontier[index] & 1) != 0 ? std::max(0, w - 1) : w;
+            int last_word = (frontier[index] >> 63) != 0 ? std::min(stride_ - 1, w + 1) : w;
+            for (int ny = std::max(0, y - 1); ny <= std::min(height_ - 1, y + 1); ++ny) {
+                for (int nw = first_word; nw <= last_word; ++nw) {
+                    int candidate = ny * stride_ + nw;
+                    if (stamp[candidate] != tag) {
+                        stamp[candidate] = tag;
+                        candidates.push_back(candidate);
+                    }
+                }
+            }
+        }
+
+        next_words.clear();
+        for (int index : candidates) {
+            int y = index / stride_;
+            int w = index % stride_;
+            std::uint64_t neighbors;
+            if (connectivity_ == Connectivity::Eight) {
+                std::uint64_t left = frontierWord(y - 1, w - 1) | frontierWord(y, w - 1) | frontierWord(y + 1, w - 1);
+                std::uint64_t middle = frontierWord(y - 1, w) | frontierWord(y, w) | frontierWord(y + 1, w);
+                std::uint64_t right = frontierWord(y - 1, w + 1) | frontierWord(y, w + 1) | frontierWord(y + 1, w + 1);
+                neighbors = middle | (middle << 1) | (left >> 63) | (middle >> 1) | (right << 63);
+            } else {
+                std::uint64_t middle = frontierWord(y, w);
+                neighbors = frontierWord(y - 1, w) | frontierWord(y + 1, w) | (middle << 1) |
+                            (frontierWord(y, w - 1) >> 63) | (middle >> 1) | (frontierWord(y, w + 1) << 63);
+            }
+
+            std::uint64_t fresh = neighbors & freeWord(y, w) & ~reached_[index];
+            if (fresh == 0) {
+                continue;
+            }
+            next[index] = fresh;
+            reached_[index] |= fresh;
+            next_words.push_back(index);
+            for (std::uint64_t bits = fresh; bits != 0; bits &= bits - 1) {
+                int x = w * 64 + __builtin_ctzll(bits);
+                distances_[static_cast<std::size_t>(y) * width_ + x] = distance + 1;
+            }
+        }
+
+        for (int index : words) {
+            frontier[index] = 0;
+        }
+        std::swap(frontier, next);
+        std::swap(words, next_words);
+        if (!words.empty()) {
+            ++distance;
+        }
+    }
+
+    last_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+    return distance;
+}
+
+bool BitWavefront::isReached(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_ || reached_.empty()) {
+        return false;
+    }
+    return ((reached_[static_cast<std::size_t>(y) * stride_ + (x >> 6)] >> (x & 63)) & 1) != 0;
+}
+
+int BitWavefront::getDistance(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_ || distances_.empty()) {
+        return -1;
+    }
+    return distances_[static_cast<std::size_t>(y) * width_ + x];
+}
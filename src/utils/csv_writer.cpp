@@ -129,7 +129,8 @@ void CSVWriter::writeCSVHeader(std::ofstream& file) {
     file << "Timestamp,Algorithm,Scenario,Success,PathLength,OptimalityCoefficient,"
          << "PathDeviation(%),Smoothness,TotalTurnAngle,NodesExpanded,"
          << "SearchEfficiency,BranchingFactor,MinObstacleDistance,"
-         << "AvgObstacleDistance,MaxCurvature,ExecutionTime(ms)\n";
+         << "AvgObstacleDistance,MaxCurvature,ExecutionTime(ms),PeakMemory(bytes),"
+         << "LosCacheHitRate(%)\n";
 }
 
 void CSVWriter::writeCSVRow(std::ofstream& file, const AlgorithmResult& result) {
@@ -153,7 +154,9 @@ void CSVWriter::writeCSVRow(std::ofstream& file, const AlgorithmResult& result)
          << std::setprecision(4) << result.metrics.min_obstacle_distance << ","
          << std::setprecision(4) << result.metrics.avg_obstacle_distance << ","
          << std::setprecision(4) << result.metrics.max_curvature << ","
-         << std::setprecision(2) << result.metrics.execution_time << "\n";
+         << std::setprecision(2) << result.metrics.execution_time << ","
+         << result.metrics.peak_memory_bytes << ","
+         << std::setprecision(2) << result.metrics.los_cache_hit_rate << "\n";
 }
 
 std::string CSVWriter::createTimestampedFilename(const std::string& base_name) {
@@ -0,0 +1,457 @@
+/**
+ * @file dead_end_pruning.cpp
+ * @brief Реализация отсечения тупиков и болот
+ */
+
+#include "utils/dead_end_pruning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+// Запас вокруг болота, внутри которого ищутся обходы
+const int kSwampMargin = 3;
+
+const double kInfinity = std::numeric_limits<double>::infinity();
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double moveCost(int dx, int dy) {
+    return (dx != 0 && dy != 0) ? config::DIAGONAL_COST : 1.0;
+}
+
+} // namespace
+
+DeadEndPruning::DeadEndPruning(const Grid& grid)
+    : grid_(grid), build_time_(0.0), block_count_(0), swamp_count_(0), swamp_cells_(0) {}
+
+void DeadEndPruning::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    buildBlocks();
+    buildSwamps();
+
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void DeadEndPruning::buildBlocks() {
+    const int width = grid_.getWidth();
+    const int cells = width * grid_.getHeight();
+
+    std::vector<int> disc(cells, -1);
+    std::vector<int> low(cells, 0);
+    std::vector<std::vector<int>> blocks_of(cells);
+    std::vector<std::pair<int, int>> edges;
+    block_count_ = 0;
+    int timer = 0;
+
+    // Блок из ребер стека до (parent, child) включительно
+    auto popBlock = [&](int parent, int child) {
+        int block = block_count_++;
+        auto add = [&](int cell) {
+            if (blocks_of[cell].empty() || blocks_of[cell].back() != block) {
+                blocks_of[cell].push_back(block);
+            }
+        };
+        while (!edges.empty()) {
+            auto [a, b] = edges.back();
+            edges.pop_back();
+            add(a);
+            add(b);
+            if (a == parent && b == child) {
+                break;
+            }
+        }
+    };
+
+    struct Frame {
+        int cell;                       ///< Клетка
+        int parent;                     ///< Родитель в дереве обхода
+        int direction;                  ///< Следующее проверяемое направление
+    };
+    std::vector<Frame> stack;
+
+    for (int root = 0; root < cells; ++root) {
+        if (disc[root] != -1 || grid_.isObstacle(root % width, root / width)) {
+            continue;
+        }
+
+        disc[root] = low[root] = timer++;
+        stack.push_back({root, -1, 0});
+
+        while (!stack.empty()) {
+            Frame& frame = stack.back();
+            int u = frame.cell;
+
+            if (frame.direction < 8) {
+                int d = frame.direction++;
+                int x = u % width;
+                int y = u / width;
+                if (!grid_.canMove(x, y, kDirections[d][0], kDirections[d][1])) {
+                    continue;
+                }
+                int v = (y + kDirections[d][1]) * width + (x + kDirections[d][0]);
+                if (disc[v] == -1) {
+                    edges.emplace_back(u, v);
+                    disc[v] = low[v] = timer++;
+                    stack.push_back({v, u, 0});
+                } else if (v != frame.parent && disc[v] < disc[u]) {
+                    edges.emplace_back(u, v);
+                    low[u] = std::min(low[u], disc[v]);
+                }
+                continue;
+            }
+
+            int parent = frame.parent;
+            stack.pop_back();
+            if (parent != -1) {
+                low[parent] = std::min(low[parent], low[u]);
+                if (low[u] >= disc[parent]) {
+                    popBlock(parent, u);
+                }
+            }
+        }
+
+        // Клетка без соседей - отдельный блок
+        if (blocks_of[root].empty()) {
+            blocks_of[root].push_back(block_count_++);
+        }
+    }
+
+    cell_block_.assign(cells, -1);
+    cut_index_.assign(cells, -1);
+    cut_blocks_.clear();
+    for (int cell = 0; cell < cells; ++cell) {
+        if (blocks_of[cell].size() == 1) {
+            cell_block_[cell] = blocks_of[cell].front();
+        } else if (blocks_of[cell].size() > 1) {
+            cut_index_[cell] = static_cast<int>(cut_blocks_.size());
+            cut_blocks_.push_back(std::move(blocks_of[cell]));
+        }
+    }
+
+    tree_.assign(block_count_ + cut_blocks_.size(), {});
+    for (std::size_t cut = 0; cut < cut_blocks_.size(); ++cut) {
+        int node = block_count_ + static_cast<int>(cut);
+        for (int block : cut_blocks_[cut]) {
+            tree_[node].push_back(block);
+            tree_[block].push_back(node);
+        }
+    }
+}
+
+int DeadEndPruning::treeNode(int cell) const {
+    if (cut_index_[cell] != -1) {
+        return block_count_ + cut_index_[cell];
+    }
+    return cell_block_[cell];
+}
+
+bool DeadEndPruning::isSwamp(const std::vector<int>& region, int id) const {
+    const int width = grid_.getWidth();
+
+    int min_x = grid_.getWidth();
+    int min_y = grid_.getHeight();
+    int max_x = -1;
+    int max_y = -1;
+    for (int cell : region) {
+        min_x = std::min(min_x, cell % width);
+        min_y = std::min(min_y, cell / width);
+        max_x = std::max(max_x, cell % width);
+        max_y = std::max(max_y, cell / width);
+    }
+    min_x = std::max(0, min_x - kSwampMargin);
+    min_y = std::max(0, min_y - kSwampMargin);
+    max_x = std::min(grid_.getWidth() - 1, max_x + kSwampMargin);
+    max_y = std::min(grid_.getHeight() - 1, max_y + kSwampMargin);
+
+    // Локальное окно: 0 - свободно, 1 - область, 2 - препятствие или другое болото
+    const int window_width = max_x - min_x + 1;
+    const int window_cells = window_width * (max_y - min_y + 1);
+    auto local = [&](int x, int y) { return (y - min_y) * window_width + (x - min_x); };
+    auto inside = [&](int x, int y) { return x >= min_x && x <= max_x && y >= min_y && y <= max_y; };
+
+    std::vector<std::uint8_t> state(window_cells, 0);
+    for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+            int owner = swamp_[y * width + x];
+            if (grid_.isObstacle(x, y) || (owner != -1 && owner != id)) {
+                state[local(x, y)] = 2;
+            }
+        }
+    }
+    for (int cell : region) {
+        state[local(cell % width, cell / width)] = 1;
+    }
+
+    // Граница области; касание другого болота запрещено, чтобы обходы
+    // разных болот не зависели друг от друга
+    std::vector<int> boundary;
+    std::vector<std::uint8_t> is_boundary(window_cells, 0);
+    for (int cell : region) {
+        int x = cell % width;
+        int y = cell / width;
+        for (const auto& direction : kDirections) {
+            if (!grid_.canMove(x, y, direction[0], direction[1])) {
+                continue;
+            }
+            int nx = x + direction[0];
+            int ny = y + direction[1];
+            int index = local(nx, ny);
+            if (state[index] == 2) {
+                return false;
+            }
+            if (state[index] == 0 && !is_boundary[index]) {
+                is_boundary[index] = 1;
+                boundary.push_back(index);
+            }
+        }
+    }
+
+    std::vector<double> through(window_cells);
+    std::vector<double> around(window_cells);
+
+    // Поиск Дейкстры в окне: expandable - раскрывать ли клетку, enterable - допустим ли ход
+    auto sweep = [&](int source, std::vector<double>& dist, const std::function<bool(int)>& expandable,
+                     const std::function<bool(int, int)>& enterable) {
+        std::fill(dist.begin(), dist.end(), kInfinity);
+        MinQueue open_list;
+        dist[source] = 0.0;
+        open_list.push({0.0, source});
+        while (!open_list.empty()) {
+            auto [cost, index] = open_list.top();
+            open_list.pop();
+            if (cost > dist[index] || (index != source && !expandable(index))) {
+                continue;
+            }
+            int x = min_x + index % window_width;
+            int y = min_y + index / window_width;
+            for (const auto& direction : kDirections) {
+                int nx = x + direction[0];
+                int ny = y + direction[1];
+                if (!inside(nx, ny) || !grid_.canMove(x, y, direction[0], direction[1])) {
+                    continue;
+                }
+                int next = local(nx, ny);
+                if (!enterable(index, next)) {
+                    continue;
+                }
+                double tentative = cost + moveCost(direction[0], direction[1]);
+                if (tentative < dist[next]) {
+                    dist[next] = tentative;
+                    open_list.push({tentative, next});
+                }
+            }
+        }
+    };
+
+    for (int a : boundary) {
+        // Через область: из a в область, по области, выход на границу
+        sweep(a, through,
+              [&](int index) { return state[index] == 1; },
+              [&](int from, int to) {
+                  return state[to] == 1 || (state[from] == 1 && is_boundary[to]);
+              });
+        // В обход: только свободные клетки окна вне области и других болот
+        sweep(a, around,
+              [&](int index) { return state[index] == 0; },
+              [&](int, int to) { return state[to] == 0; });
+
+        for (int b : boundary) {
+            if (b != a && through[b] < kInfinity && around[b] > through[b] + 1e-9) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void DeadEndPruning::buildSwamps() {
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int cells = width * height;
+
+    swamp_.assign(cells, -1);
+    swamp_members_.clear();
+    swamp_bounds_.clear();
+    swamp_cells_ = 0;
+
+    auto bounds = [width](const std::vector<int>& region) {
+        std::array<int, 4> box = {std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), -1, -1};
+        for (int cell : region) {
+            box[0] = std::min(box[0], cell % width);
+            box[1] = std::min(box[1], cell / width);
+            box[2] = std::max(box[2], cell % width);
+            box[3] = std::max(box[3], cell / width);
+        }
+        return box;
+    };
+
+    // Новая область становится препятствием для обходов соседних болот,
+    // поэтому их условие перепроверяется
+    auto neighborsStillHold = [&](const std::vector<int>& region) {
+        std::array<int, 4> box = bounds(region);
+        for (std::size_t other = 0; other < swamp_members_.size(); ++other) {
+            const std::array<int, 4>& near = swamp_bounds_[other];
+            if (box[2] < near[0] - kSwampMargin || box[0] > near[2] + kSwampMargin ||
+                box[3] < near[1] - kSwampMargin || box[1] > near[3] + kSwampMargin) {
+                continue;
+            }
+            if (!isSwamp(swamp_members_[other], static_cast<int>(other))) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto tryRegion = [&](std::vector<int>& region, int id) {
+        for (int cell : region) {
+            swamp_[cell] = id;
+        }
+        if (isSwamp(region, id) && neighborsStillHold(region)) {
+            return true;
+        }
+        swamp_[region.back()] = -1;
+        return false;
+    };
+
+    for (int seed = 0; seed < cells; ++seed) {
+        int x = seed % width;
+        int y = seed / width;
+        if (grid_.isObstacle(x, y) || swamp_[seed] != -1) {
+            continue;
+        }
+
+        // Болота растут только от клеток у препятствий
+        bool near_obstacle = false;
+        for (const auto& direction : kDirections) {
+            if (grid_.isObstacle(x + direction[0], y + direction[1])) {
+                near_obstacle = true;
+                break;
+            }
+        }
+        if (!near_obstacle) {
+            continue;
+        }
+
+        const int id = static_cast<int>(swamp_members_.size());
+        std::vector<int> region = {seed};
+        if (!tryRegion(region, id)) {
+            continue;
+        }
+
+        while (static_cast<int>(region.size()) < config::SWAMP_MAX_SIZE) {
+            bool grown = false;
+            for (std::size_t i = 0; i < region.size() && !grown; ++i) {
+                int cx = region[i] % width;
+                int cy = region[i] / width;
+                for (const auto& direction : kDirections) {
+                    if (!grid_.canMove(cx, cy, direction[0], direction[1])) {
+                        continue;
+                    }
+                    int next = (cy + direction[1]) * width + (cx + direction[0]);
+                    if (swamp_[next] != -1) {
+                        continue;
+                    }
+                    region.push_back(next);
+                    if (tryRegion(region, id)) {
+                        grown = true;
+                        break;
+                    }
+                    region.pop_back();
+                }
+            }
+            if (!grown) {
+                break;
+            }
+        }
+
+        swamp_bounds_.push_back(bounds(region));
+        swamp_cells_ += static_cast<int>(region.size());
+        swamp_members_.push_back(std::move(region));
+    }
+
+    swamp_count_ = static_cast<int>(swamp_members_.size());
+}
+
+int DeadEndPruning::apply(Grid& target, int start_x, int start_y, int end_x, int end_y,
+                          bool prune_swamps) const {
+    target.clearPruned();
+
+    const int width = grid_.getWidth();
+    if (tree_.empty() || grid_.isObstacle(start_x, start_y) || grid_.isObstacle(end_x, end_y)) {
+        return 0;
+    }
+
+    int start = start_y * width + start_x;
+    int end = end_y * width + end_x;
+
+    // Путь в дереве блоков и шарниров между узлами старта и цели
+    int from = treeNode(start);
+    int to = treeNode(end);
+    std::vector<int> parent(tree_.size(), -1);
+    std::vector<int> queue = {from};
+    parent[from] = from;
+    for (std::size_t head = 0; head < queue.size() && parent[to] == -1; ++head) {
+        for (int next : tree_[queue[head]]) {
+            if (parent[next] == -1) {
+                parent[next] = queue[head];
+                queue.push_back(next);
+            }
+        }
+    }
+    if (parent[to] == -1) {
+        return 0;
+    }
+
+    std::vector<char> on_path(block_count_, 0);
+    for (int node = to;; node = parent[node]) {
+        if (node < block_count_) {
+            on_path[node] = 1;
+        }
+        if (node == from) {
+            break;
+        }
+    }
+
+    const int start_swamp = swamp_[start];
+    const int end_swamp = swamp_[end];
+    int pruned = 0;
+    for (int cell = 0; cell < width * grid_.getHeight(); ++cell) {
+        int x = cell % width;
+        int y = cell / width;
+        if (grid_.isObstacle(x, y)) {
+            continue;
+        }
+
+        bool usable = false;
+        if (cell_block_[cell] != -1) {
+            usable = on_path[cell_block_[cell]];
+        } else if (cut_index_[cell] != -1) {
+            for (int block : cut_blocks_[cut_index_[cell]]) {
+                usable = usable || on_path[block];
+            }
+        }
+
+        int swamp = swamp_[cell];
+        if (!usable || (prune_swamps && swamp != -1 && swamp != start_swamp && swamp != end_swamp)) {
+            target.setPruned(x, y, true);
+            ++pruned;
+        }
+    }
+    return pruned;
+}
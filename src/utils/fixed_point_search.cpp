@@ -0,0 +1,35 @@
+/**
+ * @file fixed_point_search.cpp
+ * @brief Реализация общих средств поиска в фиксированной точке
+ */
+
+#include "utils/fixed_point_search.h"
+
+#include <cstring>
+
+namespace fixed_point {
+
+std::uint64_t mapHash(const Grid& grid) {
+    std::uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](std::uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    std::uint64_t diagonal_bits = 0;
+    std::memcpy(&diagonal_bits, &config::DIAGONAL_COST, sizeof(diagonal_bits));
+    mix(config::ALLOW_DIAGONAL_MOVEMENT ? 1 : 0);
+    mix(config::AGENT_RADIUS > 0.5 ? 0 : 1);
+    mix(diagonal_bits);
+
+    mix(static_cast<std::uint64_t>(grid.getWidth()));
+    mix(static_cast<std::uint64_t>(grid.getHeight()));
+    for (int y = 0; y < grid.getHeight(); ++y) {
+        for (int x = 0; x < grid.getWidth(); ++x) {
+            mix(grid.isObstacle(x, y) ? 1 : 0);
+        }
+    }
+    return hash;
+}
+
+} // namespace fixed_point
@@ -0,0 +1,212 @@
+/**
+ * @file goal_bounding.cpp
+ * @brief Реализация отсечения соседей по прямоугольникам целей
+ */
+
+#include "utils/goal_bounding.h"
+#include "utils/fixed_point_search.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <chrono>
+#include <thread>
+#include <fstream>
+#include <string>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+// Индекс направления по смещению: kDirectionIndex[dy + 1][dx + 1]
+const int kDirectionIndex[3][3] = {
+    {7, 0, 4},
+    {3, -1, 1},
+    {6, 2, 5}
+};
+
+const char kMagic[4] = {'G', 'B', 'N', 'D'};
+const std::uint32_t kFormatVersion = 1;
+
+} // namespace
+
+GoalBounding::GoalBounding(const Grid& grid, unsigned threads)
+    : grid_(grid), threads_(threads), build_time_(0.0) {
+    if (threads_ == 0) {
+        threads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+void GoalBounding::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    if (width > std::numeric_limits<std::uint16_t>::max() || height > std::numeric_limits<std::uint16_t>::max()) {
+        throw std::runtime_error("Goal bounding supports maps up to 65535 cells per side");
+    }
+
+    std::vector<int> cells;
+    std::vector<int> index(static_cast<std::size_t>(width) * height, -1);
+    for (int cell = 0; cell < width * height; ++cell) {
+        if (!grid_.isObstacle(cell % width, cell / width)) {
+            index[cell] = static_cast<int>(cells.size());
+            cells.push_back(cell);
+        }
+    }
+
+    const int count = static_cast<int>(cells.size());
+    if (count > config::GOAL_BOUNDING_MAX_CELLS) {
+        throw std::runtime_error("Goal bounding exceeds cell limit (" + std::to_string(count) + " free cells)");
+    }
+
+    // Соседи в индексах свободных клеток: neighbors[i * 8 + d], -1 если хода нет
+    std::vector<int> neighbors(static_cast<std::size_t>(count) * 8, -1);
+    for (int i = 0; i < count; ++i) {
+        int x = cells[i] % width;
+        int y = cells[i] / width;
+        for (int d = 0; d < 8; ++d) {
+            if (grid_.canMove(x, y, kDirections[d][0], kDirections[d][1])) {
+                neighbors[i * 8 + d] = index[(y + kDirections[d][1]) * width + (x + kDirections[d][0])];
+            }
+        }
+    }
+
+    // Целочисленные стоимости: равные по длине пути сравниваются точно
+    std::uint64_t step_cost[8];
+    for (int d = 0; d < 8; ++d) {
+        step_cost[d] = fixed_point::stepCost(kDirections[d][0], kDirections[d][1]);
+    }
+
+    const Box empty = {std::numeric_limits<std::uint16_t>::max(), std::numeric_limits<std::uint16_t>::max(), 0, 0};
+    std::vector<Box> boxes(static_cast<std::size_t>(width) * height * 8, empty);
+
+    auto worker = [&](unsigned worker_index, unsigned workers) {
+        std::vector<std::uint64_t> dist(count);
+        std::vector<std::uint8_t> first(count);
+
+        for (int source = static_cast<int>(worker_index); source < count; source += static_cast<int>(workers)) {
+            std::fill(first.begin(), first.end(), 0);
+            fixed_point::firstMoveDijkstra(neighbors, step_cost, source, dist, first);
+
+            // Каждый поток пишет только прямоугольники своих исходных клеток
+            Box* row = &boxes[static_cast<std::size_t>(cells[source]) * 8];
+            for (int target = 0; target < count; ++target) {
+                if (!first[target]) {
+                    continue;
+                }
+                std::uint16_t tx = static_cast<std::uint16_t>(cells[target] % width);
+                std::uint16_t ty = static_cast<std::uint16_t>(cells[target] / width);
+                for (int d = 0; d < 8; ++d) {
+                    if (first[target] & (1u << d)) {
+                        row[d].min_x = std::min(row[d].min_x, tx);
+                        row[d].min_y = std::min(row[d].min_y, ty);
+                        row[d].max_x = std::max(row[d].max_x, tx);
+                        row[d].max_y = std::max(row[d].max_y, ty);
+                    }
+                }
+            }
+        }
+    };
+
+    const unsigned workers = std::min<unsigned>(threads_, std::max(1, count));
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < workers; ++t) {
+        pool.emplace_back(worker, t, workers);
+    }
+    worker(0, workers);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    boxes_.swap(boxes);
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+bool GoalBounding::save(const std::string& filename) const {
+    if (boxes_.empty()) {
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Формат: сигнатура, версия, размеры, хеш карты, затем прямоугольники
+    std::uint32_t width = static_cast<std::uint32_t>(grid_.getWidth());
+    std::uint32_t height = static_cast<std::uint32_t>(grid_.getHeight());
+    std::uint64_t hash = fixed_point::mapHash(grid_);
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(&kFormatVersion), sizeof(kFormatVersion));
+    file.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    file.write(reinterpret_cast<const char*>(&height), sizeof(height));
+    file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    file.write(reinterpret_cast<const char*>(boxes_.data()),
+               static_cast<std::streamsize>(boxes_.size() * sizeof(Box)));
+    return file.good();
+}
+
+bool GoalBounding::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    std::uint64_t hash = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&width), sizeof(width));
+    file.read(reinterpret_cast<char*>(&height), sizeof(height));
+    file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+
+    if (!file || !std::equal(magic, magic + 4, kMagic) || version != kFormatVersion ||
+        static_cast<int>(width) != grid_.getWidth() || static_cast<int>(height) != grid_.getHeight() ||
+        hash != fixed_point::mapHash(grid_)) {
+        return false;
+    }
+
+    std::vector<Box> boxes(static_cast<std::size_t>(width) * height * 8);
+    file.read(reinterpret_cast<char*>(boxes.data()), static_cast<std::streamsize>(boxes.size() * sizeof(Box)));
+    if (!file) {
+        return false;
+    }
+
+    boxes_.swap(boxes);
+    build_time_ = 0.0;
+    return true;
+}
+
+void GoalBounding::buildOrLoad(const std::string& filename) {
+    if (load(filename)) {
+        return;
+    }
+    build();
+    save(filename);
+}
+
+bool GoalBounding::allows(int x, int y, int dx, int dy, int target_x, int target_y) const {
+    if (boxes_.empty() || dx < -1 || dx > 1 || dy < -1 || dy > 1 || (dx == 0 && dy == 0)) {
+        return true;
+    }
+
+    const Box& box = boxes_[(static_cast<std::size_t>(y) * grid_.getWidth() + x) * 8 +
+                            kDirectionIndex[dy + 1][dx + 1]];
+    return target_x >= box.min_x && target_x <= box.max_x &&
+           target_y >= box.min_y && target_y <= box.max_y;
+}
+
+NeighborFilter GoalBounding::asFilter() const {
+    return [this](const Node& from, const Node& neighbor, const Node& target) {
+        return allows(from.x, from.y, neighbor.x - from.x, neighbor.y - from.y, target.x, target.y);
+    };
+}
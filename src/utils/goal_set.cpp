@@ -0,0 +1,74 @@
+/**
+ * @file goal_set.cpp
+ * @brief Реализация множества целей
+ */
+
+#include "utils/goal_set.h"
+#include "utils/bit_wavefront.h"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+
+// Во сколько раз путь по 8-связной сетке может быть длиннее any-angle пути
+const double kAnyAngleRatio = std::sqrt(4.0 - 2.0 * M_SQRT2);
+
+} // namespace
+
+GoalSet::GoalSet(const Grid& grid, const std::vector<std::pair<int, int>>& goals, int field_threshold)
+    : grid_(grid) {
+    const int width = grid_.getWidth();
+    for (std::size_t i = 0; i < goals.size(); ++i) {
+        int x = goals[i].first;
+        int y = goals[i].second;
+        if (grid_.isObstacle(x, y) || !index_.emplace(y * width + x, static_cast<int>(i)).second) {
+            continue;
+        }
+        goals_.push_back(goals[i]);
+        targets_.emplace_back(x, y, true);
+    }
+
+    if (static_cast<int>(goals_.size()) >= field_threshold) {
+        // Со срезанием углов и без него 8-связная волна разрешает не меньше
+        // ходов, чем canMove, поэтому шаги в ней не больше, чем в поиске
+        BitWavefront wavefront(grid_, config::ALLOW_DIAGONAL_MOVEMENT ? Connectivity::Eight : Connectivity::Four);
+        wavefront.computeDistances(goals_);
+        hops_ = wavefront.getDistances();
+    }
+}
+
+int GoalSet::find(int x, int y) const {
+    if (!grid_.isValidCoordinate(x, y)) {
+        return -1;
+    }
+    auto found = index_.find(y * grid_.getWidth() + x);
+    return found == index_.end() ? -1 : found->second;
+}
+
+double GoalSet::estimate(const Node& node) const {
+    if (!hops_.empty()) {
+        int hops = hops_[static_cast<std::size_t>(node.y) * grid_.getWidth() + node.x];
+        return hops < 0 ? std::numeric_limits<double>::infinity() : static_cast<double>(hops);
+    }
+    double best = std::numeric_limits<double>::infinity();
+    for (const Node& target : targets_) {
+        best = std::min(best, node.calculateHeuristic(target));
+    }
+    return best;
+}
+
+double GoalSet::estimateAnyAngle(const Node& node) const {
+    if (!hops_.empty()) {
+        return estimate(node) / kAnyAngleRatio;
+    }
+    // Без диагоналей calculateHeuristic - манхэттенское расстояние, и
+    // any-angle путь оно не ограничивает: берется евклидово
+    double best = std::numeric_limits<double>::infinity();
+    for (const auto& goal : goals_) {
+        best = std::min(best, std::hypot(static_cast<double>(node.x - goal.first),
+                                         static_cast<double>(node.y - goal.second)));
+    }
+    return best;
+}
@@ -0,0 +1,299 @@
+/**
+ * @file landmark_heuristic.cpp
+ * @brief Реализация эвристики ориентиров (ALT)
+ */
+
+#include "utils/landmark_heuristic.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <queue>
+#include <chrono>
+#include <thread>
+#include <functional>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+const float kUnreachableDistance = std::numeric_limits<float>::infinity();
+
+// Во сколько раз путь по 8-связной сетке может быть длиннее any-angle пути
+const double kAnyAngleRatio = std::sqrt(4.0 - 2.0 * M_SQRT2);
+
+using QueueEntry = std::pair<double, int>;
+using MinQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+double octile(int x0, int y0, int x1, int y1) {
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    if (!config::ALLOW_DIAGONAL_MOVEMENT) {
+        return dx + dy;
+    }
+    return std::max(dx, dy) + (config::DIAGONAL_COST - 1.0) * std::min(dx, dy);
+}
+
+} // namespace
+
+LandmarkHeuristic::LandmarkHeuristic(const Grid& grid, int landmarks, unsigned threads)
+    : grid_(grid), requested_(std::max(1, landmarks)), threads_(threads), built_(false),
+      build_time_(0.0), scale_(1.0), slack_(0.0) {
+    if (threads_ == 0) {
+        threads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+void LandmarkHeuristic::selectLandmarks() {
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int cells = width * height;
+
+    // Ориентиры ставятся в самую большую компоненту связности:
+    // ориентир в изолированном кармане ничего не дает остальной карте
+    std::vector<int> component(cells, -1);
+    std::vector<int> largest;
+    std::vector<int> members;
+    int label = 0;
+    for (int seed = 0; seed < cells; ++seed) {
+        if (component[seed] != -1 || grid_.isObstacle(seed % width, seed / width)) {
+            continue;
+        }
+        members.clear();
+        members.push_back(seed);
+        component[seed] = label;
+        for (std::size_t head = 0; head < members.size(); ++head) {
+            int x = members[head] % width;
+            int y = members[head] / width;
+            for (const auto& direction : kDirections) {
+                int nx = x + direction[0];
+                int ny = y + direction[1];
+                if (!config::ALLOW_DIAGONAL_MOVEMENT && direction[0] != 0 && direction[1] != 0) {
+                    continue;
+                }
+                if (!grid_.isValidCoordinate(nx, ny) || !grid_.canMove(x, y, direction[0], direction[1])) {
+                    continue;
+                }
+                int next = ny * width + nx;
+                if (component[next] == -1) {
+                    component[next] = label;
+                    members.push_back(next);
+                }
+            }
+        }
+        if (members.size() > largest.size()) {
+            largest.swap(members);
+        }
+        ++label;
+    }
+
+    if (largest.empty()) {
+        throw std::runtime_error("Landmark heuristic requires at least one walkable cell");
+    }
+
+    // Самая дальняя точка: первый ориентир - дальний от произвольной клетки,
+    // каждый следующий максимизирует расстояние до ближайшего из выбранных
+    std::vector<double> nearest(largest.size(), std::numeric_limits<double>::infinity());
+    int ax = largest.front() % width;
+    int ay = largest.front() / width;
+    for (std::size_t i = 0; i < largest.size(); ++i) {
+        nearest[i] = octile(ax, ay, largest[i] % width, largest[i] / width);
+    }
+
+    const int count = std::min<int>(requested_, static_cast<int>(largest.size()));
+    for (int k = 0; k < count; ++k) {
+        std::size_t best = static_cast<std::size_t>(
+            std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+        int lx = largest[best] % width;
+        int ly = largest[best] / width;
+        landmarks_.emplace_back(lx, ly);
+
+        if (k == 0) {
+            std::fill(nearest.begin(), nearest.end(), std::numeric_limits<double>::infinity());
+        }
+        for (std::size_t i = 0; i < largest.size(); ++i) {
+            nearest[i] = std::min(nearest[i], octile(lx, ly, largest[i] % width, largest[i] / width));
+        }
+    }
+}
+
+std::vector<float> LandmarkHeuristic::distancesFrom(int x, int y) const {
+    const int width = grid_.getWidth();
+    std::vector<double> distance(static_cast<std::size_t>(width) * grid_.getHeight(),
+                                 std::numeric_limits<double>::infinity());
+
+    MinQueue open_list;
+    distance[y * width + x] = 0.0;
+    open_list.push({0.0, y * width + x});
+
+    while (!open_list.empty()) {
+        auto [cost, cell] = open_list.top();
+        open_list.pop();
+        if (cost > distance[cell]) {
+            continue;
+        }
+
+        int cx = cell % width;
+        int cy = cell / width;
+        for (const auto& direction : kDirections) {
+            int dx = direction[0];
+            int dy = direction[1];
+            bool diagonal = dx != 0 && dy != 0;
+            if (diagonal && !config::ALLOW_DIAGONAL_MOVEMENT) {
+                continue;
+            }
+            if (!grid_.isValidCoordinate(cx + dx, cy + dy) || !grid_.canMove(cx, cy, dx, dy)) {
+                continue;
+            }
+            int next = (cy + dy) * width + cx + dx;
+            double tentative = cost + (diagonal ? config::DIAGONAL_COST : 1.0);
+            if (tentative < distance[next]) {
+                distance[next] = tentative;
+                open_list.push({tentative, next});
+            }
+        }
+    }
+
+    std::vector<float> result(distance.size(), kUnreachableDistance);
+    for (std::size_t i = 0; i < distance.size(); ++i) {
+        if (distance[i] != std::numeric_limits<double>::infinity()) {
+            result[i] = static_cast<float>(distance[i]);
+        }
+    }
+    return result;
+}
+
+void LandmarkHeuristic::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    built_ = false;
+    landmarks_.clear();
+    compact_.clear();
+    wide_.clear();
+    slack_ = 0.0;
+
+    selectLandmarks();
+
+    // Поиски от разных ориентиров независимы и выполняются параллельно
+    const int count = static_cast<int>(landmarks_.size());
+    std::vector<std::vector<float>> tables(count);
+    const unsigned workers = std::min<unsigned>(threads_, static_cast<unsigned>(count));
+    auto worker = [&](unsigned index) {
+        for (int k = static_cast<int>(index); k < count; k += static_cast<int>(workers)) {
+            tables[k] = distancesFrom(landmarks_[k].first, landmarks_[k].second);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < workers; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    double max_distance = 0.0;
+    for (const auto& table : tables) {
+        for (float value : table) {
+            if (value != kUnreachableDistance) {
+                max_distance = std::max(max_distance, static_cast<double>(value));
+            }
+        }
+    }
+
+    // Таблица хранится по клеткам: K расстояний одной клетки лежат рядом
+    const std::size_t cells = static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight();
+    if (max_distance < kUnreachable - 1) {
+        scale_ = max_distance > 0.0 ? (kUnreachable - 1) / max_distance : 1.0;
+        compact_.assign(cells * count, kUnreachable);
+        for (std::size_t cell = 0; cell < cells; ++cell) {
+            for (int k = 0; k < count; ++k) {
+                float value = tables[k][cell];
+                if (value != kUnreachableDistance) {
+                    compact_[cell * count + k] = static_cast<std::uint16_t>(std::lround(value * scale_));
+                }
+            }
+        }
+    } else {
+        // Каждое значение float округлено не более чем на половину ulp максимума
+        scale_ = 1.0;
+        slack_ = max_distance * std::numeric_limits<float>::epsilon();
+        wide_.assign(cells * count, kUnreachableDistance);
+        for (std::size_t cell = 0; cell < cells; ++cell) {
+            for (int k = 0; k < count; ++k) {
+                wide_[cell * count + k] = tables[k][cell];
+            }
+        }
+    }
+
+    built_ = true;
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+double LandmarkHeuristic::landmarkBound(int cell, int target) const {
+    const std::size_t count = landmarks_.size();
+    double best = 0.0;
+
+    if (!compact_.empty()) {
+        // Каждое значение округлено не более чем на 0.5, поэтому разность
+        // уменьшается на единицу младшего разряда, чтобы остаться допустимой
+        const std::uint16_t* from = &compact_[cell * count];
+        const std::uint16_t* to = &compact_[target * count];
+        int best_units = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            if (from[k] == kUnreachable || to[k] == kUnreachable) {
+                continue;
+            }
+            best_units = std::max(best_units, std::abs(static_cast<int>(from[k]) - static_cast<int>(to[k])));
+        }
+        return best_units > 1 ? (best_units - 1) / scale_ : 0.0;
+    }
+
+    const float* from = &wide_[cell * count];
+    const float* to = &wide_[target * count];
+    for (std::size_t k = 0; k < count; ++k) {
+        if (from[k] == kUnreachableDistance || to[k] == kUnreachableDistance) {
+            continue;
+        }
+        best = std::max(best, std::abs(static_cast<double>(from[k]) - to[k]));
+    }
+    return std::max(0.0, best - slack_);
+}
+
+double LandmarkHeuristic::estimate(int x, int y, int target_x, int target_y) const {
+    double base = octile(x, y, target_x, target_y);
+    if (!built_) {
+        return base;
+    }
+    const int width = grid_.getWidth();
+    return std::max(base, landmarkBound(y * width + x, target_y * width + target_x));
+}
+
+double LandmarkHeuristic::estimateAnyAngle(int x, int y, int target_x, int target_y) const {
+    double dx = static_cast<double>(target_x - x);
+    double dy = static_cast<double>(target_y - y);
+    double euclidean = std::sqrt(dx * dx + dy * dy);
+    if (!built_) {
+        return euclidean;
+    }
+    const int width = grid_.getWidth();
+    double bound = landmarkBound(y * width + x, target_y * width + target_x) / kAnyAngleRatio;
+    return std::max(euclidean, bound);
+}
+
+HeuristicFunction LandmarkHeuristic::asFunction(bool any_angle) const {
+    if (any_angle) {
+        return [this](const Node& from, const Node& target) {
+            return estimateAnyAngle(from.x, from.y, target.x, target.y);
+        };
+    }
+    return [this](const Node& from, const Node& target) {
+        return estimate(from.x, from.y, target.x, target.y);
+    };
+}
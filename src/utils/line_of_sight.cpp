@@ -7,91 +7,255 @@
 
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LOS_HAS_AVX2_KERNEL 1
+#endif
 
 namespace line_of_sight {
 
-bool hasLineOfSight(const Grid& grid, const Node& from, const Node& to) {
-    return isPathClear(grid, from.x, from.y, to.x, to.y);
+namespace {
+
+/// Маска битов [from, to] внутри одного слова
+inline std::uint64_t bitRange(int from, int to) {
+    std::uint64_t high = to == 63 ? ~std::uint64_t{0} : (std::uint64_t{1} << (to + 1)) - 1;
+    return high & ~((std::uint64_t{1} << from) - 1);
 }
 
-bool hasLineOfSightSupercover(const Grid& grid, const Node& from, const Node& to) {
-    auto cells = getLineCells(from.x, from.y, to.x, to.y);
-    
-    for (const auto& [x, y] : cells) {
-        if (!grid.isValidCoordinate(x, y) || grid.isObstacle(x, y)) {
+#ifdef LOS_HAS_AVX2_KERNEL
+/// Есть ли ненулевое слово среди count слов (по 4 слова за сравнение)
+__attribute__((target("avx2")))
+bool anyBitsAvx2(const std::uint64_t* words, int count) {
+    __m256i acc = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i)));
+    }
+    std::uint64_t tail = 0;
+    for (; i < count; ++i) {
+        tail |= words[i];
+    }
+    return !_mm256_testz_si256(acc, acc) || tail != 0;
+}
+
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+/// Есть ли ненулевое слово среди count слов
+bool anyBits(const std::uint64_t* words, int count) {
+#ifdef LOS_HAS_AVX2_KERNEL
+    if (count >= config::LOS_AVX2_MIN_WORDS && hasAvx2()) {
+        return anyBitsAvx2(words, count);
+    }
+#endif
+    std::uint64_t acc = 0;
+    for (int i = 0; i < count; ++i) {
+        acc |= words[i];
+    }
+    return acc != 0;
+}
+
+/// Занята ли хотя бы одна клетка строки в отрезке [x_begin, x_end]
+bool spanBlocked(const std::uint64_t* row, int x_begin, int x_end) {
+    int first = x_begin >> 6;
+    int last = x_end >> 6;
+    if (first == last) {
+        return (row[first] & bitRange(x_begin & 63, x_end & 63)) != 0;
+    }
+    if ((row[first] & bitRange(x_begin & 63, 63)) != 0 || (row[last] & bitRange(0, x_end & 63)) != 0) {
+        return true;
+    }
+    return anyBits(row + first + 1, last - first - 1);
+}
+
+/// Свободны ли length клеток подряд от (x, y) в направлении (dx, dy); переходы по свободным отрезкам
+bool runClear(const Grid& grid, int x, int y, int dx, int dy, long long length) {
+    while (length > 0) {
+        int run = grid.getFreeRun(x, y, dx, dy);
+        if (run >= length) {
+            return true;
+        }
+        if (run < Grid::kMaxFreeRun) {
             return false;
         }
+        // Насыщенная длина: продолжаем с конца известного отрезка
+        x += dx * run;
+        y += dy * run;
+        length -= run;
     }
     return true;
 }
 
+/**
+ * @brief Проверить горизонтальный, вертикальный или диагональный (45°) отрезок
+ *
+ * Без суперпокрытия концы не проверяются, а на диагонали обход при нулевой
+ * ошибке делает шаг по Y: кроме диагональных клеток проверяется "лестница"
+ * со сдвигом на одну строку. Суперпокрытие идет строго по диагонали и
+ * включает концы. Каждая часть проверяется одним запросом длины отрезка.
+ * Концы отрезка должны лежать в сетке.
+ */
+bool straightClear(const Grid& grid, int x0, int y0, int x1, int y1, bool supercover) {
+    const int steps = std::max(std::abs(x1 - x0), std::abs(y1 - y0));
+    const int x_inc = (x1 > x0) - (x1 < x0);
+    const int y_inc = (y1 > y0) - (y1 < y0);
+
+    if (supercover) {
+        return runClear(grid, x0, y0, x_inc, y_inc, steps + 1);
+    }
+    if (!runClear(grid, x0 + x_inc, y0 + y_inc, x_inc, y_inc, steps - 1)) {
+        return false;
+    }
+    return x_inc == 0 || y_inc == 0 || runClear(grid, x0, y0 + y_inc, x_inc, y_inc, steps);
+}
+
+/**
+ * @brief Проверить крутой отрезок (dy > dx > 0) по столбцам
+ *
+ * Обход isPathClear проходит каждый столбец непрерывной серией строк;
+ * столбец c покидается в первой строке j, где граница строки из rowsClear
+ * больше c, т.е. 2*dx*j > 2*dy*c - dx + dy. Серия проверяется одним
+ * запросом вертикального отрезка, поэтому проверок dx + 1, а не dy + 1.
+ * Концы отрезка не проверяются и должны лежать в сетке.
+ */
+bool columnsClear(const Grid& grid, int x0, int y0, int x1, int y1) {
+    const long long dx = std::abs(x1 - x0);
+    const long long dy = std::abs(y1 - y0);
+    const int x_inc = (x1 > x0) ? 1 : -1;
+    const int y_inc = (y1 > y0) ? 1 : -1;
+
+    long long begin = 0;
+    for (long long c = 0; c <= dx; ++c) {
+        long long end = dy;
+        if (c < dx) {
+            long long threshold = 2 * dy * c - dx + dy;
+            end = threshold < 0 ? 0 : std::min(dy, threshold / (2 * dx) + 1);
+        }
+
+        long long from = (c == 0) ? std::max(begin, 1LL) : begin;
+        long long to = (c == dx) ? std::min(end, dy - 1) : end;
+        if (from <= to && !runClear(grid, x0 + x_inc * static_cast<int>(c), y0 + y_inc * static_cast<int>(from),
+                                    0, y_inc, to - from + 1)) {
+            return false;
+        }
+        begin = end;
+    }
+    return true;
+}
+
+/**
+ * @brief Проверить строки, которые пересекает отрезок, по упакованной занятости
+ *
+ * Клетки обхода в одной строке идут подряд, поэтому строка j проверяется
+ * одной маской. При i шагах по X и j по Y ошибка обхода равна
+ * dx - dy - 2*dy*i + 2*dx*j; шаги по X в строке j идут, пока она
+ * положительна, откуда граница строки вычисляется без обхода клеток.
+ * supercover - при нулевой ошибке обход делает диагональный шаг
+ * (getLineCells), иначе шаг по Y (isPathClear).
+ * Концы отрезка должны лежать в сетке.
+ */
+bool rowsClear(const Grid& grid, int x0, int y0, int x1, int y1, bool supercover, bool skip_endpoints) {
+    const long long dx = std::abs(x1 - x0);
+    const long long dy = std::abs(y1 - y0);
+    const int x_inc = (x1 > x0) ? 1 : -1;
+    const int y_inc = (y1 > y0) ? 1 : -1;
+
+    long long begin = 0;
+    for (long long j = 0; j <= dy; ++j) {
+        long long end = dx;
+        if (j < dy) {
+            long long numerator = dx - dy + 2 * dx * j;
+            end = numerator <= 0 ? 0 : std::min(dx, (numerator + 2 * dy - 1) / (2 * dy));
+        }
+        end = std::max(end, begin);
+
+        long long from = begin;
+        long long to = end;
+        if (skip_endpoints && j == 0) {
+            from = std::max(from, 1LL);
+        }
+        if (skip_endpoints && j == dy) {
+            to = std::min(to, dx - 1);
+        }
+        if (from <= to) {
+            int a = x0 + x_inc * static_cast<int>(from);
+            int b = x0 + x_inc * static_cast<int>(to);
+            if (spanBlocked(grid.getOccupancyRow(y0 + y_inc * static_cast<int>(j)), std::min(a, b), std::max(a, b))) {
+                return false;
+            }
+        }
+
+        // Диагональный шаг суперпокрытия начинает следующую строку со следующего столбца
+        bool diagonal = supercover && dx - dy - 2 * dy * end + 2 * dx * j == 0;
+        begin = end + (diagonal ? 1 : 0);
+    }
+    return true;
+}
+
+/// Поклеточная проверка для отрезков с концами вне сетки
+bool isPathClearByCells(const Grid& grid, int x0, int y0, int x1, int y1) {
+    // Начальная и конечная точки не проверяются
+    return traverseLine(x0, y0, x1, y1, false, [&](int x, int y) {
+        return (x == x0 && y == y0) || (x == x1 && y == y1) ||
+               (grid.isValidCoordinate(x, y) && !grid.isObstacle(x, y));
+    });
+}
+
+} // namespace
+
+bool hasLineOfSight(const Grid& grid, const Node& from, const Node& to) {
+    return isPathClear(grid, from.x, from.y, to.x, to.y);
+}
+
+bool hasLineOfSightSupercover(const Grid& grid, const Node& from, const Node& to) {
+    // Концы тоже проверяются, поэтому конец вне сетки сразу закрывает видимость
+    if (!grid.isValidCoordinate(from.x, from.y) || !grid.isValidCoordinate(to.x, to.y)) {
+        return false;
+    }
+    int dx = std::abs(to.x - from.x);
+    int dy = std::abs(to.y - from.y);
+    if (dx == 0 || dy == 0 || dx == dy) {
+        return straightClear(grid, from.x, from.y, to.x, to.y, true);
+    }
+    return rowsClear(grid, from.x, from.y, to.x, to.y, true, false);
+}
+
 std::vector<std::pair<int, int>> getLineCells(int x0, int y0, int x1, int y1) {
     std::vector<std::pair<int, int>> cells;
-    
-    int dx = std::abs(x1 - x0);
-    int dy = std::abs(y1 - y0);
-    int x = x0;
-    int y = y0;
-    int n = 1 + dx + dy;
-    int x_inc = (x1 > x0) ? 1 : -1;
-    int y_inc = (y1 > y0) ? 1 : -1;
-    int error = dx - dy;
-    dx *= 2;
-    dy *= 2;
-    
-    for (; n > 0; --n) {
+    cells.reserve(1 + std::abs(x1 - x0) + std::abs(y1 - y0));
+    traverseLine(x0, y0, x1, y1, true, [&cells](int x, int y) {
         cells.emplace_back(x, y);
-        
-        if (error > 0) {
-            x += x_inc;
-            error -= dy;
-        } else if (error < 0) {
-            y += y_inc;
-            error += dx;
-        } else {
-            // Диагональное движение - добавляем обе клетки для суперпокрытия
-            x += x_inc;
-            y += y_inc;
-            error -= dy;
-            error += dx;
-            --n;
-        }
-    }
-    
+        return true;
+    });
     return cells;
 }
 
 bool isPathClear(const Grid& grid, int x0, int y0, int x1, int y1) {
-    // Используем алгоритм Брезенхема для проверки всех клеток на пути
-    int dx = std::abs(x1 - x0);
-    int dy = std::abs(y1 - y0);
-    int x = x0;
-    int y = y0;
-    int n = 1 + dx + dy;
-    int x_inc = (x1 > x0) ? 1 : -1;
-    int y_inc = (y1 > y0) ? 1 : -1;
-    int error = dx - dy;
-    dx *= 2;
-    dy *= 2;
+    // Охватывающий прямоугольник без препятствий: отрезок заведомо свободен
+    if (grid.countObstacles(x0, y0, x1, y1) == 0) {
+        return true;
+    }
     
-    for (; n > 0; --n) {
-        // Пропускаем проверку начальной и конечной точек
-        if (!(x == x0 && y == y0) && !(x == x1 && y == y1)) {
-            if (!grid.isValidCoordinate(x, y) || grid.isObstacle(x, y)) {
-                return false;
-            }
-        }
-        
-        if (error > 0) {
-            x += x_inc;
-            error -= dy;
-        } else {
-            y += y_inc;
-            error += dx;
-        }
+    if (!grid.isValidCoordinate(x0, y0) || !grid.isValidCoordinate(x1, y1)) {
+        return isPathClearByCells(grid, x0, y0, x1, y1);
     }
     
-    return true;
+    // Прямые по осям и диагонали - одним запросом длины свободного отрезка,
+    // крутые отрезки - по столбцам, пологие - масками строк
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    if (dx == 0 || dy == 0 || dx == dy) {
+        return straightClear(grid, x0, y0, x1, y1, false);
+    }
+    if (dy > dx) {
+        return columnsClear(grid, x0, y0, x1, y1);
+    }
+    return rowsClear(grid, x0, y0, x1, y1, false, true);
 }
 
 } // namespace line_of_sight
\ No newline at end of file
@@ -0,0 +1,102 @@
+/**
+ * @file line_of_sight_cache.cpp
+ * @brief Реализация кэша прямой видимости
+ */
+
+#include "utils/line_of_sight_cache.h"
+#include "utils/line_of_sight.h"
+
+#include <stdexcept>
+
+namespace {
+
+const std::uint64_t kIndexBits = 24;
+const std::uint64_t kIndexLimit = std::uint64_t{1} << kIndexBits;
+const std::uint32_t kEpochMask = 0x7FFF;
+const int kProbes = 4;
+
+} // namespace
+
+LineOfSightCache::LineOfSightCache(std::size_t slots)
+    : slot_count_(slots), hash_shift_(64), version_(0), epoch_(1), hits_(0), misses_(0) {
+    if (slots == 0 || (slots & (slots - 1)) != 0) {
+        throw std::invalid_argument("Line-of-sight cache size must be a power of two");
+    }
+    for (std::size_t size = slots; size > 1; size >>= 1) {
+        --hash_shift_;
+    }
+    slots_.reset(new std::atomic<std::uint64_t>[slots]);
+    clear();
+}
+
+void LineOfSightCache::clear() {
+    for (std::size_t i = 0; i < slot_count_; ++i) {
+        slots_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+std::uint32_t LineOfSightCache::syncEpoch(std::uint64_t version) {
+    std::uint64_t current = version_.load(std::memory_order_acquire);
+    if (current == version) {
+        return epoch_.load(std::memory_order_acquire);
+    }
+    // Эпоху меняет только поток, первым увидевший новую версию
+    if (version_.compare_exchange_strong(current, version, std::memory_order_acq_rel)) {
+        std::uint32_t next = epoch_.load(std::memory_order_relaxed) + 1;
+        if (next > kEpochMask) {
+            // Номера эпох исчерпаны: старые записи больше нельзя отличить по эпохе
+            clear();
+            next = 1;
+        }
+        epoch_.store(next, std::memory_order_release);
+        return next;
+    }
+    return epoch_.load(std::memory_order_acquire);
+}
+
+bool LineOfSightCache::isPathClear(const Grid& grid, int x0, int y0, int x1, int y1) {
+    std::uint64_t cells = static_cast<std::uint64_t>(grid.getWidth()) * grid.getHeight();
+    if (cells > kIndexLimit || !grid.isValidCoordinate(x0, y0) || !grid.isValidCoordinate(x1, y1)) {
+        return line_of_sight::isPathClear(grid, x0, y0, x1, y1);
+    }
+
+    std::uint64_t from = static_cast<std::uint64_t>(y0) * grid.getWidth() + x0;
+    std::uint64_t to = static_cast<std::uint64_t>(y1) * grid.getWidth() + x1;
+    std::uint64_t key = (from << kIndexBits) | to;
+    std::uint64_t epoch = syncEpoch(grid.getVersion());
+
+    // Поиск: ключ в старших 48 битах, эпоха и результат - в младших 16
+    std::uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+    std::size_t home = hash_shift_ < 64 ? static_cast<std::size_t>(hash >> hash_shift_) : 0;
+    std::size_t victim = home;
+    bool victim_found = false;
+    for (int probe = 0; probe < kProbes; ++probe) {
+        std::size_t index = (home + probe) & (slot_count_ - 1);
+        std::uint64_t entry = slots_[index].load(std::memory_order_relaxed);
+        bool current = ((entry >> 1) & kEpochMask) == epoch;
+        if (current && (entry >> 16) == key) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return (entry & 1) != 0;
+        }
+        if (!victim_found && (!current || (entry >> 16) == key)) {
+            victim = index;
+            victim_found = true;
+        }
+    }
+
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    bool result = line_of_sight::isPathClear(grid, x0, y0, x1, y1);
+    slots_[victim].store((key << 16) | (epoch << 1) | (result ? 1 : 0), std::memory_order_relaxed);
+    return result;
+}
+
+double LineOfSightCache::getHitRate() const {
+    std::uint64_t hits = getHits();
+    std::uint64_t total = hits + getMisses();
+    return total == 0 ? 0.0 : 100.0 * static_cast<double>(hits) / static_cast<double>(total);
+}
+
+void LineOfSightCache::resetStatistics() {
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,298 @@
+/**
+ * @file local_distance_database.cpp
+ * @brief Реализация базы локальных расстояний (LDDB)
+ */
+
+#include "utils/local_distance_database.h"
+
+#include <stdexcept>
+#include <fstream>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <queue>
+#include <functional>
+#include <algorithm>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+const char kMagic[4] = {'L', 'D', 'D', 'B'};
+const std::uint32_t kFormatVersion = 2;
+
+/**
+ * @brief Правила движения, от которых зависят таблицы
+ *
+ * Записываются в заголовок файла кэша: таблица, построенная при других
+ * настройках диагоналей или срезания углов, при загрузке отбрасывается.
+ */
+struct MovementRules {
+    std::uint8_t allow_diagonal;
+    std::uint8_t corner_cutting;
+    double diagonal_cost;
+};
+
+MovementRules currentRules() {
+    MovementRules rules{};
+    rules.allow_diagonal = config::ALLOW_DIAGONAL_MOVEMENT ? 1 : 0;
+    rules.corner_cutting = config::AGENT_RADIUS > 0.5 ? 0 : 1;
+    rules.diagonal_cost = config::DIAGONAL_COST;
+    return rules;
+}
+
+} // namespace
+
+LocalDistanceDatabase::LocalDistanceDatabase(int block_size)
+    : block_size_(block_size) {
+    if (block_size != 4 && block_size != 8) {
+        throw std::invalid_argument("LDDB supports only 4x4 and 8x8 blocks");
+    }
+
+    perimeter_index_.assign(block_size * block_size, -1);
+    for (int ly = 0; ly < block_size; ++ly) {
+        for (int lx = 0; lx < block_size; ++lx) {
+            if (lx == 0 || ly == 0 || lx == block_size - 1 || ly == block_size - 1) {
+                perimeter_index_[ly * block_size + lx] = static_cast<int>(perimeter_.size());
+                perimeter_.emplace_back(lx, ly);
+            }
+        }
+    }
+
+    if (block_size == 4) {
+        dense_.assign((std::size_t(1) << 16) * tableSize(), kUnreachable);
+        dense_ready_.assign(std::size_t(1) << 16, 0);
+    }
+}
+
+std::string LocalDistanceDatabase::cachePath(int block_size) {
+    return std::string(config::LDDB_CACHE_PREFIX) + std::to_string(block_size) + "x" +
+           std::to_string(block_size) + ".bin";
+}
+
+std::shared_ptr<LocalDistanceDatabase> LocalDistanceDatabase::shared(int block_size) {
+    static std::map<int, std::shared_ptr<LocalDistanceDatabase>> instances;
+
+    auto it = instances.find(block_size);
+    if (it != instances.end()) {
+        return it->second;
+    }
+
+    auto database = std::make_shared<LocalDistanceDatabase>(block_size);
+    std::string path = cachePath(block_size);
+    // Файл с другими правилами движения load() отвергает, и база строится заново
+    if (!database->load(path) && block_size == 4) {
+        database->buildAll();
+        database->save(path);
+    }
+
+    instances[block_size] = database;
+    return database;
+}
+
+void LocalDistanceDatabase::computeTable(std::uint64_t pattern, std::uint16_t* out) const {
+    const int cells = block_size_ * block_size_;
+    const int perimeter = getPerimeterSize();
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    auto blocked = [&](int lx, int ly) {
+        return (pattern >> (ly * block_size_ + lx)) & 1ULL;
+    };
+
+    std::vector<double> dist(cells);
+    using Entry = std::pair<double, int>;
+
+    for (int from = 0; from < perimeter; ++from) {
+        auto [sx, sy] = perimeter_[from];
+        std::uint16_t* row = out + static_cast<std::size_t>(from) * perimeter;
+        std::fill(row, row + perimeter, kUnreachable);
+
+        if (blocked(sx, sy)) {
+            continue;
+        }
+
+        std::fill(dist.begin(), dist.end(), infinity);
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        dist[sy * block_size_ + sx] = 0.0;
+        queue.push({0.0, sy * block_size_ + sx});
+
+        while (!queue.empty()) {
+            auto [d, index] = queue.top();
+            queue.pop();
+            if (d > dist[index]) {
+                continue;
+            }
+
+            int x = index % block_size_;
+            int y = index / block_size_;
+
+            for (const auto& direction : kDirections) {
+                int dx = direction[0];
+                int dy = direction[1];
+                int nx = x + dx;
+                int ny = y + dy;
+                if (nx < 0 || ny < 0 || nx >= block_size_ || ny >= block_size_ || blocked(nx, ny)) {
+                    continue;
+                }
+
+                bool diagonal = dx != 0 && dy != 0;
+                if (diagonal && !config::ALLOW_DIAGONAL_MOVEMENT) {
+                    continue;
+                }
+                // Те же правила срезания углов, что и в Grid::canMove()
+                if (diagonal && config::AGENT_RADIUS > 0.5 && (blocked(nx, y) || blocked(x, ny))) {
+                    continue;
+                }
+
+                double nd = d + (diagonal ? config::DIAGONAL_COST : 1.0);
+                if (nd < dist[ny * block_size_ + nx]) {
+                    dist[ny * block_size_ + nx] = nd;
+                    queue.push({nd, ny * block_size_ + nx});
+                }
+            }
+        }
+
+        for (int to = 0; to < perimeter; ++to) {
+            auto [tx, ty] = perimeter_[to];
+            double d = dist[ty * block_size_ + tx];
+            if (d < infinity) {
+                row[to] = static_cast<std::uint16_t>(std::lround(d * kScale));
+            }
+        }
+    }
+}
+
+void LocalDistanceDatabase::buildAll() {
+    if (block_size_ != 4) {
+        throw std::logic_error("Full LDDB build is available only for 4x4 blocks");
+    }
+
+    for (std::uint64_t pattern = 0; pattern < (1ULL << 16); ++pattern) {
+        if (!dense_ready_[pattern]) {
+            computeTable(pattern, &dense_[pattern * tableSize()]);
+            dense_ready_[pattern] = 1;
+        }
+    }
+}
+
+const std::uint16_t* LocalDistanceDatabase::distances(std::uint64_t pattern) {
+    if (block_size_ == 4) {
+        std::uint16_t* table = &dense_[pattern * tableSize()];
+        if (!dense_ready_[pattern]) {
+            computeTable(pattern, table);
+            dense_ready_[pattern] = 1;
+        }
+        return table;
+    }
+
+    auto it = sparse_.find(pattern);
+    if (it == sparse_.end()) {
+        it = sparse_.emplace(pattern, std::vector<std::uint16_t>(tableSize())).first;
+        computeTable(pattern, it->second.data());
+    }
+    return it->second.data();
+}
+
+std::size_t LocalDistanceDatabase::getPatternCount() const {
+    if (block_size_ == 4) {
+        return static_cast<std::size_t>(std::count(dense_ready_.begin(), dense_ready_.end(), 1));
+    }
+    return sparse_.size();
+}
+
+bool LocalDistanceDatabase::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Формат: сигнатура, версия, сторона блока, правила движения, число шаблонов,
+    // затем (шаблон, матрица)
+    std::uint32_t block_size = static_cast<std::uint32_t>(block_size_);
+    MovementRules rules = currentRules();
+    std::uint64_t count = getPatternCount();
+    file.write(kMagic, sizeof(kMagic));
+    file.write(reinterpret_cast<const char*>(&kFormatVersion), sizeof(kFormatVersion));
+    file.write(reinterpret_cast<const char*>(&block_size), sizeof(block_size));
+    file.write(reinterpret_cast<const char*>(&rules.allow_diagonal), sizeof(rules.allow_diagonal));
+    file.write(reinterpret_cast<const char*>(&rules.corner_cutting), sizeof(rules.corner_cutting));
+    file.write(reinterpret_cast<const char*>(&rules.diagonal_cost), sizeof(rules.diagonal_cost));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+
+    const std::streamsize table_bytes = static_cast<std::streamsize>(tableSize() * sizeof(std::uint16_t));
+
+    if (block_size_ == 4) {
+        for (std::uint64_t pattern = 0; pattern < dense_ready_.size(); ++pattern) {
+            if (dense_ready_[pattern]) {
+                file.write(reinterpret_cast<const char*>(&pattern), sizeof(pattern));
+                file.write(reinterpret_cast<const char*>(&dense_[pattern * tableSize()]), table_bytes);
+            }
+        }
+    } else {
+        for (const auto& [pattern, table] : sparse_) {
+            file.write(reinterpret_cast<const char*>(&pattern), sizeof(pattern));
+            file.write(reinterpret_cast<const char*>(table.data()), table_bytes);
+        }
+    }
+
+    return file.good();
+}
+
+bool LocalDistanceDatabase::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t block_size = 0;
+    MovementRules rules{};
+    std::uint64_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!file || !std::equal(magic, magic + 4, kMagic) || version != kFormatVersion) {
+        return false;
+    }
+    file.read(reinterpret_cast<char*>(&block_size), sizeof(block_size));
+    file.read(reinterpret_cast<char*>(&rules.allow_diagonal), sizeof(rules.allow_diagonal));
+    file.read(reinterpret_cast<char*>(&rules.corner_cutting), sizeof(rules.corner_cutting));
+    file.read(reinterpret_cast<char*>(&rules.diagonal_cost), sizeof(rules.diagonal_cost));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+    // Таблицы, посчитанные при других правилах движения, нужно строить заново
+    MovementRules expected = currentRules();
+    if (!file || static_cast<int>(block_size) != block_size_ ||
+        rules.allow_diagonal != expected.allow_diagonal ||
+        rules.corner_cutting != expected.corner_cutting ||
+        rules.diagonal_cost != expected.diagonal_cost) {
+        return false;
+    }
+
+    const std::streamsize table_bytes = static_cast<std::streamsize>(tableSize() * sizeof(std::uint16_t));
+    std::vector<std::uint16_t> table(tableSize());
+
+    for (std::uint64_t i = 0; i < count; ++i) {
+        std::uint64_t pattern = 0;
+        file.read(reinterpret_cast<char*>(&pattern), sizeof(pattern));
+        file.read(reinterpret_cast<char*>(table.data()), table_bytes);
+        if (!file) {
+            return false;
+        }
+
+        if (block_size_ == 4) {
+            if (pattern >= dense_ready_.size()) {
+                return false;
+            }
+            std::copy(table.begin(), table.end(), dense_.begin() + pattern * tableSize());
+            dense_ready_[pattern] = 1;
+        } else {
+            sparse_[pattern] = table;
+        }
+    }
+
+    return true;
+}
@@ -4,6 +4,7 @@
  */
 
 #include "utils/metrics_calculator.h"
+#include "utils/line_of_sight.h"
 
 #include <cmath>
 #include <algorithm>
@@ -92,16 +93,18 @@ std::pair<double, double> calculateObstacleDistances(const std::vector<Node*>& p
     double total_distance = 0.0;
     int count = 0;
     
-    for (Node* node : path) {
-        // Ищем ближайшее препятствие для этого узла пути
+    // Расстояние считается для каждой клетки, через которую проходит путь:
+    // у путей с произвольными углами отрезки между узлами длинные
+    auto measure = [&](int cell_x, int cell_y) {
+        // Ищем ближайшее препятствие для этой клетки пути
         double min_node_distance = std::numeric_limits<double>::max();
         
-        // Проверяем окрестность вокруг узла пути
+        // Проверяем окрестность вокруг клетки
         int search_radius = 5; // Можно настроить в config
         for (int dy = -search_radius; dy <= search_radius; ++dy) {
             for (int dx = -search_radius; dx <= search_radius; ++dx) {
-                int check_x = node->x + dx;
-                int check_y = node->y + dy;
+                int check_x = cell_x + dx;
+                int check_y = cell_y + dy;
                 
                 if (grid.isValidCoordinate(check_x, check_y) && 
                     grid.isObstacle(check_x, check_y)) {
@@ -119,6 +122,16 @@ std::pair<double, double> calculateObstacleDistances(const std::vector<Node*>& p
             total_distance += min_node_distance;
             count++;
         }
+        return true;
+    };
+    
+    measure(path[0]->x, path[0]->y);
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        // Начало отрезка уже учтено концом предыдущего
+        const Node* from = path[i - 1];
+        line_of_sight::traverseLine(from->x, from->y, path[i]->x, path[i]->y, true, [&](int x, int y) {
+            return (x == from->x && y == from->y) || measure(x, y);
+        });
     }
     
     double avg_distance = (count > 0) ? total_distance / count : 0.0;
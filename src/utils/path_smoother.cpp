@@ -0,0 +1,215 @@
+/**
+ * @file path_smoother.cpp
+ * @brief Реализация конвейера сглаживания пути
+ */
+
+#include "utils/path_smoother.h"
+#include "utils/line_of_sight.h"
+
+#include <cmath>
+#include <chrono>
+#include <queue>
+#include <limits>
+#include <algorithm>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+double distance(const Node& a, const Node& b) {
+    return std::hypot(static_cast<double>(b.x - a.x), static_cast<double>(b.y - a.y));
+}
+
+} // namespace
+
+PathSmoother::PathSmoother(const Grid& grid)
+    : grid_(grid), mode_(ShortcutMode::Exponential), string_pulling_(config::PATH_SMOOTHER_STRING_PULLING),
+      min_clearance_(config::PATH_SMOOTHER_MIN_CLEARANCE), los_cache_(nullptr), visibility_checks_(0),
+      smooth_time_(0.0), clearance_version_(0) {}
+
+void PathSmoother::resetStatistics() {
+    visibility_checks_ = 0;
+    smooth_time_ = 0.0;
+}
+
+std::vector<Node*> PathSmoother::smooth(const std::vector<Node*>& path) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    visibility_checks_ = 0;
+
+    if (path.size() < 3) {
+        smooth_time_ = 0.0;
+        return path;
+    }
+    if (min_clearance_ > 0) {
+        updateClearance();
+    }
+
+    std::vector<std::size_t> waypoints = {0};
+    while (waypoints.back() < path.size() - 1) {
+        waypoints.push_back(farthestVisible(path, waypoints.back()));
+    }
+    if (string_pulling_) {
+        pullString(path, waypoints);
+    }
+
+    std::vector<Node*> smoothed_path;
+    smoothed_path.reserve(waypoints.size());
+    for (std::size_t index : waypoints) {
+        smoothed_path.push_back(path[index]);
+    }
+
+    smooth_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+    return smoothed_path;
+}
+
+bool PathSmoother::isVisible(const Node& from, const Node& to) {
+    ++visibility_checks_;
+    bool visible = los_cache_ ? los_cache_->hasLineOfSight(grid_, from, to)
+                              : line_of_sight::hasLineOfSight(grid_, from, to);
+    if (!visible || min_clearance_ <= 0) {
+        return visible;
+    }
+
+    // Концы отрезка лежат на исходном пути, поэтому зазор проверяется только между ними
+    const int width = grid_.getWidth();
+    return line_of_sight::traverseLine(from.x, from.y, to.x, to.y, true, [&](int x, int y) {
+        return (x == from.x && y == from.y) || (x == to.x && y == to.y) ||
+               clearance_[static_cast<std::size_t>(y) * width + x] >= min_clearance_;
+    });
+}
+
+void PathSmoother::updateClearance() {
+    if (clearance_version_ == grid_.getVersion()) {
+        return;
+    }
+
+    const int width = grid_.getWidth();
+    const int height = grid_.getHeight();
+    const int unknown = std::numeric_limits<int>::max();
+
+    // Волна от всех препятствий (и границ карты) по 8-связности, как в FocalSearch
+    clearance_.assign(static_cast<std::size_t>(width) * height, unknown);
+    std::queue<int> frontier;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (grid_.isObstacle(x, y)) {
+                clearance_[y * width + x] = 0;
+                frontier.push(y * width + x);
+            } else if (x == 0 || y == 0 || x == width - 1 || y == height - 1) {
+                clearance_[y * width + x] = 1;
+                frontier.push(y * width + x);
+            }
+        }
+    }
+
+    while (!frontier.empty()) {
+        int index = frontier.front();
+        frontier.pop();
+        int x = index % width;
+        int y = index / width;
+        for (const auto& direction : kDirections) {
+            int nx = x + direction[0];
+            int ny = y + direction[1];
+            if (!grid_.isValidCoordinate(nx, ny)) {
+                continue;
+            }
+            int neighbor = ny * width + nx;
+            if (clearance_[neighbor] == unknown) {
+                clearance_[neighbor] = clearance_[index] + 1;
+                frontier.push(neighbor);
+            }
+        }
+    }
+    clearance_version_ = grid_.getVersion();
+}
+
+std::size_t PathSmoother::farthestVisible(const std::vector<Node*>& path, std::size_t anchor) {
+    const std::size_t last = path.size() - 1;
+    // Следующий узел пути - соседняя клетка, он достижим всегда
+    std::size_t visible = anchor + 1;
+
+    if (mode_ == ShortcutMode::Greedy) {
+        while (visible < last && isVisible(*path[anchor], *path[visible + 1])) {
+            ++visible;
+        }
+        return visible;
+    }
+
+    // Короткие срезы дешевле проверить подряд: удвоение на них перелетает
+    // границу и добавляет шаги двоичного поиска
+    const std::size_t linear_end = std::min(last, anchor + config::PATH_SMOOTHER_LINEAR_PROBES);
+    while (visible < linear_end && isVisible(*path[anchor], *path[visible + 1])) {
+        ++visible;
+    }
+    if (visible < linear_end || visible == last) {
+        return visible;
+    }
+
+    // Экспоненциальные шаги до первого невидимого узла (или конца пути)
+    std::size_t invisible = last + 1;
+    for (std::size_t step = 2 * (visible - anchor); anchor + step <= last; step *= 2) {
+        if (!isVisible(*path[anchor], *path[anchor + step])) {
+            invisible = anchor + step;
+            break;
+        }
+        visible = anchor + step;
+    }
+    if (invisible > last && visible < last) {
+        if (isVisible(*path[anchor], *path[last])) {
+            return last;
+        }
+        invisible = last;
+    }
+
+    // Двоичный поиск границы: visible виден, invisible нет
+    while (invisible - visible > 1) {
+        std::size_t middle = visible + (invisible - visible) / 2;
+        if (isVisible(*path[anchor], *path[middle])) {
+            visible = middle;
+        } else {
+            invisible = middle;
+        }
+    }
+    return visible;
+}
+
+void PathSmoother::pullString(const std::vector<Node*>& path, std::vector<std::size_t>& waypoints) {
+    for (int pass = 0; pass < config::PATH_SMOOTHER_PULL_PASSES; ++pass) {
+        bool changed = false;
+
+        for (std::size_t k = 1; k + 1 < waypoints.size();) {
+            const Node& previous = *path[waypoints[k - 1]];
+            const Node& next = *path[waypoints[k + 1]];
+            if (isVisible(previous, next)) {
+                waypoints.erase(waypoints.begin() + static_cast<std::ptrdiff_t>(k));
+                changed = true;
+                continue;
+            }
+
+            // Сдвиг узла по коридору между соседними опорными узлами
+            std::size_t best = waypoints[k];
+            double best_length = distance(previous, *path[best]) + distance(*path[best], next);
+            for (std::size_t candidate = waypoints[k - 1] + 1; candidate < waypoints[k + 1]; ++candidate) {
+                double length = distance(previous, *path[candidate]) + distance(*path[candidate], next);
+                if (length < best_length - 1e-9 && isVisible(previous, *path[candidate]) &&
+                    isVisible(*path[candidate], next)) {
+                    best = candidate;
+                    best_length = length;
+                }
+            }
+            if (best != waypoints[k]) {
+                waypoints[k] = best;
+                changed = true;
+            }
+            ++k;
+        }
+
+        if (!changed) {
+            break;
+        }
+    }
+}
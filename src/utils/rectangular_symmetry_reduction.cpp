@@ -0,0 +1,258 @@
+/**
+ * @file rectangular_symmetry_reduction.cpp
+ * @brief Реализация разбиения на пустые прямоугольники (RSR)
+ */
+
+#include "utils/rectangular_symmetry_reduction.h"
+
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+const int kDirections[8][2] = {
+    {0, -1}, {1, 0}, {0, 1}, {-1, 0},
+    {1, -1}, {1, 1}, {-1, 1}, {-1, -1}
+};
+
+} // namespace
+
+RectangularSymmetryReduction::RectangularSymmetryReduction(const Grid& grid)
+    : grid_(grid), build_time_(0.0), rectangle_count_(0) {}
+
+void RectangularSymmetryReduction::build() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    rectangles_.clear();
+    free_ids_.clear();
+    rectangle_count_ = 0;
+    cell_rectangle_.assign(static_cast<std::size_t>(grid_.getWidth()) * grid_.getHeight(), -1);
+    cover(0, 0, grid_.getWidth() - 1, grid_.getHeight() - 1);
+
+    build_time_ = std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start_time).count();
+}
+
+void RectangularSymmetryReduction::update(int x, int y) {
+    if (cell_rectangle_.empty()) {
+        throw std::runtime_error("Rectangle decomposition is not built");
+    }
+    if (!grid_.isValidCoordinate(x, y)) {
+        return;
+    }
+
+    // Удаляются прямоугольники клетки и ее соседей, чтобы освободившаяся
+    // клетка могла войти в новый прямоугольник, а не остаться отдельной
+    int min_x = x;
+    int min_y = y;
+    int max_x = x;
+    int max_y = y;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (!grid_.isValidCoordinate(x + dx, y + dy)) {
+                continue;
+            }
+            int id = cell_rectangle_[(y + dy) * grid_.getWidth() + (x + dx)];
+            if (id == -1) {
+                continue;
+            }
+            const Rectangle& rectangle = rectangles_[id];
+            min_x = std::min(min_x, rectangle.min_x);
+            min_y = std::min(min_y, rectangle.min_y);
+            max_x = std::max(max_x, rectangle.max_x);
+            max_y = std::max(max_y, rectangle.max_y);
+            removeRectangle(id);
+        }
+    }
+
+    cover(min_x, min_y, max_x, max_y);
+}
+
+bool RectangularSymmetryReduction::isUncovered(int x, int y) const {
+    return !grid_.isBlocked(x, y) && cell_rectangle_[y * grid_.getWidth() + x] == -1;
+}
+
+void RectangularSymmetryReduction::cover(int min_x, int min_y, int max_x, int max_y) {
+    const int width = grid_.getWidth();
+
+    for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+            if (!isUncovered(x, y)) {
+                continue;
+            }
+
+            // Два кандидата: сначала вширь, затем вниз, и наоборот; берется больший
+            int wide_x = x;
+            while (wide_x + 1 <= max_x && isUncovered(wide_x + 1, y)) {
+                ++wide_x;
+            }
+            int wide_y = y;
+            for (bool open = true; open && wide_y + 1 <= max_y;) {
+                for (int cx = x; cx <= wide_x && open; ++cx) {
+                    open = isUncovered(cx, wide_y + 1);
+                }
+                wide_y += open ? 1 : 0;
+            }
+
+            int tall_y = y;
+            while (tall_y + 1 <= max_y && isUncovered(x, tall_y + 1)) {
+                ++tall_y;
+            }
+            int tall_x = x;
+            for (bool open = true; open && tall_x + 1 <= max_x;) {
+                for (int cy = y; cy <= tall_y && open; ++cy) {
+                    open = isUncovered(tall_x + 1, cy);
+                }
+                tall_x += open ? 1 : 0;
+            }
+
+            Rectangle rectangle = {x, y, wide_x, wide_y};
+            if ((tall_x - x + 1) * (tall_y - y + 1) > (wide_x - x + 1) * (wide_y - y + 1)) {
+                rectangle = {x, y, tall_x, tall_y};
+            }
+
+            int id;
+            if (!free_ids_.empty()) {
+                id = free_ids_.back();
+                free_ids_.pop_back();
+                rectangles_[id] = rectangle;
+            } else {
+                id = static_cast<int>(rectangles_.size());
+                rectangles_.push_back(rectangle);
+            }
+            ++rectangle_count_;
+
+            for (int cy = rectangle.min_y; cy <= rectangle.max_y; ++cy) {
+                for (int cx = rectangle.min_x; cx <= rectangle.max_x; ++cx) {
+                    cell_rectangle_[cy * width + cx] = id;
+                }
+            }
+        }
+    }
+}
+
+void RectangularSymmetryReduction::removeRectangle(int id) {
+    const Rectangle& rectangle = rectangles_[id];
+    for (int y = rectangle.min_y; y <= rectangle.max_y; ++y) {
+        for (int x = rectangle.min_x; x <= rectangle.max_x; ++x) {
+            cell_rectangle_[y * grid_.getWidth() + x] = -1;
+        }
+    }
+    free_ids_.push_back(id);
+    --rectangle_count_;
+}
+
+bool RectangularSymmetryReduction::isInterior(int x, int y) const {
+    if (cell_rectangle_.empty() || !grid_.isValidCoordinate(x, y)) {
+        return false;
+    }
+    int id = cell_rectangle_[y * grid_.getWidth() + x];
+    if (id == -1) {
+        return false;
+    }
+    const Rectangle& rectangle = rectangles_[id];
+    return hasInterior(rectangle) && x > rectangle.min_x && x < rectangle.max_x && y > rectangle.min_y &&
+           y < rectangle.max_y;
+}
+
+int RectangularSymmetryReduction::getInteriorCellCount() const {
+    int count = 0;
+    for (int y = 0; y < grid_.getHeight(); ++y) {
+        for (int x = 0; x < grid_.getWidth(); ++x) {
+            count += isInterior(x, y) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+double RectangularSymmetryReduction::octileCost(int x0, int y0, int x1, int y1) {
+    int dx = std::abs(x1 - x0);
+    int dy = std::abs(y1 - y0);
+    if (!config::ALLOW_DIAGONAL_MOVEMENT) {
+        return dx + dy;
+    }
+    return std::max(dx, dy) + (config::DIAGONAL_COST - 1.0) * std::min(dx, dy);
+}
+
+void RectangularSymmetryReduction::getSuccessors(const Node& from, const Node& target,
+                                                 std::vector<Successor>& successors) const {
+    const int width = grid_.getWidth();
+    int id = cell_rectangle_.empty() ? -1 : cell_rectangle_[from.y * width + from.x];
+    bool reduced = id != -1 && hasInterior(rectangles_[id]);
+
+    auto addMacro = [&](int x, int y) {
+        if (x != from.x || y != from.y) {
+            successors.push_back({x, y, octileCost(from.x, from.y, x, y)});
+        }
+    };
+
+    // Внутрь попадает только старт: из него сразу выходим на весь периметр
+    if (reduced && isInterior(from.x, from.y)) {
+        const Rectangle& rectangle = rectangles_[id];
+        for (int x = rectangle.min_x; x <= rectangle.max_x; ++x) {
+            addMacro(x, rectangle.min_y);
+            addMacro(x, rectangle.max_y);
+        }
+        for (int y = rectangle.min_y + 1; y < rectangle.max_y; ++y) {
+            addMacro(rectangle.min_x, y);
+            addMacro(rectangle.max_x, y);
+        }
+        if (cell_rectangle_[target.y * width + target.x] == id) {
+            addMacro(target.x, target.y);
+        }
+        return;
+    }
+
+    // Обычные соседи, кроме внутренних клеток (цель разрешена всегда)
+    for (const auto& direction : kDirections) {
+        int nx = from.x + direction[0];
+        int ny = from.y + direction[1];
+        if (!grid_.canMove(from.x, from.y, direction[0], direction[1])) {
+            continue;
+        }
+        if (isInterior(nx, ny) && (nx != target.x || ny != target.y)) {
+            continue;
+        }
+        bool diagonal = direction[0] != 0 && direction[1] != 0;
+        successors.push_back({nx, ny, diagonal ? config::DIAGONAL_COST : 1.0});
+    }
+
+    if (!reduced) {
+        return;
+    }
+
+    // Макроребра через прямоугольник ко всем клеткам периметра на других сторонах;
+    // клетки своей стороны достижимы вдоль нее по прямой за ту же стоимость
+    const Rectangle& rectangle = rectangles_[id];
+    bool on_top = from.y == rectangle.min_y;
+    bool on_bottom = from.y == rectangle.max_y;
+    bool on_left = from.x == rectangle.min_x;
+    bool on_right = from.x == rectangle.max_x;
+    auto addAcross = [&](int x, int y) {
+        if ((on_top && y == rectangle.min_y) || (on_bottom && y == rectangle.max_y) ||
+            (on_left && x == rectangle.min_x) || (on_right && x == rectangle.max_x)) {
+            return;
+        }
+        addMacro(x, y);
+    };
+    for (int x = rectangle.min_x; x <= rectangle.max_x; ++x) {
+        addAcross(x, rectangle.min_y);
+        addAcross(x, rectangle.max_y);
+    }
+    for (int y = rectangle.min_y + 1; y < rectangle.max_y; ++y) {
+        addAcross(rectangle.min_x, y);
+        addAcross(rectangle.max_x, y);
+    }
+
+    if (isInterior(target.x, target.y) && cell_rectangle_[target.y * width + target.x] == id) {
+        addMacro(target.x, target.y);
+    }
+}
+
+SuccessorFunction RectangularSymmetryReduction::asSuccessorFunction() const {
+    return [this](const Node& from, const Node& target, std::vector<Successor>& successors) {
+        getSuccessors(from, target, successors);
+    };
+}
@@ -0,0 +1,262 @@
+/**
+ * @file test_algorithms.cpp
+ * @brief Проверки алгоритмов поиска пути на стандартных сценариях
+ */
+
+#include "scenarios/test_scenarios.h"
+#include "algorithms/astar.h"
+#include "algorithms/focal_search.h"
+#include "algorithms/subgoal_graph.h"
+#include "algorithms/sma_star.h"
+#include "algorithms/compressed_path_database.h"
+#include "utils/landmark_heuristic.h"
+#include "utils/dead_end_pruning.h"
+
+#include <iostream>
+#include <random>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+/// Сообщить о несовпадении длин путей
+void expectSameLength(const std::string& what, double expected, double actual) {
+    if (std::abs(expected - actual) > 1e-6) {
+        std::cerr << "FAILED: " << what << ": expected " << expected << ", got " << actual << std::endl;
+        ++failures;
+    }
+}
+
+/**
+ * @brief Эвристика ALT допустима, поэтому A* с ней находит пути той же длины, что и обычный A*
+ * @param scenario Сценарий
+ */
+void testAltMatchesAStar(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    Grid grid_alt = grid;
+
+    AStar astar(grid);
+    AStar astar_alt(grid_alt);
+    LandmarkHeuristic landmarks(grid_alt);
+    landmarks.build();
+    astar_alt.setHeuristic(landmarks.asFunction());
+
+    astar.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+    astar_alt.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+    expectSameLength("AStarALT on " + scenario.name, astar.getPathLength(), astar_alt.getPathLength());
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    int checked = 0;
+    for (int attempt = 0; attempt < 100000 && checked < 100; ++attempt) {
+        int x0 = random_x(rng);
+        int y0 = random_y(rng);
+        int x1 = random_x(rng);
+        int y1 = random_y(rng);
+        if (grid.isBlocked(x0, y0) || grid.isBlocked(x1, y1) || !grid.isReachable(x0, y0, x1, y1)) {
+            continue;
+        }
+        astar.findPath(x0, y0, x1, y1);
+        astar_alt.findPath(x0, y0, x1, y1);
+        expectSameLength("AStarALT on " + scenario.name + " (" + std::to_string(x0) + "," + std::to_string(y0) +
+                             ")->(" + std::to_string(x1) + "," + std::to_string(y1) + ")",
+                         astar.getPathLength(), astar_alt.getPathLength());
+        ++checked;
+    }
+}
+
+/**
+ * @brief Фокальный поиск не длиннее (1 + ε) оптимума и сообщает границу не больше 1 + ε
+ * @param scenario Сценарий
+ */
+void testFocalBound(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+
+    AStar astar(grid);
+    FocalSearch focal(grid);
+    const double factor = 1.0 + config::FOCAL_EPSILON;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> random_x(0, grid.getWidth() - 1);
+    std::uniform_int_distribution<int> random_y(0, grid.getHeight() - 1);
+    int checked = 0;
+    for (int attempt = 0; attempt < 100000 && checked < 100; ++attempt) {
+        int x0 = random_x(rng);
+        int y0 = random_y(rng);
+        int x1 = random_x(rng);
+        int y1 = random_y(rng);
+        if (grid.isBlocked(x0, y0) || grid.isBlocked(x1, y1) || !grid.isReachable(x0, y0, x1, y1)) {
+            continue;
+        }
+        astar.findPath(x0, y0, x1, y1);
+        focal.findPath(x0, y0, x1, y1);
+        if (focal.getPathLength() > factor * astar.getPathLength() + 1e-6 ||
+            focal.getSuboptimalityBound() > factor + 1e-9) {
+            std::cerr << "FAILED: FocalSearch on " << scenario.name << ": length " << focal.getPathLength()
+                      << ", optimum " << astar.getPathLength() << ", bound " << focal.getSuboptimalityBound()
+                      << std::endl;
+            ++failures;
+        }
+        ++checked;
+    }
+}
+
+/**
+ * @brief Отсечение тупиков и болот не удлиняет путь A* для запроса, под который оно применено
+ * @param scenario Сценарий
+ */
+void testDeadEndPruningKeepsLength(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    Grid grid_pruned = grid;
+
+    DeadEndPruning pruning(grid);
+    pruning.build();
+    pruning.apply(grid_pruned, scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+
+    AStar astar(grid);
+    AStar astar_pruned(grid_pruned);
+    astar.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+    astar_pruned.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+    expectSameLength("AStarDE on " + scenario.name, astar.getPathLength(), astar_pruned.getPathLength());
+}
+
+/**
+ * @brief Граф подцелей загружается только для карты, для которой сохранен
+ * @param scenario Сценарий
+ */
+void testSubgoalGraphRejectsOtherMap(const TestScenario& scenario) {
+    const std::string filename = "subgoal_graph_test.bin";
+    Grid grid = scenario.grid;
+    SubgoalGraph graph(grid);
+    graph.build();
+    if (!graph.save(filename)) {
+        std::cerr << "FAILED: SubgoalGraph::save on " << scenario.name << std::endl;
+        ++failures;
+        return;
+    }
+
+    // Новое препятствие в клетке среди свободных: подцелью (углом препятствия) она не является,
+    // и проверка проходимости подцелей такую карту не отличит
+    Grid changed = scenario.grid;
+    auto open_around = [&changed](int x, int y) {
+        for (int dy = -1; dy <= 1; ++dy) {
+            for (int dx = -1; dx <= 1; ++dx) {
+                if (changed.isObstacle(x + dx, y + dy)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    for (int y = 0; y < changed.getHeight(); ++y) {
+        for (int x = 0; x < changed.getWidth(); ++x) {
+            if (open_around(x, y)) {
+                changed.setObstacle(x, y);
+                y = changed.getHeight();
+                break;
+            }
+        }
+    }
+
+    SubgoalGraph same(grid);
+    SubgoalGraph other(changed);
+    if (!same.load(filename)) {
+        std::cerr << "FAILED: SubgoalGraph::load rejected the map it was saved for" << std::endl;
+        ++failures;
+    }
+    if (other.load(filename)) {
+        std::cerr << "FAILED: SubgoalGraph::load accepted a different map" << std::endl;
+        ++failures;
+    }
+    std::remove(filename.c_str());
+}
+
+/**
+ * @brief SMA* сообщает об отсутствии пути, а не о нехватке памяти, если цель отрезана резервом
+ * @param scenario Сценарий
+ */
+void testSmaStarReportsCutOffGoal(const TestScenario& scenario) {
+    Grid grid = scenario.grid;
+    grid.inflateObstacles(config::AGENT_RADIUS);
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            int x = scenario.end_x + dx;
+            int y = scenario.end_y + dy;
+            if ((dx != 0 || dy != 0) && grid.isValidCoordinate(x, y) && !grid.isObstacle(x, y)) {
+                grid.setReserved(x, y, true);
+            }
+        }
+    }
+
+    SMAStar sma(grid);
+    std::string error = "no error";
+    try {
+        sma.findPath(scenario.start_x, scenario.start_y, scenario.end_x, scenario.end_y);
+    } catch (const std::runtime_error& e) {
+        error = e.what();
+    }
+    if (error != "Path not found") {
+        std::cerr << "FAILED: SMA* on " << scenario.name << " with the goal cut off: " << error << std::endl;
+        ++failures;
+    }
+}
+
+/**
+ * @brief База первых ходов после изменения карты дает путь той же длины, что и A*
+ */
+void testPathDatabaseFollowsMapChanges() {
+    // Небольшая карта со стеной: построение базы - поиск от каждой клетки
+    Grid grid(40, 40);
+    for (int y = 5; y < 35; ++y) {
+        grid.setObstacle(20, y);
+    }
+    CompressedPathDatabase database(grid);
+    database.build();
+    AStar astar(grid);
+
+    // Препятствие в середине пути перекрывает ход, сохраненный в таблицах
+    std::vector<Node*> path = astar.findPath(2, 20, 37, 20);
+    const Node* middle = path[path.size() / 2];
+    grid.setObstacle(middle->x, middle->y);
+
+    astar.findPath(2, 20, 37, 20);
+    database.findPath(2, 20, 37, 20);
+    expectSameLength("CompressedPathDatabase after a map change", astar.getPathLength(), database.getPathLength());
+}
+
+} // namespace
+
+int main() {
+    for (const auto& scenario : scenarios::createAllScenarios()) {
+        if (scenario.name == "obstacles") {
+            testAltMatchesAStar(scenario);
+            testSubgoalGraphRejectsOtherMap(scenario);
+            testSmaStarReportsCutOffGoal(scenario);
+        }
+        if (scenario.name == "obstacles" || scenario.name == "maze") {
+            testFocalBound(scenario);
+        }
+    }
+
+    TestScenario caves("caves", config::GRID_WIDTH, config::GRID_HEIGHT);
+    scenarios::createCaves(caves.grid, caves.start_x, caves.start_y, caves.end_x, caves.end_y);
+    testDeadEndPruningKeepsLength(caves);
+
+    TestScenario rooms("rooms", config::GRID_WIDTH, config::GRID_HEIGHT);
+    scenarios::createRooms(rooms.grid, rooms.start_x, rooms.start_y, rooms.end_x, rooms.end_y, config::ROOM_SIZE);
+    testDeadEndPruningKeepsLength(rooms);
+
+    testPathDatabaseFollowsMapChanges();
+    if (failures != 0) {
+        std::cerr << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}